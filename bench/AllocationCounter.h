@@ -0,0 +1,25 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+// 全局 operator new 计数（实现见 allocation_counter.cc），用于统计一段代码的堆分配次数与字节数
+struct AllocationStats {
+    int64_t count = 0;
+    int64_t bytes = 0;
+};
+
+AllocationStats GetAllocationStats();
+
+// 作用域内的分配增量
+class AllocationScope {
+public:
+    AllocationScope() : start_(GetAllocationStats()) {}
+
+    AllocationStats Delta() const {
+        auto now = GetAllocationStats();
+        return AllocationStats{now.count - start_.count, now.bytes - start_.bytes};
+    }
+
+private:
+    AllocationStats start_;
+};
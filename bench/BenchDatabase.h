@@ -0,0 +1,92 @@
+#pragma once
+#include "DatabaseORM.h"
+#include "UserRepositoryImpl.h"
+#include "EventRepositoryImpl.h"
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <vector>
+
+// 数据库位置：临时目录下的文件，或 :memory:
+enum class BenchStorage { File = 0, Memory = 1 };
+
+// 基准测试用的数据库：构造时清理旧文件并写入一个用户和一个事件，析构时删除
+class BenchDatabase {
+public:
+    explicit BenchDatabase(const std::string& name,
+                           DatabaseOptions options = DatabaseOptions::Balanced(),
+                           BenchStorage storage = BenchStorage::File)
+        : path_(storage == BenchStorage::Memory
+                    ? std::string(":memory:")
+                    : (std::filesystem::temp_directory_path() / ("bill_bench_" + name + ".db")).string()) {
+        RemoveFiles();
+        db_ = std::make_shared<DatabaseORM>(path_, options);
+
+        UserRepositoryImpl user_repo(db_);
+        owner_id_ = user_repo.save(model::User("13800000001", "BenchUser", "bench"));
+
+        EventRepositoryImpl event_repo(db_);
+        model::Event event;
+        event.name = "餐饮";
+        event_id_ = event_repo.save(event);
+    }
+
+    ~BenchDatabase() {
+        db_.reset();
+        RemoveFiles();
+    }
+
+    BenchDatabase(const BenchDatabase&) = delete;
+    BenchDatabase& operator=(const BenchDatabase&) = delete;
+
+    std::shared_ptr<DatabaseORM> GetDatabase() const { return db_; }
+    const std::string& GetPath() const { return path_; }
+
+    // 提前关闭连接（文件仍保留到析构），供需要重新打开数据库的测试使用
+    void Close() { db_.reset(); }
+
+    // 统计该连接上执行的 SQL 语句条数，用于验证查询次数
+    void TraceStatements() {
+        auto con = db_->GetStorage().get_connection();
+        sqlite3_trace_v2(con.get(), SQLITE_TRACE_STMT, &BenchDatabase::OnTrace, this);
+    }
+    int64_t GetStatementCount() const { return statement_count_; }
+    void ResetStatementCount() { statement_count_ = 0; }
+    int GetOwnerId() const { return owner_id_; }
+    int GetEventId() const { return event_id_; }
+
+    // 生成 n 条尚未入库的账单，时间按秒递增
+    std::vector<model::Bill> MakeBills(int n, model::Timestamp start = 1700000000) const {
+        std::vector<model::Bill> bills(n);
+        for (int i = 0; i < n; ++i) {
+            bills[i].owner_id = owner_id_;
+            bills[i].event_id = event_id_;
+            bills[i].amount = model::Money(100 + (i % 1000) * 10);
+            bills[i].description = "Bill_" + std::to_string(i);
+            bills[i].created_at = start + i;
+        }
+        return bills;
+    }
+
+private:
+    static int OnTrace(unsigned, void* ctx, void*, void*) {
+        ++static_cast<BenchDatabase*>(ctx)->statement_count_;
+        return 0;
+    }
+
+    void RemoveFiles() {
+        if (path_ == ":memory:") {
+            return;
+        }
+        for (const char* suffix : {"", "-wal", "-shm", "-journal"}) {
+            std::filesystem::remove(path_ + suffix);
+        }
+    }
+
+    std::string path_;
+    std::shared_ptr<DatabaseORM> db_;
+    int owner_id_ = 0;
+    int event_id_ = 0;
+    int64_t statement_count_ = 0;
+};
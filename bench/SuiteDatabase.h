@@ -0,0 +1,96 @@
+#pragma once
+#include "BenchDatabase.h"
+#include "AnnotationRepositoryImpl.h"
+#include "BillRepositoryImpl.h"
+#include "EventRepositoryImpl.h"
+#include "UserRepositoryImpl.h"
+#include <benchmark/benchmark.h>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+// 方法覆盖套件的参数：数据规模 × 存储位置
+inline void SuiteArgs(benchmark::internal::Benchmark* b) {
+    b->ArgNames({"rows", "memory"});
+    for (int rows : {1000, 100000}) {
+        for (int memory : {0, 1}) {
+            b->Args({rows, memory});
+        }
+    }
+    b->Unit(benchmark::kMicrosecond);
+}
+
+// 按 state 的参数构建并填充数据库：rows 张账单、rows / 10 个用户、8 个事件，每 10 张账单一条批注。
+// 账单 created_at 从 kStart 起按秒递增，范围查询固定取 kWindow 秒，结果行数不随规模变化
+class SuiteDatabase {
+public:
+    static constexpr model::Timestamp kStart = 1700000000;
+    static constexpr model::Timestamp kWindow = 1000;
+
+    explicit SuiteDatabase(const benchmark::State& state, const std::string& name)
+        : rows_(static_cast<int>(state.range(0))),
+          bench_(name, DatabaseOptions::Balanced(),
+                 state.range(1) == 0 ? BenchStorage::File : BenchStorage::Memory),
+          users(bench_.GetDatabase()), bills(bench_.GetDatabase()),
+          events(bench_.GetDatabase()), annotations(bench_.GetDatabase()) {
+        auto& storage = bench_.GetDatabase()->GetStorage();
+        {
+            auto guard = storage.transaction_guard();
+            char phone[16];
+            for (int i = 0; i < rows_ / 10; ++i) {
+                std::snprintf(phone, sizeof(phone), "139%08d", i);
+                user_ids.push_back(users.save(model::User(phone, "suite", "suite")));
+                phones.push_back(phone);
+            }
+            guard.commit();
+        }
+
+        event_ids.push_back(bench_.GetEventId());
+        for (int i = 1; i < 8; ++i) {
+            model::Event e;
+            e.name = "event_" + std::to_string(i);
+            event_ids.push_back(events.save(e));
+        }
+
+        auto batch = bench_.MakeBills(rows_, kStart);
+        for (size_t i = 0; i < batch.size(); ++i) {
+            batch[i].event_id = event_ids[i % event_ids.size()];
+        }
+        bill_ids = bills.saveBatch(batch);
+
+        {
+            auto guard = storage.transaction_guard();
+            for (size_t i = 0; i < bill_ids.size(); i += 10) {
+                model::Annotation a;
+                a.bill_id = bill_ids[i];
+                a.authorid = bench_.GetOwnerId();
+                a.content = "note " + std::to_string(i);
+                annotation_ids.push_back(storage.insert(a));
+            }
+            guard.commit();
+        }
+    }
+
+    int Rows() const { return rows_; }
+    int OwnerId() const { return bench_.GetOwnerId(); }
+    BenchDatabase& Bench() { return bench_; }
+
+    // 第 i 次迭代使用的账单 id，循环取
+    int BillId(size_t i) const { return bill_ids[i % bill_ids.size()]; }
+
+private:
+    int rows_;
+    BenchDatabase bench_;
+
+public:
+    UserRepositoryImpl users;
+    BillRepositoryImpl bills;
+    EventRepositoryImpl events;
+    AnnotationRepositoryImpl annotations;
+
+    std::vector<int> user_ids;
+    std::vector<std::string> phones;
+    std::vector<int> event_ids;
+    std::vector<int> bill_ids;
+    std::vector<int> annotation_ids;
+};
@@ -0,0 +1,78 @@
+#include "AllocationCounter.h"
+#include "BenchDatabase.h"
+#include "BillRepositoryImpl.h"
+#include "QueryArena.h"
+#include <benchmark/benchmark.h>
+
+namespace {
+
+// 描述超过 SSO 长度，每行都会产生一次字符串堆分配
+void SeedLongDescriptions(BenchDatabase& bench, BillRepositoryImpl& bill_repo, int rows) {
+    auto bills = bench.MakeBills(rows);
+    for (auto& b : bills) {
+        b.description += " - monthly statistics page sample text";
+    }
+    bill_repo.saveBatch(bills);
+}
+
+void ArenaArgs(benchmark::internal::Benchmark* b) {
+    b->ArgNames({"rows"});
+    for (int rows : {1000, 10000, 100000}) {
+        b->Arg(rows);
+    }
+    b->Unit(benchmark::kMillisecond);
+}
+
+void ReportAllocations(benchmark::State& state, const AllocationStats& total) {
+    state.counters["allocs_per_query"] = benchmark::Counter(
+        static_cast<double>(total.count), benchmark::Counter::kAvgIterations);
+    state.counters["heap_bytes_per_query"] = benchmark::Counter(
+        static_cast<double>(total.bytes), benchmark::Counter::kAvgIterations);
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+}
+
+// 统计页查询：std::vector<BillRow>，每行的字符串单独分配、单独释放
+static void BM_StatsQueryHeap(benchmark::State& state) {
+    BenchDatabase bench("arena_heap");
+    BillRepositoryImpl bill_repo(bench.GetDatabase());
+    SeedLongDescriptions(bench, bill_repo, static_cast<int>(state.range(0)));
+
+    AllocationStats total;
+    for (auto _ : state) {
+        AllocationScope scope;
+        {
+            auto rows = bill_repo.queryByTimeInOrder(0, INT64_MAX);
+            benchmark::DoNotOptimize(rows.data());
+        }
+        auto d = scope.Delta();
+        total.count += d.count;
+        total.bytes += d.bytes;
+    }
+    ReportAllocations(state, total);
+}
+BENCHMARK(BM_StatsQueryHeap)->Apply(ArenaArgs);
+
+// 同一查询的 pmr 重载：结果全部落在复用的 QueryArena 里，请求结束时一次 Reset
+static void BM_StatsQueryArena(benchmark::State& state) {
+    BenchDatabase bench("arena_pmr");
+    BillRepositoryImpl bill_repo(bench.GetDatabase());
+    SeedLongDescriptions(bench, bill_repo, static_cast<int>(state.range(0)));
+    QueryArena arena(64 << 20);
+
+    AllocationStats total;
+    for (auto _ : state) {
+        AllocationScope scope;
+        {
+            auto rows = bill_repo.queryByTimeInOrder(0, INT64_MAX, arena.Resource());
+            benchmark::DoNotOptimize(rows.data());
+        }
+        arena.Reset();
+        auto d = scope.Delta();
+        total.count += d.count;
+        total.bytes += d.bytes;
+    }
+    ReportAllocations(state, total);
+}
+BENCHMARK(BM_StatsQueryArena)->Apply(ArenaArgs);
@@ -0,0 +1,69 @@
+#include "BenchDatabase.h"
+#include "BillColumnStore.h"
+#include "BillRepositoryImpl.h"
+#include <benchmark/benchmark.h>
+#include <random>
+
+namespace {
+
+// 按时间升序生成的列式数据，owner/event 均匀分布
+BillColumnStore MakeColumnStore(int64_t rows) {
+    BillColumnStore store;
+    store.Reserve(static_cast<size_t>(rows));
+    std::mt19937_64 rng(42);
+    for (int64_t i = 0; i < rows; ++i) {
+        store.Append(1700000000 + i, static_cast<int32_t>(rng() % 1000),
+                     static_cast<int32_t>(rng() % 32), static_cast<int64_t>(rng() % 100000));
+    }
+    return store;
+}
+
+void ColumnArgs(benchmark::internal::Benchmark* b) {
+    b->ArgNames({"rows"});
+    for (int64_t rows : {1000000LL, 10000000LL, 50000000LL}) {
+        b->Arg(rows);
+    }
+    b->Unit(benchmark::kMillisecond);
+}
+
+}
+
+// 整个范围求和，带 event 谓词
+static void BM_ColumnStoreSum(benchmark::State& state) {
+    auto store = MakeColumnStore(state.range(0));
+    BillColumnStore::Filter filter;
+    filter.event_id = 7;
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(store.Sum(filter));
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+    state.SetLabel(BillColumnStore::HasAvx2() ? "avx2" : "scalar");
+}
+BENCHMARK(BM_ColumnStoreSum)->Apply(ColumnArgs);
+
+static void BM_ColumnStoreSumScalar(benchmark::State& state) {
+    auto store = MakeColumnStore(state.range(0));
+    BillColumnStore::Filter filter;
+    filter.event_id = 7;
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(store.SumScalar(filter));
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_ColumnStoreSumScalar)->Apply(ColumnArgs);
+
+// 对照组：同样数据量走 SQLite 覆盖索引聚合
+static void BM_SqliteTotalsByEvent(benchmark::State& state) {
+    const int rows = static_cast<int>(state.range(0));
+    BenchDatabase bench("column_sqlite");
+    BillRepositoryImpl bill_repo(bench.GetDatabase());
+    bill_repo.saveBatch(bench.MakeBills(rows));
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(bill_repo.totalsByEvent(0, INT64_MAX));
+    }
+    state.SetItemsProcessed(state.iterations() * rows);
+}
+BENCHMARK(BM_SqliteTotalsByEvent)->Arg(1000000)->Unit(benchmark::kMillisecond)->Iterations(3);
@@ -0,0 +1,92 @@
+#include "BenchDatabase.h"
+#include "AsyncBillWriter.h"
+#include "BillRepositoryImpl.h"
+#include <benchmark/benchmark.h>
+
+namespace {
+
+DatabaseOptions PresetFromArg(int64_t preset) {
+    return preset == 0 ? DatabaseOptions::Balanced() : DatabaseOptions::Durable();
+}
+
+// 参数：行数，预设（0 = balanced, 1 = durable）
+void IngestArgs(benchmark::internal::Benchmark* b) {
+    b->ArgNames({"rows", "durable"});
+    for (int rows : {10000, 100000, 1000000}) {
+        b->Args({rows, 0});
+    }
+    // durable 下逐行提交每次都 fsync，只跑最小规模
+    b->Args({10000, 1});
+    b->Unit(benchmark::kMillisecond)->Iterations(1);
+}
+
+}
+
+// 现有写法：每行一次 save，一行一个隐式事务
+static void BM_BillSaveLoop(benchmark::State& state) {
+    const int rows = static_cast<int>(state.range(0));
+    for (auto _ : state) {
+        state.PauseTiming();
+        auto bench = std::make_unique<BenchDatabase>("save_loop", PresetFromArg(state.range(1)));
+        BillRepositoryImpl repo(bench->GetDatabase());
+        auto bills = bench->MakeBills(rows);
+        state.ResumeTiming();
+
+        for (const auto& b : bills) {
+            repo.save(b);
+        }
+
+        state.PauseTiming();
+        bench.reset();
+        state.ResumeTiming();
+    }
+    state.SetItemsProcessed(state.iterations() * rows);
+}
+BENCHMARK(BM_BillSaveLoop)->Apply(IngestArgs);
+
+// saveBatch：单事务 + 复用预编译语句
+static void BM_BillSaveBatch(benchmark::State& state) {
+    const int rows = static_cast<int>(state.range(0));
+    for (auto _ : state) {
+        state.PauseTiming();
+        auto bench = std::make_unique<BenchDatabase>("save_batch", PresetFromArg(state.range(1)));
+        BillRepositoryImpl repo(bench->GetDatabase());
+        auto bills = bench->MakeBills(rows);
+        state.ResumeTiming();
+
+        benchmark::DoNotOptimize(repo.saveBatch(bills));
+
+        state.PauseTiming();
+        bench.reset();
+        state.ResumeTiming();
+    }
+    state.SetItemsProcessed(state.iterations() * rows);
+}
+BENCHMARK(BM_BillSaveBatch)->Apply(IngestArgs);
+
+// AsyncBillWriter：调用方逐条 saveAsync，写线程按 max_batch_rows / max_delay 分组提交
+static void BM_BillAsyncWriter(benchmark::State& state) {
+    const int rows = static_cast<int>(state.range(0));
+    int64_t commits = 0;
+    for (auto _ : state) {
+        state.PauseTiming();
+        auto bench = std::make_unique<BenchDatabase>("async_writer", PresetFromArg(state.range(1)));
+        auto bills = bench->MakeBills(rows);
+        auto writer = std::make_unique<AsyncBillWriter>(std::make_shared<BillRepositoryImpl>(bench->GetDatabase()));
+        state.ResumeTiming();
+
+        for (const auto& b : bills) {
+            writer->saveAsync(b, nullptr);
+        }
+        writer->flush();
+
+        state.PauseTiming();
+        commits += writer->stats().commits;
+        writer.reset();
+        bench.reset();
+        state.ResumeTiming();
+    }
+    state.SetItemsProcessed(state.iterations() * rows);
+    state.counters["commits"] = static_cast<double>(commits) / static_cast<double>(state.iterations());
+}
+BENCHMARK(BM_BillAsyncWriter)->Apply(IngestArgs);
@@ -0,0 +1,71 @@
+#include "BenchDatabase.h"
+#include "BillRepositoryImpl.h"
+#include "EventRepositoryImpl.h"
+#include "UserRepositoryImpl.h"
+#include <benchmark/benchmark.h>
+
+namespace {
+
+void LookupArgs(benchmark::internal::Benchmark* b) {
+    b->ArgNames({"rows"});
+    for (int rows : {10, 1000}) {
+        b->Arg(rows);
+    }
+    b->Unit(benchmark::kMicrosecond);
+}
+
+}
+
+// 旧做法：先解析手机号得到 user id，再按 owner_id 查账单
+static void BM_QueryByPhone_TwoStep(benchmark::State& state) {
+    BenchDatabase bench("phone_two_step");
+    BillRepositoryImpl bill_repo(bench.GetDatabase());
+    UserRepositoryImpl user_repo(bench.GetDatabase());
+    bill_repo.saveBatch(bench.MakeBills(static_cast<int>(state.range(0))));
+
+    for (auto _ : state) {
+        auto user = user_repo.queryByPhone("13800000001");
+        auto bills = bill_repo.queryByTime(user->id, 0, INT64_MAX);
+        benchmark::DoNotOptimize(bills);
+    }
+}
+BENCHMARK(BM_QueryByPhone_TwoStep)->Apply(LookupArgs);
+
+static void BM_QueryByPhone_Joined(benchmark::State& state) {
+    BenchDatabase bench("phone_joined");
+    BillRepositoryImpl bill_repo(bench.GetDatabase());
+    bill_repo.saveBatch(bench.MakeBills(static_cast<int>(state.range(0))));
+
+    for (auto _ : state) {
+        auto bills = bill_repo.queryByPhone("13800000001");
+        benchmark::DoNotOptimize(bills);
+    }
+}
+BENCHMARK(BM_QueryByPhone_Joined)->Apply(LookupArgs);
+
+// 旧做法：先按名称取事件，再按 event_id 查账单
+static void BM_QueryByEventName_TwoStep(benchmark::State& state) {
+    BenchDatabase bench("event_two_step");
+    BillRepositoryImpl bill_repo(bench.GetDatabase());
+    EventRepositoryImpl event_repo(bench.GetDatabase());
+    bill_repo.saveBatch(bench.MakeBills(static_cast<int>(state.range(0))));
+
+    for (auto _ : state) {
+        auto event = event_repo.findByName("餐饮");
+        auto bills = bill_repo.queryByEvent(bench.GetOwnerId(), event->id);
+        benchmark::DoNotOptimize(bills);
+    }
+}
+BENCHMARK(BM_QueryByEventName_TwoStep)->Apply(LookupArgs);
+
+static void BM_QueryByEventName_Joined(benchmark::State& state) {
+    BenchDatabase bench("event_joined");
+    BillRepositoryImpl bill_repo(bench.GetDatabase());
+    bill_repo.saveBatch(bench.MakeBills(static_cast<int>(state.range(0))));
+
+    for (auto _ : state) {
+        auto bills = bill_repo.queryByEvent("餐饮");
+        benchmark::DoNotOptimize(bills);
+    }
+}
+BENCHMARK(BM_QueryByEventName_Joined)->Apply(LookupArgs);
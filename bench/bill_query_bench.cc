@@ -0,0 +1,106 @@
+#include "BenchDatabase.h"
+#include "BillRepositoryImpl.h"
+#include "EventRepositoryImpl.h"
+#include <benchmark/benchmark.h>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace {
+
+void ListArgs(benchmark::internal::Benchmark* b) {
+    b->ArgNames({"rows"});
+    for (int rows : {100, 1000, 10000}) {
+        b->Arg(rows);
+    }
+    b->Unit(benchmark::kMicrosecond);
+}
+
+}
+
+// 列表只返回 event_id；逐行查事件名（N+1）
+static void BM_BillListThenEventLookup(benchmark::State& state) {
+    const int rows = static_cast<int>(state.range(0));
+    BenchDatabase bench("list_n_plus_one");
+    BillRepositoryImpl bill_repo(bench.GetDatabase());
+    EventRepositoryImpl event_repo(bench.GetDatabase());
+    bill_repo.saveBatch(bench.MakeBills(rows));
+    bench.TraceStatements();
+
+    for (auto _ : state) {
+        auto bills = bill_repo.queryByTime(bench.GetOwnerId(), 0, INT64_MAX);
+        std::vector<std::string> names;
+        names.reserve(bills.size());
+        for (const auto& b : bills) {
+            auto e = event_repo.findById(b.event_id);
+            names.push_back(e.has_value() ? e->name : std::string());
+        }
+        benchmark::DoNotOptimize(names);
+    }
+    state.counters["queries"] = benchmark::Counter(
+        static_cast<double>(bench.GetStatementCount()), benchmark::Counter::kAvgIterations);
+    state.SetItemsProcessed(state.iterations() * rows);
+}
+BENCHMARK(BM_BillListThenEventLookup)->Apply(ListArgs);
+
+// 列表只返回 event_id；每个不同的事件只查一次
+static void BM_BillListDistinctEventLookup(benchmark::State& state) {
+    const int rows = static_cast<int>(state.range(0));
+    BenchDatabase bench("list_distinct_events");
+    BillRepositoryImpl bill_repo(bench.GetDatabase());
+    EventRepositoryImpl event_repo(bench.GetDatabase());
+    bill_repo.saveBatch(bench.MakeBills(rows));
+    bench.TraceStatements();
+
+    for (auto _ : state) {
+        auto bills = bill_repo.queryByTime(bench.GetOwnerId(), 0, INT64_MAX);
+        std::unordered_map<int, std::string> names;
+        for (const auto& b : bills) {
+            if (names.count(b.event_id) == 0) {
+                auto e = event_repo.findById(b.event_id);
+                names.emplace(b.event_id, e.has_value() ? e->name : std::string());
+            }
+        }
+        benchmark::DoNotOptimize(names);
+    }
+    state.counters["queries"] = benchmark::Counter(
+        static_cast<double>(bench.GetStatementCount()), benchmark::Counter::kAvgIterations);
+    state.SetItemsProcessed(state.iterations() * rows);
+}
+BENCHMARK(BM_BillListDistinctEventLookup)->Apply(ListArgs);
+
+// 统计汇总：先物化整个 vector 再求和
+static void BM_StatsSumMaterialized(benchmark::State& state) {
+    const int rows = static_cast<int>(state.range(0));
+    BenchDatabase bench("stats_materialized");
+    BillRepositoryImpl bill_repo(bench.GetDatabase());
+    bill_repo.saveBatch(bench.MakeBills(rows));
+
+    for (auto _ : state) {
+        model::Money total;
+        for (const auto& b : bill_repo.queryByTimeInOrder(0, INT64_MAX)) {
+            total += b.amount;
+        }
+        benchmark::DoNotOptimize(total);
+    }
+    state.SetItemsProcessed(state.iterations() * rows);
+}
+BENCHMARK(BM_StatsSumMaterialized)->Apply(ListArgs)->Arg(100000);
+
+// 统计汇总：逐行遍历，不保留结果集
+static void BM_StatsSumStreaming(benchmark::State& state) {
+    const int rows = static_cast<int>(state.range(0));
+    BenchDatabase bench("stats_streaming");
+    BillRepositoryImpl bill_repo(bench.GetDatabase());
+    bill_repo.saveBatch(bench.MakeBills(rows));
+
+    for (auto _ : state) {
+        model::Money total;
+        bill_repo.forEachByTimeInOrder(0, INT64_MAX, [&](const model::BillRow& b) {
+            total += b.amount;
+        });
+        benchmark::DoNotOptimize(total);
+    }
+    state.SetItemsProcessed(state.iterations() * rows);
+}
+BENCHMARK(BM_StatsSumStreaming)->Apply(ListArgs)->Arg(100000);
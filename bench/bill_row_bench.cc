@@ -0,0 +1,91 @@
+#include "AllocationCounter.h"
+#include "BenchDatabase.h"
+#include "BillRepositoryImpl.h"
+#include <benchmark/benchmark.h>
+#include <vector>
+
+namespace {
+
+constexpr int kRows = 1000000;
+
+// 每行的堆分配次数、堆字节数与元素本身大小
+template<class T>
+void ReportPerRow(benchmark::State& state, const AllocationStats& total, int64_t rows) {
+    double n = static_cast<double>(rows) * static_cast<double>(state.iterations());
+    state.counters["allocs_per_row"] = static_cast<double>(total.count) / n;
+    state.counters["heap_bytes_per_row"] = static_cast<double>(total.bytes) / n;
+    state.counters["sizeof"] = static_cast<double>(sizeof(T));
+    state.SetItemsProcessed(state.iterations() * rows);
+}
+
+}
+
+// 纯内存构造：model::Bill 带 Event/Annotation 子对象，每个对象都调用一次 Now()
+static void BM_ConstructBills(benchmark::State& state) {
+    AllocationStats total;
+    for (auto _ : state) {
+        AllocationScope scope;
+        std::vector<model::Bill> bills(kRows);
+        benchmark::DoNotOptimize(bills.data());
+        auto d = scope.Delta();
+        total.count += d.count;
+        total.bytes += d.bytes;
+    }
+    ReportPerRow<model::Bill>(state, total, kRows);
+}
+BENCHMARK(BM_ConstructBills)->Unit(benchmark::kMillisecond);
+
+static void BM_ConstructBillRows(benchmark::State& state) {
+    AllocationStats total;
+    for (auto _ : state) {
+        AllocationScope scope;
+        std::vector<model::BillRow> rows(kRows);
+        benchmark::DoNotOptimize(rows.data());
+        auto d = scope.Delta();
+        total.count += d.count;
+        total.bytes += d.bytes;
+    }
+    ReportPerRow<model::BillRow>(state, total, kRows);
+}
+BENCHMARK(BM_ConstructBillRows)->Unit(benchmark::kMillisecond);
+
+// 从数据库读取 1M 行：整行映射为 model::Bill
+static void BM_ListFullBills(benchmark::State& state) {
+    BenchDatabase bench("list_full_bills");
+    BillRepositoryImpl bill_repo(bench.GetDatabase());
+    bill_repo.saveBatch(bench.MakeBills(kRows));
+    auto& storage = bench.GetDatabase()->GetStorage();
+
+    AllocationStats total;
+    for (auto _ : state) {
+        AllocationScope scope;
+        auto bills = storage.get_all<model::Bill>(
+            orm::where(orm::c(&model::Bill::created_at) >= 0),
+            orm::order_by(&model::Bill::created_at));
+        benchmark::DoNotOptimize(bills.data());
+        auto d = scope.Delta();
+        total.count += d.count;
+        total.bytes += d.bytes;
+    }
+    ReportPerRow<model::Bill>(state, total, kRows);
+}
+BENCHMARK(BM_ListFullBills)->Unit(benchmark::kMillisecond)->Iterations(3);
+
+// 从数据库读取 1M 行：列表查询的 BillRow 投影
+static void BM_ListBillRows(benchmark::State& state) {
+    BenchDatabase bench("list_bill_rows");
+    BillRepositoryImpl bill_repo(bench.GetDatabase());
+    bill_repo.saveBatch(bench.MakeBills(kRows));
+
+    AllocationStats total;
+    for (auto _ : state) {
+        AllocationScope scope;
+        auto rows = bill_repo.queryByTimeInOrder(0, INT64_MAX);
+        benchmark::DoNotOptimize(rows.data());
+        auto d = scope.Delta();
+        total.count += d.count;
+        total.bytes += d.bytes;
+    }
+    ReportPerRow<model::BillRow>(state, total, kRows);
+}
+BENCHMARK(BM_ListBillRows)->Unit(benchmark::kMillisecond)->Iterations(3);
@@ -0,0 +1,96 @@
+#include "BenchDatabase.h"
+#include "BillRepositoryImpl.h"
+#include "SearchRepositoryImpl.h"
+#include "SearchService.h"
+#include <benchmark/benchmark.h>
+
+namespace {
+
+void SearchArgs(benchmark::internal::Benchmark* b) {
+    b->ArgNames({"rows"});
+    for (int rows : {100000, 1000000}) {
+        b->Arg(rows);
+    }
+    b->Unit(benchmark::kMicrosecond);
+}
+
+// 描述由词表随机拼成，"taxi" 约占 1%
+void SeedBills(BenchDatabase& bench, BillRepositoryImpl& repo, int n) {
+    const char* const words[] = {"lunch", "coffee", "groceries", "rent", "bus", "metro",
+                                 "movie", "books", "gift", "dinner", "snacks", "fuel"};
+    auto bills = bench.MakeBills(n);
+    uint64_t state = 7;
+    for (auto& b : bills) {
+        state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+        b.description = (state >> 33) % 100 == 0 ? "taxi" : words[(state >> 40) % 12];
+        b.description += " ";
+        b.description += words[(state >> 50) % 12];
+    }
+    repo.saveBatch(bills);
+}
+
+}
+
+// 旧做法：把用户的账单全部读出，在 C++ 里做子串过滤
+static void BM_Search_LoadAndFilter(benchmark::State& state) {
+    BenchDatabase bench("search_filter");
+    BillRepositoryImpl repo(bench.GetDatabase());
+    SeedBills(bench, repo, static_cast<int>(state.range(0)));
+
+    for (auto _ : state) {
+        auto rows = repo.queryByTime(bench.GetOwnerId(), 0, INT64_MAX);
+        std::vector<model::BillRow> hits;
+        for (auto& r : rows) {
+            if (r.description.find("taxi") != std::string::npos) {
+                hits.push_back(std::move(r));
+                if (hits.size() == 20) {
+                    break;
+                }
+            }
+        }
+        benchmark::DoNotOptimize(hits);
+    }
+}
+BENCHMARK(BM_Search_LoadAndFilter)->Apply(SearchArgs);
+
+// FTS5 + bm25，取第一页 20 条
+static void BM_Search_Fts(benchmark::State& state) {
+    BenchDatabase bench("search_fts");
+    BillRepositoryImpl repo(bench.GetDatabase());
+    SeedBills(bench, repo, static_cast<int>(state.range(0)));
+    SearchService service(std::make_shared<SearchRepositoryImpl>(bench.GetDatabase()));
+
+    for (auto _ : state) {
+        auto page = service.Search(bench.GetOwnerId(), "taxi", 20);
+        benchmark::DoNotOptimize(page);
+    }
+}
+BENCHMARK(BM_Search_Fts)->Apply(SearchArgs);
+
+// 词中间的子串（trigram 索引）
+static void BM_Search_FtsSubstring(benchmark::State& state) {
+    BenchDatabase bench("search_fts_substring");
+    BillRepositoryImpl repo(bench.GetDatabase());
+    SeedBills(bench, repo, static_cast<int>(state.range(0)));
+    SearchService service(std::make_shared<SearchRepositoryImpl>(bench.GetDatabase()));
+
+    for (auto _ : state) {
+        auto page = service.Search(bench.GetOwnerId(), "axi", 20);
+        benchmark::DoNotOptimize(page);
+    }
+}
+BENCHMARK(BM_Search_FtsSubstring)->Apply(SearchArgs);
+
+// 不足 3 个字符的词没有 trigram 可查，按 LIKE 逐行过滤 bill_search
+static void BM_Search_ShortTermScan(benchmark::State& state) {
+    BenchDatabase bench("search_short_term");
+    BillRepositoryImpl repo(bench.GetDatabase());
+    SeedBills(bench, repo, static_cast<int>(state.range(0)));
+    SearchService service(std::make_shared<SearchRepositoryImpl>(bench.GetDatabase()));
+
+    for (auto _ : state) {
+        auto page = service.Search(bench.GetOwnerId(), "xi", 20);
+        benchmark::DoNotOptimize(page);
+    }
+}
+BENCHMARK(BM_Search_ShortTermScan)->Apply(SearchArgs);
@@ -0,0 +1,18 @@
+#include "Metrics.h"
+#include <benchmark/benchmark.h>
+
+// 一次 METRICS_SCOPE 的固定开销（两次读刻度 + 本线程计数槽写入），目标 < 50ns
+static void BM_MetricsScopedTimer(benchmark::State& state) {
+    for (auto _ : state) {
+        METRICS_SCOPE(timer, "bench.metrics.scoped_timer");
+        timer.Rows(1);
+    }
+}
+BENCHMARK(BM_MetricsScopedTimer)->ThreadRange(1, 8);
+
+static void BM_MetricsSnapshot(benchmark::State& state) {
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(metrics::Registry::Instance().Snapshot());
+    }
+}
+BENCHMARK(BM_MetricsSnapshot)->Unit(benchmark::kMicrosecond);
@@ -0,0 +1,438 @@
+#include "SuiteDatabase.h"
+#include "QueryArena.h"
+
+// IBillRepository / IUserRepository / IEventRepository / IAnnotationRepository 每个方法一项，
+// 参数见 SuiteArgs。比较改动前后请用 bench_json / bench_compare 目标。
+
+namespace {
+
+constexpr model::Timestamp kFrom = SuiteDatabase::kStart;
+constexpr model::Timestamp kTo = SuiteDatabase::kStart + SuiteDatabase::kWindow - 1;
+
+}
+
+// ==================== IBillRepository ====================
+
+static void BM_Bill_SaveInsert(benchmark::State& state) {
+    SuiteDatabase db(state, "suite_bill_insert");
+    auto bill = db.Bench().MakeBills(1, SuiteDatabase::kStart)[0];
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(db.bills.save(bill));
+    }
+}
+BENCHMARK(BM_Bill_SaveInsert)->Apply(SuiteArgs);
+
+static void BM_Bill_SaveUpdate(benchmark::State& state) {
+    SuiteDatabase db(state, "suite_bill_update");
+    size_t i = 0;
+    for (auto _ : state) {
+        state.PauseTiming();
+        auto bill = *db.bills.findById(db.BillId(i++));
+        bill.amount = model::Money(bill.amount.cents + 1);
+        state.ResumeTiming();
+        benchmark::DoNotOptimize(db.bills.save(bill));
+    }
+}
+BENCHMARK(BM_Bill_SaveUpdate)->Apply(SuiteArgs);
+
+static void BM_Bill_SaveAsyncDefault(benchmark::State& state) {
+    SuiteDatabase db(state, "suite_bill_save_async");
+    auto bill = db.Bench().MakeBills(1, SuiteDatabase::kStart)[0];
+    for (auto _ : state) {
+        db.bills.saveAsync(bill, [](const repo::SaveResult& r) { benchmark::DoNotOptimize(r.id); });
+    }
+}
+BENCHMARK(BM_Bill_SaveAsyncDefault)->Apply(SuiteArgs);
+
+static void BM_Bill_SaveBatch100(benchmark::State& state) {
+    SuiteDatabase db(state, "suite_bill_batch");
+    auto batch = db.Bench().MakeBills(100, SuiteDatabase::kStart);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(db.bills.saveBatch(batch));
+    }
+    state.SetItemsProcessed(state.iterations() * 100);
+}
+BENCHMARK(BM_Bill_SaveBatch100)->Apply(SuiteArgs);
+
+static void BM_Bill_FindById(benchmark::State& state) {
+    SuiteDatabase db(state, "suite_bill_find");
+    size_t i = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(db.bills.findById(db.BillId(i++ * 7919)));
+    }
+}
+BENCHMARK(BM_Bill_FindById)->Apply(SuiteArgs);
+
+static void BM_Bill_QueryByOwnerEvent(benchmark::State& state) {
+    SuiteDatabase db(state, "suite_bill_owner_event");
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(db.bills.queryByEvent(db.OwnerId(), db.event_ids[1]));
+    }
+}
+BENCHMARK(BM_Bill_QueryByOwnerEvent)->Apply(SuiteArgs);
+
+static void BM_Bill_QueryByEventName(benchmark::State& state) {
+    SuiteDatabase db(state, "suite_bill_event_name");
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(db.bills.queryByEvent(std::string("event_1")));
+    }
+}
+BENCHMARK(BM_Bill_QueryByEventName)->Apply(SuiteArgs);
+
+static void BM_Bill_QueryByOwnerTime(benchmark::State& state) {
+    SuiteDatabase db(state, "suite_bill_owner_time");
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(db.bills.queryByTime(db.OwnerId(), kFrom, kTo));
+    }
+}
+BENCHMARK(BM_Bill_QueryByOwnerTime)->Apply(SuiteArgs);
+
+static void BM_Bill_QueryByTime(benchmark::State& state) {
+    SuiteDatabase db(state, "suite_bill_time");
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(db.bills.queryByTime(kFrom, kTo));
+    }
+}
+BENCHMARK(BM_Bill_QueryByTime)->Apply(SuiteArgs);
+
+static void BM_Bill_QueryByTimePage(benchmark::State& state) {
+    SuiteDatabase db(state, "suite_bill_page");
+    std::optional<model::BillCursor> after;
+    for (auto _ : state) {
+        auto page = db.bills.queryByTimePage(0, INT64_MAX, after, 100);
+        after = page.next;
+        benchmark::DoNotOptimize(page);
+    }
+}
+BENCHMARK(BM_Bill_QueryByTimePage)->Apply(SuiteArgs);
+
+static void BM_Bill_QueryByPhone(benchmark::State& state) {
+    SuiteDatabase db(state, "suite_bill_phone");
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(db.bills.queryByPhone("13800000001"));
+    }
+}
+BENCHMARK(BM_Bill_QueryByPhone)->Apply(SuiteArgs);
+
+static void BM_Bill_QueryByTimeInOrder(benchmark::State& state) {
+    SuiteDatabase db(state, "suite_bill_time_order");
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(db.bills.queryByTimeInOrder(kFrom, kTo));
+    }
+}
+BENCHMARK(BM_Bill_QueryByTimeInOrder)->Apply(SuiteArgs);
+
+static void BM_Bill_QueryByTimeAndEventInOrder(benchmark::State& state) {
+    SuiteDatabase db(state, "suite_bill_time_event_order");
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(db.bills.queryByTimeAndEventInOrder(kFrom, kTo));
+    }
+}
+BENCHMARK(BM_Bill_QueryByTimeAndEventInOrder)->Apply(SuiteArgs);
+
+static void BM_Bill_PmrQueryByOwnerTime(benchmark::State& state) {
+    SuiteDatabase db(state, "suite_bill_pmr_owner_time");
+    QueryArena arena;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(db.bills.queryByTime(db.OwnerId(), kFrom, kTo, arena.Resource()));
+        arena.Reset();
+    }
+}
+BENCHMARK(BM_Bill_PmrQueryByOwnerTime)->Apply(SuiteArgs);
+
+static void BM_Bill_PmrQueryByTime(benchmark::State& state) {
+    SuiteDatabase db(state, "suite_bill_pmr_time");
+    QueryArena arena;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(db.bills.queryByTime(kFrom, kTo, arena.Resource()));
+        arena.Reset();
+    }
+}
+BENCHMARK(BM_Bill_PmrQueryByTime)->Apply(SuiteArgs);
+
+static void BM_Bill_PmrQueryByTimeInOrder(benchmark::State& state) {
+    SuiteDatabase db(state, "suite_bill_pmr_time_order");
+    QueryArena arena;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(db.bills.queryByTimeInOrder(kFrom, kTo, arena.Resource()));
+        arena.Reset();
+    }
+}
+BENCHMARK(BM_Bill_PmrQueryByTimeInOrder)->Apply(SuiteArgs);
+
+static void BM_Bill_PmrQueryByTimeAndEventInOrder(benchmark::State& state) {
+    SuiteDatabase db(state, "suite_bill_pmr_time_event_order");
+    QueryArena arena;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(db.bills.queryByTimeAndEventInOrder(kFrom, kTo, arena.Resource()));
+        arena.Reset();
+    }
+}
+BENCHMARK(BM_Bill_PmrQueryByTimeAndEventInOrder)->Apply(SuiteArgs);
+
+static void BM_Bill_TotalsByEvent(benchmark::State& state) {
+    SuiteDatabase db(state, "suite_bill_totals_event");
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(db.bills.totalsByEvent(0, INT64_MAX));
+    }
+}
+BENCHMARK(BM_Bill_TotalsByEvent)->Apply(SuiteArgs);
+
+static void BM_Bill_TotalsByOwner(benchmark::State& state) {
+    SuiteDatabase db(state, "suite_bill_totals_owner");
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(db.bills.totalsByOwner(0, INT64_MAX));
+    }
+}
+BENCHMARK(BM_Bill_TotalsByOwner)->Apply(SuiteArgs);
+
+static void BM_Bill_TotalsByPeriod(benchmark::State& state) {
+    SuiteDatabase db(state, "suite_bill_totals_period");
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(db.bills.totalsByPeriod(0, INT64_MAX, model::Granularity::Day));
+    }
+}
+BENCHMARK(BM_Bill_TotalsByPeriod)->Apply(SuiteArgs);
+
+static void BM_Bill_Summary(benchmark::State& state) {
+    SuiteDatabase db(state, "suite_bill_summary");
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(db.bills.summary(0, INT64_MAX));
+    }
+}
+BENCHMARK(BM_Bill_Summary)->Apply(SuiteArgs);
+
+static void BM_Bill_RebuildRollups(benchmark::State& state) {
+    SuiteDatabase db(state, "suite_bill_rebuild_rollups");
+    for (auto _ : state) {
+        db.bills.rebuildRollups();
+    }
+}
+BENCHMARK(BM_Bill_RebuildRollups)->Apply(SuiteArgs)->Unit(benchmark::kMillisecond);
+
+static void BM_Bill_CheckRollups(benchmark::State& state) {
+    SuiteDatabase db(state, "suite_bill_check_rollups");
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(db.bills.checkRollups());
+    }
+}
+BENCHMARK(BM_Bill_CheckRollups)->Apply(SuiteArgs)->Unit(benchmark::kMillisecond);
+
+static void BM_Bill_ForEachByTime(benchmark::State& state) {
+    SuiteDatabase db(state, "suite_bill_foreach_time");
+    for (auto _ : state) {
+        int64_t sum = 0;
+        db.bills.forEachByTime(kFrom, kTo, [&](const model::BillRow& b) { sum += b.amount.cents; });
+        benchmark::DoNotOptimize(sum);
+    }
+}
+BENCHMARK(BM_Bill_ForEachByTime)->Apply(SuiteArgs);
+
+static void BM_Bill_ForEachByTimeInOrder(benchmark::State& state) {
+    SuiteDatabase db(state, "suite_bill_foreach_time_order");
+    for (auto _ : state) {
+        int64_t sum = 0;
+        db.bills.forEachByTimeInOrder(kFrom, kTo, [&](const model::BillRow& b) { sum += b.amount.cents; });
+        benchmark::DoNotOptimize(sum);
+    }
+}
+BENCHMARK(BM_Bill_ForEachByTimeInOrder)->Apply(SuiteArgs);
+
+static void BM_Bill_ForEachByTimeAndEventInOrder(benchmark::State& state) {
+    SuiteDatabase db(state, "suite_bill_foreach_time_event_order");
+    for (auto _ : state) {
+        int64_t sum = 0;
+        db.bills.forEachByTimeAndEventInOrder(kFrom, kTo, [&](const model::BillRow& b) { sum += b.amount.cents; });
+        benchmark::DoNotOptimize(sum);
+    }
+}
+BENCHMARK(BM_Bill_ForEachByTimeAndEventInOrder)->Apply(SuiteArgs);
+
+static void BM_Bill_Remove(benchmark::State& state) {
+    SuiteDatabase db(state, "suite_bill_remove");
+    auto bill = db.Bench().MakeBills(1, SuiteDatabase::kStart)[0];
+    for (auto _ : state) {
+        state.PauseTiming();
+        int id = db.bills.save(bill);
+        state.ResumeTiming();
+        db.bills.remove(id);
+    }
+}
+BENCHMARK(BM_Bill_Remove)->Apply(SuiteArgs);
+
+// ==================== IUserRepository ====================
+
+static void BM_User_SaveInsert(benchmark::State& state) {
+    SuiteDatabase db(state, "suite_user_insert");
+    int64_t n = 0;
+    char phone[16];
+    for (auto _ : state) {
+        std::snprintf(phone, sizeof(phone), "137%08lld", static_cast<long long>(n++));
+        benchmark::DoNotOptimize(db.users.save(model::User(phone, "suite", "suite")));
+    }
+}
+BENCHMARK(BM_User_SaveInsert)->Apply(SuiteArgs);
+
+static void BM_User_SaveUpdate(benchmark::State& state) {
+    SuiteDatabase db(state, "suite_user_update");
+    auto user = *db.users.findById(db.user_ids[0]);
+    for (auto _ : state) {
+        user.username = user.username == "a" ? "b" : "a";
+        benchmark::DoNotOptimize(db.users.save(user));
+    }
+}
+BENCHMARK(BM_User_SaveUpdate)->Apply(SuiteArgs);
+
+static void BM_User_FindById(benchmark::State& state) {
+    SuiteDatabase db(state, "suite_user_find");
+    size_t i = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(db.users.findById(db.user_ids[i++ % db.user_ids.size()]));
+    }
+}
+BENCHMARK(BM_User_FindById)->Apply(SuiteArgs);
+
+static void BM_User_QueryByPhone(benchmark::State& state) {
+    SuiteDatabase db(state, "suite_user_phone");
+    size_t i = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(db.users.queryByPhone(db.phones[i++ % db.phones.size()]));
+    }
+}
+BENCHMARK(BM_User_QueryByPhone)->Apply(SuiteArgs);
+
+static void BM_User_QueryByPhonePartial(benchmark::State& state) {
+    SuiteDatabase db(state, "suite_user_phone_partial");
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(db.users.queryByPhonePartial("0042"));
+    }
+}
+BENCHMARK(BM_User_QueryByPhonePartial)->Apply(SuiteArgs);
+
+static void BM_User_SetBalanceByPhone(benchmark::State& state) {
+    SuiteDatabase db(state, "suite_user_balance");
+    size_t i = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(db.users.setBalanceByPhone(db.phones[i % db.phones.size()],
+                                                            model::Money(static_cast<int64_t>(i))));
+        ++i;
+    }
+}
+BENCHMARK(BM_User_SetBalanceByPhone)->Apply(SuiteArgs);
+
+// ==================== IEventRepository ====================
+
+static void BM_Event_SaveInsert(benchmark::State& state) {
+    SuiteDatabase db(state, "suite_event_insert");
+    int64_t n = 0;
+    for (auto _ : state) {
+        model::Event e;
+        e.name = "bench_event_" + std::to_string(n++);
+        benchmark::DoNotOptimize(db.events.save(e));
+    }
+}
+BENCHMARK(BM_Event_SaveInsert)->Apply(SuiteArgs);
+
+static void BM_Event_FindById(benchmark::State& state) {
+    SuiteDatabase db(state, "suite_event_find");
+    size_t i = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(db.events.findById(db.event_ids[i++ % db.event_ids.size()]));
+    }
+}
+BENCHMARK(BM_Event_FindById)->Apply(SuiteArgs);
+
+static void BM_Event_FindByName(benchmark::State& state) {
+    SuiteDatabase db(state, "suite_event_name");
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(db.events.findByName("event_3"));
+    }
+}
+BENCHMARK(BM_Event_FindByName)->Apply(SuiteArgs);
+
+static void BM_Event_SetStatusById(benchmark::State& state) {
+    SuiteDatabase db(state, "suite_event_status");
+    int status = model::EventStatus::Available;
+    for (auto _ : state) {
+        status = status == model::EventStatus::Available ? model::EventStatus::Frozen : model::EventStatus::Available;
+        benchmark::DoNotOptimize(db.events.setStatusById(db.event_ids[1], status));
+    }
+}
+BENCHMARK(BM_Event_SetStatusById)->Apply(SuiteArgs);
+
+static void BM_Event_IsFrozen(benchmark::State& state) {
+    SuiteDatabase db(state, "suite_event_frozen");
+    size_t i = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(db.events.isFrozen(db.event_ids[i++ % db.event_ids.size()]));
+    }
+}
+BENCHMARK(BM_Event_IsFrozen)->Apply(SuiteArgs);
+
+// ==================== IAnnotationRepository ====================
+
+static void BM_Annotation_Save(benchmark::State& state) {
+    SuiteDatabase db(state, "suite_annotation_save");
+    size_t i = 0;
+    for (auto _ : state) {
+        model::Annotation a;
+        a.bill_id = db.BillId(i++);
+        a.authorid = db.OwnerId();
+        a.content = "bench note";
+        benchmark::DoNotOptimize(db.annotations.save(a));
+    }
+}
+BENCHMARK(BM_Annotation_Save)->Apply(SuiteArgs);
+
+static void BM_Annotation_FindById(benchmark::State& state) {
+    SuiteDatabase db(state, "suite_annotation_find");
+    size_t i = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(db.annotations.findById(db.annotation_ids[i++ % db.annotation_ids.size()]));
+    }
+}
+BENCHMARK(BM_Annotation_FindById)->Apply(SuiteArgs);
+
+static void BM_Annotation_FindByBillId(benchmark::State& state) {
+    SuiteDatabase db(state, "suite_annotation_by_bill");
+    size_t i = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(db.annotations.findByBillId(db.BillId(i++ * 10)));
+    }
+}
+BENCHMARK(BM_Annotation_FindByBillId)->Apply(SuiteArgs);
+
+static void BM_Annotation_FindByBillIdPmr(benchmark::State& state) {
+    SuiteDatabase db(state, "suite_annotation_by_bill_pmr");
+    QueryArena arena;
+    size_t i = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(db.annotations.findByBillId(db.BillId(i++ * 10), arena.Resource()));
+        arena.Reset();
+    }
+}
+BENCHMARK(BM_Annotation_FindByBillIdPmr)->Apply(SuiteArgs);
+
+static void BM_Annotation_FindByAuthorId(benchmark::State& state) {
+    SuiteDatabase db(state, "suite_annotation_by_author");
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(db.annotations.findByAuthorId(db.OwnerId()));
+    }
+}
+BENCHMARK(BM_Annotation_FindByAuthorId)->Apply(SuiteArgs)->Unit(benchmark::kMillisecond);
+
+static void BM_Annotation_RemoveByBillId(benchmark::State& state) {
+    SuiteDatabase db(state, "suite_annotation_remove");
+    size_t i = 0;
+    for (auto _ : state) {
+        state.PauseTiming();
+        model::Annotation a;
+        a.bill_id = db.BillId(i++);
+        a.authorid = db.OwnerId();
+        a.content = "bench note";
+        db.annotations.save(a);
+        state.ResumeTiming();
+        db.annotations.removeByBillId(a.bill_id);
+    }
+}
+BENCHMARK(BM_Annotation_RemoveByBillId)->Apply(SuiteArgs);
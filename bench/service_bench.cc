@@ -0,0 +1,186 @@
+#include "SuiteDatabase.h"
+#include "QueryArena.h"
+#include "BillService.h"
+#include "StatisticsService.h"
+
+// BillService / StatisticsService 的完整调用路径（校验 + 仓库），参数见 SuiteArgs
+
+namespace {
+
+constexpr model::Timestamp kFrom = SuiteDatabase::kStart;
+constexpr model::Timestamp kTo = SuiteDatabase::kStart + SuiteDatabase::kWindow - 1;
+
+struct ServiceFixture {
+    explicit ServiceFixture(const benchmark::State& state, const std::string& name)
+        : db(state, name),
+          bill_repo(std::make_shared<BillRepositoryImpl>(db.Bench().GetDatabase())),
+          anno_repo(std::make_shared<AnnotationRepositoryImpl>(db.Bench().GetDatabase())),
+          bills(bill_repo, anno_repo),
+          statistics(bill_repo) {}
+
+    SuiteDatabase db;
+    std::shared_ptr<BillRepositoryImpl> bill_repo;
+    std::shared_ptr<AnnotationRepositoryImpl> anno_repo;
+    BillService bills;
+    StatisticsService statistics;
+};
+
+}
+
+// ==================== BillService ====================
+
+static void BM_BillService_CreateBill(benchmark::State& state) {
+    ServiceFixture f(state, "suite_service_create");
+    auto bill = f.db.Bench().MakeBills(1, SuiteDatabase::kStart)[0];
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(f.bills.CreateBill(f.db.OwnerId(), bill));
+    }
+}
+BENCHMARK(BM_BillService_CreateBill)->Apply(SuiteArgs);
+
+static void BM_BillService_CreateBills100(benchmark::State& state) {
+    ServiceFixture f(state, "suite_service_create_batch");
+    auto batch = f.db.Bench().MakeBills(100, SuiteDatabase::kStart);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(f.bills.CreateBills(f.db.OwnerId(), batch));
+    }
+    state.SetItemsProcessed(state.iterations() * 100);
+}
+BENCHMARK(BM_BillService_CreateBills100)->Apply(SuiteArgs);
+
+static void BM_BillService_QueryByTime(benchmark::State& state) {
+    ServiceFixture f(state, "suite_service_time");
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(f.bills.QueryByTime(f.db.OwnerId(), kFrom, kTo));
+    }
+}
+BENCHMARK(BM_BillService_QueryByTime)->Apply(SuiteArgs);
+
+static void BM_BillService_QueryByEvent(benchmark::State& state) {
+    ServiceFixture f(state, "suite_service_event");
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(f.bills.queryByEvent(f.db.OwnerId(), f.db.event_ids[1]));
+    }
+}
+BENCHMARK(BM_BillService_QueryByEvent)->Apply(SuiteArgs);
+
+static void BM_BillService_QueryByPhone(benchmark::State& state) {
+    ServiceFixture f(state, "suite_service_phone");
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(f.bills.queryByPhone("13800000001"));
+    }
+}
+BENCHMARK(BM_BillService_QueryByPhone)->Apply(SuiteArgs);
+
+// 编辑流程：findById + save
+static void BM_BillService_EditBill(benchmark::State& state) {
+    ServiceFixture f(state, "suite_service_edit");
+    auto updates = f.db.Bench().MakeBills(1, SuiteDatabase::kStart)[0];
+    size_t i = 0;
+    for (auto _ : state) {
+        f.bills.editBill(f.db.BillId(i++ * 7919), updates);
+    }
+}
+BENCHMARK(BM_BillService_EditBill)->Apply(SuiteArgs);
+
+// 批注流程：findById + 批注 save + 账单 save
+static void BM_BillService_AnnotateBill(benchmark::State& state) {
+    ServiceFixture f(state, "suite_service_annotate");
+    model::Annotation a;
+    a.authorid = f.db.OwnerId();
+    a.content = "bench note";
+    size_t i = 0;
+    for (auto _ : state) {
+        a.bill_id = f.db.BillId(i);
+        f.bills.annotateBill(f.db.BillId(i++), a);
+    }
+}
+BENCHMARK(BM_BillService_AnnotateBill)->Apply(SuiteArgs);
+
+static void BM_BillService_DeleteBill(benchmark::State& state) {
+    ServiceFixture f(state, "suite_service_delete");
+    auto bill = f.db.Bench().MakeBills(1, SuiteDatabase::kStart)[0];
+    for (auto _ : state) {
+        state.PauseTiming();
+        int id = f.bill_repo->save(bill);
+        state.ResumeTiming();
+        f.bills.deleteBill(id);
+    }
+}
+BENCHMARK(BM_BillService_DeleteBill)->Apply(SuiteArgs);
+
+// ==================== StatisticsService ====================
+
+static void BM_StatisticsService_QueryByTimeInOrder(benchmark::State& state) {
+    ServiceFixture f(state, "suite_stats_time_order");
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(f.statistics.QueryByTimeInOrder(kFrom, kTo));
+    }
+}
+BENCHMARK(BM_StatisticsService_QueryByTimeInOrder)->Apply(SuiteArgs);
+
+static void BM_StatisticsService_QueryByTimeAndEventInOrder(benchmark::State& state) {
+    ServiceFixture f(state, "suite_stats_time_event_order");
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(f.statistics.QueryByTimeAndEventInOrder(kFrom, kTo));
+    }
+}
+BENCHMARK(BM_StatisticsService_QueryByTimeAndEventInOrder)->Apply(SuiteArgs);
+
+static void BM_StatisticsService_QueryByTimeInOrderPmr(benchmark::State& state) {
+    ServiceFixture f(state, "suite_stats_time_order_pmr");
+    QueryArena arena;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(f.statistics.QueryByTimeInOrder(kFrom, kTo, arena.Resource()));
+        arena.Reset();
+    }
+}
+BENCHMARK(BM_StatisticsService_QueryByTimeInOrderPmr)->Apply(SuiteArgs);
+
+// 报表页：汇总 + 按事件 + 按天，一次打开统计界面的全部查询
+static void BM_StatisticsService_Dashboard(benchmark::State& state) {
+    ServiceFixture f(state, "suite_stats_dashboard");
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(f.statistics.Summary(0, INT64_MAX));
+        benchmark::DoNotOptimize(f.statistics.TotalsByEvent(0, INT64_MAX));
+        benchmark::DoNotOptimize(f.statistics.TotalsByOwner(0, INT64_MAX));
+        benchmark::DoNotOptimize(f.statistics.TotalsByPeriod(0, INT64_MAX, model::Granularity::Month));
+    }
+}
+BENCHMARK(BM_StatisticsService_Dashboard)->Apply(SuiteArgs);
+
+// 导出：分页读完全部账单
+static void BM_StatisticsService_ExportAllPages(benchmark::State& state) {
+    ServiceFixture f(state, "suite_stats_export");
+    for (auto _ : state) {
+        int64_t rows = 0;
+        std::optional<model::BillCursor> after;
+        do {
+            auto page = f.statistics.QueryByTimePage(0, INT64_MAX, after, 500);
+            rows += static_cast<int64_t>(page.bills.size());
+            after = page.next;
+        } while (after.has_value());
+        benchmark::DoNotOptimize(rows);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_StatisticsService_ExportAllPages)->Apply(SuiteArgs)->Unit(benchmark::kMillisecond);
+
+static void BM_StatisticsService_ForEachByTimeAndEventInOrder(benchmark::State& state) {
+    ServiceFixture f(state, "suite_stats_foreach");
+    for (auto _ : state) {
+        int64_t sum = 0;
+        f.statistics.ForEachByTimeAndEventInOrder(0, INT64_MAX, [&](const model::BillRow& b) { sum += b.amount.cents; });
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_StatisticsService_ForEachByTimeAndEventInOrder)->Apply(SuiteArgs)->Unit(benchmark::kMillisecond);
+
+static void BM_StatisticsService_CheckRollups(benchmark::State& state) {
+    ServiceFixture f(state, "suite_stats_check_rollups");
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(f.statistics.CheckRollups());
+    }
+}
+BENCHMARK(BM_StatisticsService_CheckRollups)->Apply(SuiteArgs)->Unit(benchmark::kMillisecond);
@@ -0,0 +1,66 @@
+#include "BenchDatabase.h"
+#include "BillRepositoryImpl.h"
+#include <benchmark/benchmark.h>
+#include <cstdlib>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace {
+
+// 设置后追加 rows=0 一组参数，直接打开该文件（如 billgen --bills 10000000 生成的库）而不是自行生成
+const char* ExternalDatabase() {
+    return std::getenv("BILL_BENCH_STARTUP_DB");
+}
+
+void StartupArgs(benchmark::internal::Benchmark* b) {
+    b->ArgNames({"rows", "versioned"});
+    std::vector<int64_t> rows = {100000, 1000000};
+    if (ExternalDatabase() != nullptr) {
+        rows.push_back(0);
+    }
+    b->ArgsProduct({rows, {0, 1}});
+    b->Unit(benchmark::kMillisecond);
+}
+
+void SetUserVersion(const std::string& path, int version) {
+    sqlite3* db = nullptr;
+    sqlite3_open(path.c_str(), &db);
+    sqlite3_exec(db, ("PRAGMA user_version = " + std::to_string(version)).c_str(), nullptr, nullptr, nullptr);
+    sqlite3_close(db);
+}
+
+}
+
+// 启动时打开数据库的耗时。versioned=1 为 user_version 已是最新、跳过迁移的路径；
+// versioned=0 每次打开前把 user_version 清零，相当于原先每次启动都执行 sync_schema
+static void BM_OpenDatabase(benchmark::State& state) {
+    const int rows = static_cast<int>(state.range(0));
+    const bool versioned = state.range(1) != 0;
+
+    std::unique_ptr<BenchDatabase> bench;
+    std::string path;
+    if (rows == 0) {
+        path = ExternalDatabase();
+    } else {
+        bench = std::make_unique<BenchDatabase>("startup");
+        BillRepositoryImpl repo(bench->GetDatabase());
+        repo.saveBatch(bench->MakeBills(rows));
+        path = bench->GetPath();
+        bench->Close();
+    }
+
+    for (auto _ : state) {
+        if (!versioned) {
+            state.PauseTiming();
+            SetUserVersion(path, 0);
+            state.ResumeTiming();
+        }
+        DatabaseORM db(path);
+        benchmark::DoNotOptimize(db.NeedsRollupRebuild());
+    }
+
+    // 外部文件保持为最新版本
+    SetUserVersion(path, DatabaseORM::SchemaVersion());
+}
+BENCHMARK(BM_OpenDatabase)->Apply(StartupArgs);
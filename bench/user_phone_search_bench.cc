@@ -0,0 +1,102 @@
+#include "BenchDatabase.h"
+#include "PhoneTrigramIndex.h"
+#include "UserRepositoryImpl.h"
+#include <benchmark/benchmark.h>
+#include <cstdio>
+#include <system_error>
+
+namespace {
+
+void ScaleArgs(benchmark::internal::Benchmark* b) {
+    b->ArgNames({"users"});
+    for (int users : {10000, 100000, 1000000}) {
+        b->Arg(users);
+    }
+    b->Unit(benchmark::kMicrosecond);
+}
+
+// 写入 n 个手机号伪随机的用户，种子固定
+void SeedUsers(BenchDatabase& bench, int n) {
+    auto& storage = bench.GetDatabase()->GetStorage();
+    auto guard = storage.transaction_guard();
+    uint64_t state = 42;
+    model::User u("", "bench", "bench");
+    auto statement = storage.prepare(orm::insert(u));
+    char phone[16];
+    for (int i = 0; i < n; ++i) {
+        state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+        std::snprintf(phone, sizeof(phone), "1%010llu",
+                      static_cast<unsigned long long>((state >> 20) % 10000000000ULL));
+        u.phone = phone;
+        orm::get<0>(statement) = u;
+        try {
+            storage.execute(statement);
+        } catch (const std::system_error&) {
+            // 手机号重复，跳过
+        }
+    }
+    guard.commit();
+}
+
+// 管理员搜索框输入的关键字，从短到长
+const char* const kKeywords[] = {"138", "8421", "57310"};
+
+}
+
+// 旧做法：LIKE '%partial%'，每次全表扫描
+static void BM_PhonePartial_Like(benchmark::State& state) {
+    BenchDatabase bench("phone_like");
+    SeedUsers(bench, static_cast<int>(state.range(0)));
+    auto& storage = bench.GetDatabase()->GetStorage();
+
+    size_t i = 0;
+    for (auto _ : state) {
+        std::string partial = kKeywords[i++ % 3];
+        auto users = storage.get_all<model::User>(
+            orm::where(orm::like(&model::User::phone, "%" + partial + "%")));
+        benchmark::DoNotOptimize(users);
+    }
+}
+BENCHMARK(BM_PhonePartial_Like)->Apply(ScaleArgs);
+
+// 三元组索引定位 id，再按主键取行
+static void BM_PhonePartial_Trigram(benchmark::State& state) {
+    BenchDatabase bench("phone_trigram");
+    SeedUsers(bench, static_cast<int>(state.range(0)));
+    UserRepositoryImpl repo(bench.GetDatabase());
+    bench.GetDatabase()->GetPhoneIndex().Size(); // 预先构建索引
+
+    size_t i = 0;
+    for (auto _ : state) {
+        auto users = repo.queryByPhonePartial(kKeywords[i++ % 3]);
+        benchmark::DoNotOptimize(users);
+    }
+}
+BENCHMARK(BM_PhonePartial_Trigram)->Apply(ScaleArgs);
+
+// 只计索引内查找，不含取行
+static void BM_PhonePartial_IndexOnly(benchmark::State& state) {
+    BenchDatabase bench("phone_index_only");
+    SeedUsers(bench, static_cast<int>(state.range(0)));
+    auto& index = bench.GetDatabase()->GetPhoneIndex();
+    index.Size();
+
+    size_t i = 0;
+    for (auto _ : state) {
+        auto ids = index.Search(kKeywords[i++ % 3]);
+        benchmark::DoNotOptimize(ids);
+    }
+}
+BENCHMARK(BM_PhonePartial_IndexOnly)->Apply(ScaleArgs);
+
+// 启动时构建索引的耗时
+static void BM_PhoneIndexBuild(benchmark::State& state) {
+    BenchDatabase bench("phone_index_build");
+    SeedUsers(bench, static_cast<int>(state.range(0)));
+
+    for (auto _ : state) {
+        PhoneTrigramIndex index(bench.GetDatabase()->GetStorage());
+        benchmark::DoNotOptimize(index.Size());
+    }
+}
+BENCHMARK(BM_PhoneIndexBuild)->Apply(ScaleArgs)->Unit(benchmark::kMillisecond)->Iterations(1);
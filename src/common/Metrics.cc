@@ -0,0 +1,264 @@
+#include "Metrics.h"
+
+#include <algorithm>
+#include <iomanip>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <stdexcept>
+
+namespace metrics {
+
+namespace {
+
+// 把一个计数槽累加到快照（读其他线程的槽，relaxed 读即可，允许与写入交错）。
+// total_ns / max_ns 在此阶段仍是刻度，由 ToNanoseconds 统一换算
+void Accumulate(MetricSnapshot& s, const Cell& cell) {
+    s.calls += cell.calls.load(std::memory_order_relaxed);
+    s.errors += cell.errors.load(std::memory_order_relaxed);
+    s.rows += cell.rows.load(std::memory_order_relaxed);
+    s.total_ns += cell.total_ticks.load(std::memory_order_relaxed);
+    s.max_ns = std::max(s.max_ns, cell.max_ticks.load(std::memory_order_relaxed));
+    for (int b = 0; b < kBuckets; ++b) {
+        s.buckets[b] += cell.buckets[b].load(std::memory_order_relaxed);
+    }
+}
+
+void Clear(Cell& cell) {
+    cell.calls.store(0, std::memory_order_relaxed);
+    cell.errors.store(0, std::memory_order_relaxed);
+    cell.rows.store(0, std::memory_order_relaxed);
+    cell.total_ticks.store(0, std::memory_order_relaxed);
+    cell.max_ticks.store(0, std::memory_order_relaxed);
+    for (auto& b : cell.buckets) {
+        b.store(0, std::memory_order_relaxed);
+    }
+}
+
+MetricSnapshot EmptySnapshot(const std::string& name) {
+    MetricSnapshot s;
+    s.name = name;
+    s.buckets.assign(kBuckets, 0);
+    return s;
+}
+
+void ToNanoseconds(MetricSnapshot& s, double ns_per_tick) {
+    s.ns_per_tick = ns_per_tick;
+    s.total_ns = static_cast<uint64_t>(static_cast<double>(s.total_ns) * ns_per_tick);
+    s.max_ns = static_cast<uint64_t>(static_cast<double>(s.max_ns) * ns_per_tick);
+}
+
+}
+
+double NsPerTick() {
+#ifdef METRICS_HAS_TSC
+    // 用 steady_clock 量一段约 10ms 的间隔，得到 TSC 频率；现代 x86 的 TSC 恒定速率且跨核同步
+    static const double ns_per_tick = [] {
+        auto wall_start = Clock::now();
+        uint64_t tick_start = Ticks();
+        while (Clock::now() - wall_start < std::chrono::milliseconds(10)) {
+        }
+        auto wall = std::chrono::duration<double, std::nano>(Clock::now() - wall_start).count();
+        uint64_t ticks = Ticks() - tick_start;
+        return ticks == 0 ? 1.0 : wall / static_cast<double>(ticks);
+    }();
+    return ns_per_tick;
+#else
+    return 1.0;
+#endif
+}
+
+struct Registry::Impl {
+    std::mutex mutex;
+    std::vector<std::unique_ptr<Metric>> metrics;       // 下标即 id
+    std::map<std::string, Metric*> by_name;
+    std::vector<ThreadCells*> threads;                  // 仍在运行的线程
+    std::vector<MetricSnapshot> retired;                // 已退出线程的累计，下标即 id
+
+    // 线程退出时调用：计数并入 retired，释放计数槽
+    void Retire(ThreadCells* thread) {
+        std::lock_guard<std::mutex> lock(mutex);
+        for (size_t id = 0; id < metrics.size(); ++id) {
+            Cell* cell = thread->cells[id].load(std::memory_order_acquire);
+            if (cell != nullptr) {
+                Accumulate(retired[id], *cell);
+                delete cell;
+            }
+        }
+        threads.erase(std::remove(threads.begin(), threads.end(), thread), threads.end());
+        delete thread;
+    }
+};
+
+Registry& Registry::Instance() {
+    static Registry* instance = new Registry();
+    return *instance;
+}
+
+Registry::Impl& Registry::impl() {
+    static Impl* impl = new Impl();
+    return *impl;
+}
+
+namespace {
+
+// 线程退出时把本线程的计数槽交回注册表。退出之后若仍有记录（如其他 thread_local 的析构函数），
+// 会重新分配一组不再回收的计数槽，仍计入快照
+struct ThreadRetirer {
+    ThreadCells* cells = nullptr;
+    ~ThreadRetirer();
+};
+
+thread_local ThreadCells* current_cells = nullptr;
+thread_local bool thread_retired = false;
+thread_local ThreadRetirer retirer;
+
+}
+
+ThreadCells& CurrentThreadCells() {
+    if (current_cells != nullptr) {
+        return *current_cells;
+    }
+    auto& impl = Registry::Instance().impl();
+    auto* cells = new ThreadCells();
+    {
+        std::lock_guard<std::mutex> lock(impl.mutex);
+        impl.threads.push_back(cells);
+    }
+    current_cells = cells;
+    if (!thread_retired) {
+        retirer.cells = cells;
+    }
+    return *cells;
+}
+
+void RetireThreadCells(ThreadCells* thread) {
+    Registry::Instance().impl().Retire(thread);
+}
+
+ThreadRetirer::~ThreadRetirer() {
+    thread_retired = true;
+    if (cells != nullptr) {
+        current_cells = nullptr;
+        RetireThreadCells(cells);
+    }
+}
+
+Cell& AllocateCell(ThreadCells& thread, int id) {
+    auto* cell = new Cell();
+    // 与 Snapshot / Reset 互斥，保证它们看到的要么是空槽要么是完整初始化的槽
+    std::lock_guard<std::mutex> lock(Registry::Instance().impl().mutex);
+    thread.cells[id].store(cell, std::memory_order_release);
+    return *cell;
+}
+
+Metric& Registry::Get(const std::string& name) {
+    auto& impl = this->impl();
+    std::lock_guard<std::mutex> lock(impl.mutex);
+    auto it = impl.by_name.find(name);
+    if (it != impl.by_name.end()) {
+        return *it->second;
+    }
+    if (impl.metrics.size() >= static_cast<size_t>(kMaxMetrics)) {
+        throw std::length_error("metrics: 指标数超过 kMaxMetrics");
+    }
+    int id = static_cast<int>(impl.metrics.size());
+    impl.metrics.push_back(std::make_unique<Metric>(id, name));
+    impl.retired.push_back(EmptySnapshot(name));
+    impl.by_name.emplace(name, impl.metrics.back().get());
+    return *impl.metrics.back();
+}
+
+std::vector<MetricSnapshot> Registry::Snapshot() {
+    // 校准在加锁之前完成，避免首次快照时长时间持锁
+    const double ns_per_tick = NsPerTick();
+    auto& impl = this->impl();
+    std::lock_guard<std::mutex> lock(impl.mutex);
+
+    std::vector<MetricSnapshot> result = impl.retired;
+    for (const auto* thread : impl.threads) {
+        for (size_t id = 0; id < impl.metrics.size(); ++id) {
+            const Cell* cell = thread->cells[id].load(std::memory_order_acquire);
+            if (cell != nullptr) {
+                Accumulate(result[id], *cell);
+            }
+        }
+    }
+    for (auto& s : result) {
+        ToNanoseconds(s, ns_per_tick);
+    }
+    std::sort(result.begin(), result.end(),
+              [](const MetricSnapshot& a, const MetricSnapshot& b) { return a.name < b.name; });
+    return result;
+}
+
+std::optional<MetricSnapshot> Registry::Find(const std::string& name) {
+    for (auto& s : Snapshot()) {
+        if (s.name == name) {
+            return s;
+        }
+    }
+    return std::nullopt;
+}
+
+void Registry::Dump(std::ostream& out) {
+    auto us = [](double ns) { return ns / 1000.0; };
+    out << std::left << std::setw(48) << "metric" << std::right
+        << std::setw(12) << "calls" << std::setw(10) << "errors" << std::setw(14) << "rows"
+        << std::setw(12) << "mean_us" << std::setw(12) << "p50_us" << std::setw(12) << "p99_us"
+        << std::setw(12) << "max_us" << '\n';
+    out << std::fixed << std::setprecision(1);
+    for (const auto& s : Snapshot()) {
+        if (s.calls == 0) {
+            continue;
+        }
+        out << std::left << std::setw(48) << s.name << std::right
+            << std::setw(12) << s.calls << std::setw(10) << s.errors << std::setw(14) << s.rows
+            << std::setw(12) << us(s.MeanNs())
+            << std::setw(12) << us(static_cast<double>(s.PercentileNs(0.50)))
+            << std::setw(12) << us(static_cast<double>(s.PercentileNs(0.99)))
+            << std::setw(12) << us(static_cast<double>(s.max_ns)) << '\n';
+    }
+    out.flush();
+}
+
+void Registry::Reset() {
+    auto& impl = this->impl();
+    std::lock_guard<std::mutex> lock(impl.mutex);
+    for (auto& s : impl.retired) {
+        s = EmptySnapshot(s.name);
+    }
+    // 其他线程可能同时在写，清零后的少量计数可能被其旧值覆盖，只适合静止时调用
+    for (auto* thread : impl.threads) {
+        for (size_t id = 0; id < impl.metrics.size(); ++id) {
+            Cell* cell = thread->cells[id].load(std::memory_order_acquire);
+            if (cell != nullptr) {
+                Clear(*cell);
+            }
+        }
+    }
+}
+
+uint64_t MetricSnapshot::PercentileNs(double p) const {
+    uint64_t count = 0;
+    for (auto b : buckets) {
+        count += b;
+    }
+    if (count == 0) {
+        return 0;
+    }
+    auto rank = static_cast<uint64_t>(std::clamp(p, 0.0, 1.0) * static_cast<double>(count));
+    rank = std::max<uint64_t>(rank, 1);
+    uint64_t seen = 0;
+    for (int b = 0; b < static_cast<int>(buckets.size()); ++b) {
+        seen += buckets[b];
+        if (seen >= rank) {
+            double mid = static_cast<double>(BucketLower(b)) + static_cast<double>(BucketWidth(b)) / 2;
+            return std::min(max_ns, static_cast<uint64_t>(mid * ns_per_tick));
+        }
+    }
+    return max_ns;
+}
+
+}
@@ -0,0 +1,235 @@
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <exception>
+#include <iosfwd>
+#include <optional>
+#include <string>
+#include <vector>
+
+#if defined(__x86_64__) || defined(_M_X64)
+#if defined(_MSC_VER)
+#include <intrin.h>
+#else
+#include <x86intrin.h>
+#endif
+#define METRICS_HAS_TSC 1
+#endif
+
+// 进程内的方法级指标：调用次数、错误次数、返回行数与延迟直方图。
+// 每个线程只写自己的计数槽（单写者，relaxed 原子读写，无锁），Snapshot 时汇总所有线程；
+// 线程退出时其计数并入全局累计，不会丢失。
+namespace metrics {
+
+using Clock = std::chrono::steady_clock;
+
+// 计时用的原始刻度。x86-64 上读 TSC（比 steady_clock 便宜一半以上），快照时再按校准的频率换算为纳秒；
+// 其他平台直接用 steady_clock 的纳秒数
+inline uint64_t Ticks() {
+#ifdef METRICS_HAS_TSC
+    return __rdtsc();
+#else
+    return static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now().time_since_epoch()).count());
+#endif
+}
+
+// 每个刻度对应的纳秒数，首次调用时校准（约 10ms）
+double NsPerTick();
+
+// HDR 风格的对数线性分桶（单位为刻度）：小于 8 逐个一桶，之后每个 2 的幂区间再等分 8 份，
+// 相对误差不超过 12.5%；超过 2^40 刻度的记入最后一桶
+constexpr int kSubBucketBits = 3;
+constexpr int kSubBuckets = 1 << kSubBucketBits;
+constexpr int kMaxExponent = 39;
+constexpr int kBuckets = (kMaxExponent - kSubBucketBits + 2) * kSubBuckets;
+
+// 同一进程内最多登记的指标个数
+constexpr int kMaxMetrics = 256;
+
+inline int BucketOf(uint64_t ticks) {
+    if (ticks < static_cast<uint64_t>(kSubBuckets)) {
+        return static_cast<int>(ticks);
+    }
+#if defined(__GNUC__) || defined(__clang__)
+    int exponent = 63 - __builtin_clzll(ticks);
+#else
+    int exponent = 0;
+    for (uint64_t v = ticks; v > 1; v >>= 1) {
+        ++exponent;
+    }
+#endif
+    if (exponent > kMaxExponent) {
+        return kBuckets - 1;
+    }
+    int sub = static_cast<int>((ticks >> (exponent - kSubBucketBits)) & (kSubBuckets - 1));
+    return (exponent - kSubBucketBits + 1) * kSubBuckets + sub;
+}
+
+// 桶覆盖的区间 [lower, lower + width)
+inline uint64_t BucketLower(int bucket) {
+    if (bucket < kSubBuckets) {
+        return static_cast<uint64_t>(bucket);
+    }
+    int exponent = bucket / kSubBuckets + kSubBucketBits - 1;
+    uint64_t sub = static_cast<uint64_t>(bucket % kSubBuckets);
+    return (kSubBuckets + sub) << (exponent - kSubBucketBits);
+}
+
+inline uint64_t BucketWidth(int bucket) {
+    if (bucket < kSubBuckets) {
+        return 1;
+    }
+    int exponent = bucket / kSubBuckets + kSubBucketBits - 1;
+    return uint64_t{1} << (exponent - kSubBucketBits);
+}
+
+// 一个指标在一个线程中的计数槽，只由所属线程写入；耗时以刻度计
+struct Cell {
+    std::atomic<uint64_t> calls{0};
+    std::atomic<uint64_t> errors{0};
+    std::atomic<uint64_t> rows{0};
+    std::atomic<uint64_t> total_ticks{0};
+    std::atomic<uint64_t> max_ticks{0};
+    std::atomic<uint64_t> buckets[kBuckets] = {};
+};
+
+// 单写者自增：不需要 lock 前缀的 fetch_add
+inline void Bump(std::atomic<uint64_t>& counter, uint64_t delta) {
+    counter.store(counter.load(std::memory_order_relaxed) + delta, std::memory_order_relaxed);
+}
+
+// 当前线程的全部计数槽，按指标 id 下标
+struct ThreadCells {
+    std::atomic<Cell*> cells[kMaxMetrics] = {};
+};
+
+ThreadCells& CurrentThreadCells();
+Cell& AllocateCell(ThreadCells& thread, int id);
+void RetireThreadCells(ThreadCells* thread);
+
+class Metric {
+public:
+    Metric(int id, std::string name) : id_(id), name_(std::move(name)) {}
+
+    int Id() const { return id_; }
+    const std::string& Name() const { return name_; }
+
+    void Record(uint64_t ticks, uint64_t rows, bool error) {
+        auto& thread = CurrentThreadCells();
+        Cell* cell = thread.cells[id_].load(std::memory_order_relaxed);
+        if (cell == nullptr) {
+            cell = &AllocateCell(thread, id_);
+        }
+        Bump(cell->calls, 1);
+        Bump(cell->rows, rows);
+        Bump(cell->total_ticks, ticks);
+        Bump(cell->buckets[BucketOf(ticks)], 1);
+        if (error) {
+            Bump(cell->errors, 1);
+        }
+        if (ticks > cell->max_ticks.load(std::memory_order_relaxed)) {
+            cell->max_ticks.store(ticks, std::memory_order_relaxed);
+        }
+    }
+
+private:
+    int id_;
+    std::string name_;
+};
+
+// 某一时刻一个指标在所有线程上的汇总，时间已换算为纳秒
+struct MetricSnapshot {
+    std::string name;
+    uint64_t calls = 0;
+    uint64_t errors = 0;
+    uint64_t rows = 0;
+    uint64_t total_ns = 0;
+    uint64_t max_ns = 0;
+    std::vector<uint64_t> buckets;   // 按刻度分桶的原始计数
+    double ns_per_tick = 1.0;
+
+    double MeanNs() const { return calls == 0 ? 0.0 : static_cast<double>(total_ns) / calls; }
+    // p 取 0~1，返回所在桶的中点
+    uint64_t PercentileNs(double p) const;
+};
+
+class Registry {
+public:
+    // 进程级单例，永不析构，退出阶段的线程与 atexit 回调仍可安全访问
+    static Registry& Instance();
+
+    // 同名返回同一个对象；超过 kMaxMetrics 时抛出 std::length_error
+    Metric& Get(const std::string& name);
+
+    // 按名称排序；calls 为 0 的指标也会返回
+    std::vector<MetricSnapshot> Snapshot();
+    std::optional<MetricSnapshot> Find(const std::string& name);
+
+    // 以表格形式输出有调用记录的指标，时间单位为微秒
+    void Dump(std::ostream& out);
+
+    // 清零全部计数，指标登记保持不变（测试与分阶段压测用）
+    void Reset();
+
+private:
+    Registry() = default;
+    struct Impl;
+    Impl& impl();
+
+    friend ThreadCells& CurrentThreadCells();
+    friend Cell& AllocateCell(ThreadCells& thread, int id);
+    friend void RetireThreadCells(ThreadCells* thread);
+};
+
+// 统计一个 RowCount 的行数：容器取 size()，optional 取是否有值
+template<class Container>
+auto RowCount(const Container& c) -> decltype(static_cast<uint64_t>(c.size())) {
+    return static_cast<uint64_t>(c.size());
+}
+
+template<class T>
+uint64_t RowCount(const std::optional<T>& value) {
+    return value.has_value() ? 1 : 0;
+}
+
+// 作用域计时：析构时记录耗时；作用域因异常退出时计为错误。
+// 为省去构造时的一次 uncaught_exceptions 调用，只判断析构时是否有异常在传播，
+// 因此在其他对象的析构函数中（栈展开期间）计时的调用也会计为错误
+class ScopedTimer {
+public:
+    explicit ScopedTimer(Metric& metric) : metric_(metric), start_(Ticks()) {}
+
+    ~ScopedTimer() {
+        metric_.Record(Ticks() - start_, rows_, failed_ || std::uncaught_exceptions() > 0);
+    }
+
+    ScopedTimer(const ScopedTimer&) = delete;
+    ScopedTimer& operator=(const ScopedTimer&) = delete;
+
+    void Rows(uint64_t n) { rows_ = n; }
+    // 方法以返回值而非异常报告失败时调用
+    void Fail() { failed_ = true; }
+
+    // 记下结果的行数并原样返回：return timer.Counted(...);
+    template<class T>
+    T Counted(T result) {
+        rows_ = RowCount(result);
+        return result;
+    }
+
+private:
+    Metric& metric_;
+    uint64_t start_;
+    uint64_t rows_ = 0;
+    bool failed_ = false;
+};
+
+}
+
+// 为当前作用域创建名为 timer 的 ScopedTimer。指标对象按调用点缓存在静态变量里，
+// 之后每次调用只剩一次静态初始化检查、两次读刻度和本线程计数槽的几次写入
+#define METRICS_SCOPE(timer, name)                                                        \
+    static ::metrics::Metric& timer##_metric = ::metrics::Registry::Instance().Get(name); \
+    ::metrics::ScopedTimer timer(timer##_metric)
@@ -0,0 +1,26 @@
+#pragma once
+#include <cstddef>
+#include <memory_resource>
+#include <vector>
+
+// 查询结果用的单调分配区：一次查询的所有行和字符串从同一块缓冲区顺序分配，
+// Reset() 时整体归还，不逐个释放。在请求之间复用，初始缓冲区只申请一次。
+// 超出初始缓冲区时向 upstream 申请更大的块，Reset() 一并释放。非线程安全。
+class QueryArena {
+public:
+    explicit QueryArena(size_t initial_bytes = 1 << 20,
+                        std::pmr::memory_resource* upstream = std::pmr::get_default_resource())
+        : buffer_(initial_bytes), resource_(buffer_.data(), buffer_.size(), upstream) {}
+
+    QueryArena(const QueryArena&) = delete;
+    QueryArena& operator=(const QueryArena&) = delete;
+
+    std::pmr::memory_resource* Resource() { return &resource_; }
+
+    // 调用前必须先销毁所有从本 arena 分配的结果
+    void Reset() { resource_.release(); }
+
+private:
+    std::vector<std::byte> buffer_;
+    std::pmr::monotonic_buffer_resource resource_;
+};
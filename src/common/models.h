@@ -2,6 +2,10 @@
 #include <string>
 #include <vector>
 #include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <memory_resource>
+#include <optional>
 
 namespace model {
 
@@ -25,6 +29,44 @@ namespace model {
         ).count();
     }
 
+    // 金额：以分为单位的定点整数，求和与比较都是精确的，与累加顺序无关
+    struct Money {
+        int64_t cents = 0;
+
+        constexpr Money() = default;
+        constexpr explicit Money(int64_t cents) : cents(cents) {}
+
+        // 元 <-> 分，四舍五入到分，仅用于输入输出与旧数据迁移
+        static Money FromDouble(double yuan) {
+            return Money(std::llround(yuan * 100.0));
+        }
+        double ToDouble() const {
+            return static_cast<double>(cents) / 100.0;
+        }
+
+        constexpr Money& operator+=(Money other) {
+            cents += other.cents;
+            return *this;
+        }
+        constexpr Money& operator-=(Money other) {
+            cents -= other.cents;
+            return *this;
+        }
+    };
+
+    constexpr Money operator+(Money a, Money b) { return Money(a.cents + b.cents); }
+    constexpr Money operator-(Money a, Money b) { return Money(a.cents - b.cents); }
+    constexpr Money operator-(Money a) { return Money(-a.cents); }
+    constexpr Money operator*(Money a, int64_t n) { return Money(a.cents * n); }
+    constexpr Money operator*(int64_t n, Money a) { return Money(a.cents * n); }
+
+    constexpr bool operator==(Money a, Money b) { return a.cents == b.cents; }
+    constexpr bool operator!=(Money a, Money b) { return a.cents != b.cents; }
+    constexpr bool operator<(Money a, Money b) { return a.cents < b.cents; }
+    constexpr bool operator<=(Money a, Money b) { return a.cents <= b.cents; }
+    constexpr bool operator>(Money a, Money b) { return a.cents > b.cents; }
+    constexpr bool operator>=(Money a, Money b) { return a.cents >= b.cents; }
+
     namespace EventStatus {
         constexpr int Available = 0;
         constexpr int Frozen = 1;
@@ -59,7 +101,7 @@ namespace model {
         std::string username;
         std::string password;
         std::string role = "user";
-        double balance = 0.0;
+        Money balance;
         Timestamp created_at;
         
         User() {
@@ -67,7 +109,7 @@ namespace model {
         }
         
         User(const std::string& phone, const std::string& username, const std::string& password)
-            : phone(phone), username(username), password(password), role("user"), balance(0.0) {
+            : phone(phone), username(username), password(password), role("user") {
             created_at = Now();
         }
     };
@@ -77,7 +119,7 @@ namespace model {
         int owner_id = 0;
         int event_id = 0; 
         std::string description;
-        double amount = 0.0;
+        Money amount;
         Timestamp created_at;
         
         Event event;
@@ -88,4 +130,129 @@ namespace model {
             created_at = Now();
         }
     };
+
+    // 列表查询使用的账单投影：不含 Event/Annotation 子对象，构造时不调用 Now()。
+    // 完整的 Bill 只由 findById 返回。
+    struct BillRow {
+        int id = 0;
+        int owner_id = 0;
+        int event_id = 0;
+        Money amount;
+        Timestamp created_at = 0;
+        std::string description;
+        bool has_annotation = false;
+    };
+
+    // BillRow 的 pmr 版本：放进 std::pmr::vector 时 description 与容器使用同一个 memory_resource，
+    // 整个结果集可以从一块 arena 分配并一次释放
+    struct PmrBillRow {
+        using allocator_type = std::pmr::polymorphic_allocator<char>;
+
+        int id = 0;
+        int owner_id = 0;
+        int event_id = 0;
+        Money amount;
+        Timestamp created_at = 0;
+        std::pmr::string description;
+        bool has_annotation = false;
+
+        PmrBillRow() = default;
+        explicit PmrBillRow(const allocator_type& alloc) : description(alloc) {}
+        PmrBillRow(const PmrBillRow& other, const allocator_type& alloc)
+            : id(other.id), owner_id(other.owner_id), event_id(other.event_id), amount(other.amount),
+              created_at(other.created_at), description(other.description, alloc),
+              has_annotation(other.has_annotation) {}
+        PmrBillRow(PmrBillRow&& other, const allocator_type& alloc)
+            : id(other.id), owner_id(other.owner_id), event_id(other.event_id), amount(other.amount),
+              created_at(other.created_at), description(std::move(other.description), alloc),
+              has_annotation(other.has_annotation) {}
+        PmrBillRow(const PmrBillRow&) = default;
+        PmrBillRow(PmrBillRow&&) = default;
+        PmrBillRow& operator=(const PmrBillRow&) = default;
+        PmrBillRow& operator=(PmrBillRow&&) = default;
+    };
+
+    // Annotation 的 pmr 版本，不调用 Now()
+    struct PmrAnnotation {
+        using allocator_type = std::pmr::polymorphic_allocator<char>;
+
+        int id = 0;
+        int bill_id = 0;
+        std::pmr::string content;
+        int authorid = 0;
+        Timestamp created_at = 0;
+
+        PmrAnnotation() = default;
+        explicit PmrAnnotation(const allocator_type& alloc) : content(alloc) {}
+        PmrAnnotation(const PmrAnnotation& other, const allocator_type& alloc)
+            : id(other.id), bill_id(other.bill_id), content(other.content, alloc),
+              authorid(other.authorid), created_at(other.created_at) {}
+        PmrAnnotation(PmrAnnotation&& other, const allocator_type& alloc)
+            : id(other.id), bill_id(other.bill_id), content(std::move(other.content), alloc),
+              authorid(other.authorid), created_at(other.created_at) {}
+        PmrAnnotation(const PmrAnnotation&) = default;
+        PmrAnnotation(PmrAnnotation&&) = default;
+        PmrAnnotation& operator=(const PmrAnnotation&) = default;
+        PmrAnnotation& operator=(PmrAnnotation&&) = default;
+    };
+
+    // 键集分页游标：上一页最后一行的 (created_at, id)
+    struct BillCursor {
+        Timestamp created_at = 0;
+        int id = 0;
+    };
+
+    struct BillPage {
+        std::vector<BillRow> bills;
+        std::optional<BillCursor> next;  // 为空表示已是最后一页
+    };
+
+    // 全文搜索的一页结果，按相关度排序
+    struct SearchPage {
+        std::vector<BillRow> bills;
+        std::optional<int> next_offset;  // 为空表示已是最后一页
+    };
+
+    // 按 (owner, event, UTC 日) 增量维护的账单汇总
+    struct DailyRollup {
+        int owner_id = 0;
+        int event_id = 0;
+        Timestamp day = 0;     // 当天 00:00:00 UTC 的时间戳
+        int64_t count = 0;
+        Money sum;
+    };
+
+    // 汇总表与全量重算结果不一致的一行
+    struct RollupMismatch {
+        int owner_id = 0;
+        int event_id = 0;
+        Timestamp day = 0;
+        int64_t expected_count = 0;
+        int64_t actual_count = 0;
+        Money expected_sum;
+        Money actual_sum;
+    };
+
+    // 聚合统计结果
+    struct BillTotal {
+        int key = 0;           // event_id 或 owner_id
+        int64_t count = 0;
+        Money sum;
+    };
+
+    enum class Granularity { Day, Week, Month, Year };
+
+    struct PeriodTotal {
+        std::string period;    // 周期起始日期 YYYY-MM-DD（UTC），周以周一为起点
+        int64_t count = 0;
+        Money sum;
+    };
+
+    struct BillSummary {
+        int64_t count = 0;
+        Money sum;
+        Money min;
+        Money max;
+        Money avg;             // 四舍五入到分
+    };
 }
\ No newline at end of file
@@ -1,27 +1,45 @@
 #include "AnnotationRepositoryImpl.h"
+#include "Metrics.h"
+#include "BillSearchIndex.h"
 
 using namespace sqlite_orm;
 
-void AnnotationRepositoryImpl::save(const model::Annotation& a) {
+AnnotationRepositoryImpl::AnnotationRepositoryImpl(std::shared_ptr<DatabaseORM> db)
+    : db_(db),
+      by_bill_id_(std::make_unique<RawStatement>(db_->GetStorage(),
+          "SELECT id, bill_id, content, authorid, created_at FROM annotations "
+          "WHERE bill_id = ?1 ORDER BY created_at DESC")) {}
+
+int AnnotationRepositoryImpl::save(const model::Annotation& a) {
+    METRICS_SCOPE(timer, "AnnotationRepository.save");
     auto& storage = db_->GetStorage();
     
+    // 批注与其账单的索引行在同一事务内更新
+    auto guard = storage.transaction_guard();
+    int id = a.id;
     if (a.id == 0) {
-        storage.insert(a);
+        id = storage.insert(a);
     } else {
         storage.update(a);
     }
+    db_->GetSearchIndex().Refresh(a.bill_id);
+    guard.commit();
+    return id;
 }
 
 std::optional<model::Annotation> AnnotationRepositoryImpl::findById(int id) {
+    METRICS_SCOPE(timer, "AnnotationRepository.findById");
     auto& storage = db_->GetStorage();
     
     try {
         auto annotation = storage.get<model::Annotation>(id);
+        timer.Rows(1);
         return annotation;
     } catch (const std::system_error&) {
         // 记录未找到
         return std::nullopt;
     } catch (const std::exception& ex) {
+        timer.Fail();
         // 其他错误
         return std::nullopt;
     }
@@ -30,39 +48,69 @@ std::optional<model::Annotation> AnnotationRepositoryImpl::findById(int id) {
 // 额外的辅助方法实现
 
 std::vector<model::Annotation> AnnotationRepositoryImpl::findByBillId(int bill_id) {
+    METRICS_SCOPE(timer, "AnnotationRepository.findByBillId");
     auto& storage = db_->GetStorage();
     
     try {
-        return storage.get_all<model::Annotation>(
+        return timer.Counted(storage.get_all<model::Annotation>(
             where(c(&model::Annotation::bill_id) == bill_id),
             order_by(&model::Annotation::created_at). desc()
-        );
+        ));
     } catch (const std::exception& ex) {
+        timer.Fail();
         return {};
     }
 }
 
+std::pmr::vector<model::PmrAnnotation> AnnotationRepositoryImpl::findByBillId(int bill_id,
+                                                                             std::pmr::memory_resource* mr) {
+    METRICS_SCOPE(timer, "AnnotationRepository.findByBillId(pmr)");
+    std::pmr::vector<model::PmrAnnotation> annotations(mr);
+    auto* stmt = by_bill_id_->Get();
+
+    // 与 BillRepositoryImpl 的 pmr 重载一致，出错时异常直接抛给调用方
+    by_bill_id_->Bind({bill_id});
+    while (by_bill_id_->Step()) {
+        auto& a = annotations.emplace_back();
+        a.id = sqlite3_column_int(stmt, 0);
+        a.bill_id = sqlite3_column_int(stmt, 1);
+        a.content.assign(reinterpret_cast<const char*>(sqlite3_column_text(stmt, 2)),
+                         static_cast<size_t>(sqlite3_column_bytes(stmt, 2)));
+        a.authorid = sqlite3_column_int(stmt, 3);
+        a.created_at = sqlite3_column_int64(stmt, 4);
+    }
+    timer.Rows(annotations.size());
+    return annotations;
+}
+
 std::vector<model::Annotation> AnnotationRepositoryImpl::findByAuthorId(int author_id) {
+    METRICS_SCOPE(timer, "AnnotationRepository.findByAuthorId");
     auto& storage = db_->GetStorage();
     
     try {
-        return storage.get_all<model::Annotation>(
+        return timer.Counted(storage.get_all<model::Annotation>(
             where(c(&model::Annotation::authorid) == author_id),
             order_by(&model::Annotation::created_at).desc()
-        );
+        ));
     } catch (const std::exception& ex) {
+        timer.Fail();
         return {};
     }
 }
 
 void AnnotationRepositoryImpl::removeByBillId(int bill_id) {
+    METRICS_SCOPE(timer, "AnnotationRepository.removeByBillId");
     auto& storage = db_->GetStorage();
     
     try {
+        auto guard = storage.transaction_guard();
         storage.remove_all<model::Annotation>(
             where(c(&model::Annotation::bill_id) == bill_id)
         );
+        db_->GetSearchIndex().Refresh(bill_id);
+        guard.commit();
     } catch (const std::exception& ex) {
+        timer.Fail();
         // 忽略错误或记录日志
     }
 }
\ No newline at end of file
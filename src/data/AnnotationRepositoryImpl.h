@@ -3,18 +3,21 @@
 #include "DatabaseORM.h"
 #include <memory>
 
+// 非线程安全：pmr 重载复用同一条预编译语句（by_bill_id_），一个实例同一时间只能由一个线程使用
 class AnnotationRepositoryImpl : public repo::IAnnotationRepository {
 public:
-    explicit AnnotationRepositoryImpl(std::shared_ptr<DatabaseORM> db) : db_(db) {}
+    explicit AnnotationRepositoryImpl(std::shared_ptr<DatabaseORM> db);
     
-    void save(const model::Annotation& a) override;
+    int save(const model::Annotation& a) override;
     std::optional<model::Annotation> findById(int id) override;
     
     // 额外的辅助方法（可选）
     std::vector<model::Annotation> findByBillId(int bill_id);
+    std::pmr::vector<model::PmrAnnotation> findByBillId(int bill_id, std::pmr::memory_resource* mr); // 结果从 mr 分配，出错时抛出 std::runtime_error
     std::vector<model::Annotation> findByAuthorId(int author_id);
     void removeByBillId(int bill_id);
     
 private:
     std::shared_ptr<DatabaseORM> db_;
+    std::unique_ptr<RawStatement> by_bill_id_;
 };
\ No newline at end of file
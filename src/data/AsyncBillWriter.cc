@@ -0,0 +1,281 @@
+#include "AsyncBillWriter.h"
+
+#include <algorithm>
+#include <exception>
+#include <utility>
+
+namespace {
+
+repo::SaveResult SaveOne(repo::IBillRepository& inner, const model::Bill& b) {
+    repo::SaveResult result;
+    try {
+        result.id = inner.save(b);
+        result.durable = true;
+    } catch (const std::exception& e) {
+        result.error = e.what();
+    }
+    return result;
+}
+
+}
+
+AsyncBillWriter::AsyncBillWriter(std::shared_ptr<repo::IBillRepository> inner)
+    : AsyncBillWriter(std::move(inner), Options()) {}
+
+AsyncBillWriter::AsyncBillWriter(std::shared_ptr<repo::IBillRepository> inner, Options options)
+    : inner_(std::move(inner)), options_(options) {
+    options_.queue_capacity = std::max<size_t>(options_.queue_capacity, 1);
+    options_.max_batch_rows = std::max<size_t>(options_.max_batch_rows, 1);
+    worker_ = std::thread([this] { Run(); });
+}
+
+AsyncBillWriter::~AsyncBillWriter() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+    }
+    not_empty_.notify_all();
+    not_full_.notify_all();
+    worker_.join();
+}
+
+void AsyncBillWriter::saveAsync(const model::Bill& b, repo::SaveCallback done) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    not_full_.wait(lock, [this] { return queue_.size() < options_.queue_capacity || stopping_; });
+    if (stopping_) {
+        lock.unlock();
+        if (done) {
+            repo::SaveResult result;
+            result.error = "AsyncBillWriter is stopping";
+            done(result);
+        }
+        return;
+    }
+    queue_.push_back(Pending{b, std::move(done)});
+    ++enqueued_;
+    lock.unlock();
+    not_empty_.notify_one();
+}
+
+std::future<repo::SaveResult> AsyncBillWriter::submit(const model::Bill& b) {
+    auto promise = std::make_shared<std::promise<repo::SaveResult>>();
+    auto future = promise->get_future();
+    saveAsync(b, [promise](const repo::SaveResult& result) { promise->set_value(result); });
+    return future;
+}
+
+void AsyncBillWriter::flush() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    const uint64_t target = enqueued_;
+    if (completed_ >= target) {
+        return;
+    }
+    flush_target_ = std::max(flush_target_, target);
+    not_empty_.notify_one();
+    drained_.wait(lock, [this, target] { return completed_ >= target; });
+}
+
+AsyncBillWriter::Stats AsyncBillWriter::stats() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return stats_;
+}
+
+void AsyncBillWriter::Run() {
+    std::vector<Pending> group;
+    group.reserve(options_.max_batch_rows);
+
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (true) {
+        not_empty_.wait(lock, [this] { return !queue_.empty() || stopping_; });
+        if (queue_.empty()) {
+            break; // stopping_ 且队列已清空
+        }
+
+        // 第一条到达后最多再等 max_delay 攒批；攒满、flush 或析构时提前提交
+        auto deadline = std::chrono::steady_clock::now() + options_.max_delay;
+        not_empty_.wait_until(lock, deadline, [this] {
+            return queue_.size() >= options_.max_batch_rows || stopping_ || flush_target_ > completed_;
+        });
+
+        const size_t n = std::min(queue_.size(), options_.max_batch_rows);
+        group.clear();
+        for (size_t i = 0; i < n; ++i) {
+            group.push_back(std::move(queue_.front()));
+            queue_.pop_front();
+        }
+        lock.unlock();
+        not_full_.notify_all();
+
+        Commit(group);
+
+        lock.lock();
+        completed_ += n;
+        drained_.notify_all();
+    }
+}
+
+void AsyncBillWriter::Commit(std::vector<Pending>& group) {
+    std::vector<repo::SaveResult> results(group.size());
+    int64_t commits = 0;
+    {
+        std::lock_guard<std::mutex> lock(db_mutex_);
+
+        // 新账单整组走 saveBatch，一个事务一次提交；更新逐条 save
+        std::vector<model::Bill> inserts;
+        std::vector<size_t> insert_index;
+        for (size_t i = 0; i < group.size(); ++i) {
+            if (group[i].bill.id == 0) {
+                inserts.push_back(group[i].bill);
+                insert_index.push_back(i);
+            }
+        }
+
+        if (!inserts.empty()) {
+            try {
+                auto ids = inner_->saveBatch(inserts);
+                for (size_t k = 0; k < insert_index.size(); ++k) {
+                    results[insert_index[k]].id = ids[k];
+                    results[insert_index[k]].durable = true;
+                }
+                ++commits;
+            } catch (const std::exception&) {
+                // 整组已回滚，逐条重试，只让出错的那几条失败
+                for (size_t k = 0; k < insert_index.size(); ++k) {
+                    results[insert_index[k]] = SaveOne(*inner_, inserts[k]);
+                    ++commits;
+                }
+            }
+        }
+
+        for (size_t i = 0; i < group.size(); ++i) {
+            if (group[i].bill.id != 0) {
+                results[i] = SaveOne(*inner_, group[i].bill);
+                ++commits;
+            }
+        }
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stats_.rows += static_cast<int64_t>(group.size());
+        stats_.commits += commits;
+        for (const auto& r : results) {
+            if (!r.durable) {
+                ++stats_.failures;
+            }
+        }
+    }
+
+    for (size_t i = 0; i < group.size(); ++i) {
+        if (group[i].done) {
+            group[i].done(results[i]);
+        }
+    }
+}
+
+int AsyncBillWriter::save(const model::Bill& b) {
+    return Forward([&](repo::IBillRepository& r) { return r.save(b); });
+}
+
+std::vector<int> AsyncBillWriter::saveBatch(const std::vector<model::Bill>& bills) {
+    return Forward([&](repo::IBillRepository& r) { return r.saveBatch(bills); });
+}
+
+std::optional<model::Bill> AsyncBillWriter::findById(int id) {
+    return Forward([&](repo::IBillRepository& r) { return r.findById(id); });
+}
+
+std::vector<model::BillRow> AsyncBillWriter::queryByEvent(int ownerId, int eventId) {
+    return Forward([&](repo::IBillRepository& r) { return r.queryByEvent(ownerId, eventId); });
+}
+
+std::vector<model::BillRow> AsyncBillWriter::queryByEvent(const std::string& name) {
+    return Forward([&](repo::IBillRepository& r) { return r.queryByEvent(name); });
+}
+
+std::vector<model::BillRow> AsyncBillWriter::queryByTime(int ownerId, model::Timestamp from, model::Timestamp to) {
+    return Forward([&](repo::IBillRepository& r) { return r.queryByTime(ownerId, from, to); });
+}
+
+std::vector<model::BillRow> AsyncBillWriter::queryByTime(model::Timestamp from, model::Timestamp to) {
+    return Forward([&](repo::IBillRepository& r) { return r.queryByTime(from, to); });
+}
+
+model::BillPage AsyncBillWriter::queryByTimePage(model::Timestamp from, model::Timestamp to,
+                                                 const std::optional<model::BillCursor>& after, int page_size) {
+    return Forward([&](repo::IBillRepository& r) { return r.queryByTimePage(from, to, after, page_size); });
+}
+
+std::vector<model::BillRow> AsyncBillWriter::queryByPhone(const std::string& phone) {
+    return Forward([&](repo::IBillRepository& r) { return r.queryByPhone(phone); });
+}
+
+std::vector<model::BillRow> AsyncBillWriter::queryByTimeInOrder(model::Timestamp from, model::Timestamp to) {
+    return Forward([&](repo::IBillRepository& r) { return r.queryByTimeInOrder(from, to); });
+}
+
+std::vector<model::BillRow> AsyncBillWriter::queryByTimeAndEventInOrder(model::Timestamp from, model::Timestamp to) {
+    return Forward([&](repo::IBillRepository& r) { return r.queryByTimeAndEventInOrder(from, to); });
+}
+
+std::pmr::vector<model::PmrBillRow> AsyncBillWriter::queryByTime(int ownerId, model::Timestamp from, model::Timestamp to,
+                                                                 std::pmr::memory_resource* mr) {
+    return Forward([&](repo::IBillRepository& r) { return r.queryByTime(ownerId, from, to, mr); });
+}
+
+std::pmr::vector<model::PmrBillRow> AsyncBillWriter::queryByTime(model::Timestamp from, model::Timestamp to,
+                                                                 std::pmr::memory_resource* mr) {
+    return Forward([&](repo::IBillRepository& r) { return r.queryByTime(from, to, mr); });
+}
+
+std::pmr::vector<model::PmrBillRow> AsyncBillWriter::queryByTimeInOrder(model::Timestamp from, model::Timestamp to,
+                                                                        std::pmr::memory_resource* mr) {
+    return Forward([&](repo::IBillRepository& r) { return r.queryByTimeInOrder(from, to, mr); });
+}
+
+std::pmr::vector<model::PmrBillRow> AsyncBillWriter::queryByTimeAndEventInOrder(model::Timestamp from, model::Timestamp to,
+                                                                                std::pmr::memory_resource* mr) {
+    return Forward([&](repo::IBillRepository& r) { return r.queryByTimeAndEventInOrder(from, to, mr); });
+}
+
+std::vector<model::BillTotal> AsyncBillWriter::totalsByEvent(model::Timestamp from, model::Timestamp to) {
+    return Forward([&](repo::IBillRepository& r) { return r.totalsByEvent(from, to); });
+}
+
+std::vector<model::BillTotal> AsyncBillWriter::totalsByOwner(model::Timestamp from, model::Timestamp to) {
+    return Forward([&](repo::IBillRepository& r) { return r.totalsByOwner(from, to); });
+}
+
+std::vector<model::PeriodTotal> AsyncBillWriter::totalsByPeriod(model::Timestamp from, model::Timestamp to,
+                                                                model::Granularity granularity) {
+    return Forward([&](repo::IBillRepository& r) { return r.totalsByPeriod(from, to, granularity); });
+}
+
+model::BillSummary AsyncBillWriter::summary(model::Timestamp from, model::Timestamp to) {
+    return Forward([&](repo::IBillRepository& r) { return r.summary(from, to); });
+}
+
+void AsyncBillWriter::rebuildRollups() {
+    Forward([&](repo::IBillRepository& r) { r.rebuildRollups(); });
+}
+
+std::vector<model::RollupMismatch> AsyncBillWriter::checkRollups() {
+    return Forward([&](repo::IBillRepository& r) { return r.checkRollups(); });
+}
+
+void AsyncBillWriter::forEachByTime(model::Timestamp from, model::Timestamp to, const repo::BillVisitor& visit) {
+    Forward([&](repo::IBillRepository& r) { r.forEachByTime(from, to, visit); });
+}
+
+void AsyncBillWriter::forEachByTimeInOrder(model::Timestamp from, model::Timestamp to, const repo::BillVisitor& visit) {
+    Forward([&](repo::IBillRepository& r) { r.forEachByTimeInOrder(from, to, visit); });
+}
+
+void AsyncBillWriter::forEachByTimeAndEventInOrder(model::Timestamp from, model::Timestamp to,
+                                                   const repo::BillVisitor& visit) {
+    Forward([&](repo::IBillRepository& r) { r.forEachByTimeAndEventInOrder(from, to, visit); });
+}
+
+void AsyncBillWriter::remove(int id) {
+    Forward([&](repo::IBillRepository& r) { r.remove(id); });
+}
@@ -0,0 +1,117 @@
+#pragma once
+#include <irepositories.h>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <future>
+#include <mutex>
+#include <thread>
+
+// 写后异步提交的账单仓库装饰器：saveAsync 把写入放进有界队列立即返回，
+// 由专用线程攒够 max_batch_rows 行或等待 max_delay 后整组写入一个事务。
+// 其余接口先 flush 再转发给内层仓库，保证读到自己刚提交的写入。
+class AsyncBillWriter : public repo::IBillRepository {
+public:
+    struct Options {
+        size_t queue_capacity = 4096;                 // 队列满时 saveAsync 阻塞
+        size_t max_batch_rows = 256;
+        std::chrono::milliseconds max_delay{50};
+    };
+
+    struct Stats {
+        int64_t rows = 0;      // 已处理的写入数（含失败）
+        int64_t commits = 0;   // 已执行的写事务数
+        int64_t failures = 0;
+    };
+
+    explicit AsyncBillWriter(std::shared_ptr<repo::IBillRepository> inner);
+    AsyncBillWriter(std::shared_ptr<repo::IBillRepository> inner, Options options);
+    ~AsyncBillWriter() override; // 写完队列中剩余的账单后退出
+
+    AsyncBillWriter(const AsyncBillWriter&) = delete;
+    AsyncBillWriter& operator=(const AsyncBillWriter&) = delete;
+
+    // 回调在写线程上执行，不要在回调里调用本对象的同步接口
+    void saveAsync(const model::Bill& b, repo::SaveCallback done) override;
+    std::future<repo::SaveResult> submit(const model::Bill& b);
+
+    // 立即提交队列中已有的写入并等待完成
+    void flush();
+    Stats stats() const;
+
+    int save(const model::Bill& b) override;
+    std::vector<int> saveBatch(const std::vector<model::Bill>& bills) override;
+
+    std::optional<model::Bill> findById(int id) override;
+
+    std::vector<model::BillRow> queryByEvent(int ownerId, int eventId) override;
+    std::vector<model::BillRow> queryByEvent(const std::string& name) override; // 仅管理员可用
+
+    std::vector<model::BillRow> queryByTime(int ownerId, model::Timestamp from, model::Timestamp to) override;
+    std::vector<model::BillRow> queryByTime(model::Timestamp from, model::Timestamp to) override; // 仅管理员可用
+    model::BillPage queryByTimePage(model::Timestamp from, model::Timestamp to,
+                                    const std::optional<model::BillCursor>& after, int page_size) override; // 仅管理员可用
+
+    std::vector<model::BillRow> queryByPhone(const std::string& phone) override; // 仅管理员可用
+
+    std::vector<model::BillRow> queryByTimeInOrder(model::Timestamp from, model::Timestamp to) override; // 仅管理员可用
+    std::vector<model::BillRow> queryByTimeAndEventInOrder(model::Timestamp from, model::Timestamp to) override; // 仅管理员可用
+
+    std::pmr::vector<model::PmrBillRow> queryByTime(int ownerId, model::Timestamp from, model::Timestamp to,
+                                                    std::pmr::memory_resource* mr) override;
+    std::pmr::vector<model::PmrBillRow> queryByTime(model::Timestamp from, model::Timestamp to,
+                                                    std::pmr::memory_resource* mr) override; // 仅管理员可用
+    std::pmr::vector<model::PmrBillRow> queryByTimeInOrder(model::Timestamp from, model::Timestamp to,
+                                                           std::pmr::memory_resource* mr) override; // 仅管理员可用
+    std::pmr::vector<model::PmrBillRow> queryByTimeAndEventInOrder(model::Timestamp from, model::Timestamp to,
+                                                                   std::pmr::memory_resource* mr) override; // 仅管理员可用
+
+    std::vector<model::BillTotal> totalsByEvent(model::Timestamp from, model::Timestamp to) override; // 仅管理员可用
+    std::vector<model::BillTotal> totalsByOwner(model::Timestamp from, model::Timestamp to) override; // 仅管理员可用
+    std::vector<model::PeriodTotal> totalsByPeriod(model::Timestamp from, model::Timestamp to, model::Granularity granularity) override; // 仅管理员可用
+    model::BillSummary summary(model::Timestamp from, model::Timestamp to) override; // 仅管理员可用
+
+    void rebuildRollups() override; // 仅管理员可用
+    std::vector<model::RollupMismatch> checkRollups() override; // 仅管理员可用
+
+    void forEachByTime(model::Timestamp from, model::Timestamp to, const repo::BillVisitor& visit) override; // 仅管理员可用
+    void forEachByTimeInOrder(model::Timestamp from, model::Timestamp to, const repo::BillVisitor& visit) override; // 仅管理员可用
+    void forEachByTimeAndEventInOrder(model::Timestamp from, model::Timestamp to, const repo::BillVisitor& visit) override; // 仅管理员可用
+
+    void remove(int id) override;
+private:
+    struct Pending {
+        model::Bill bill;
+        repo::SaveCallback done;
+    };
+
+    void Run();
+    void Commit(std::vector<Pending>& group);
+
+    // flush 后持有 db_mutex_ 调用内层仓库
+    template<class F>
+    auto Forward(F&& f) {
+        flush();
+        std::lock_guard<std::mutex> lock(db_mutex_);
+        return f(*inner_);
+    }
+
+    std::shared_ptr<repo::IBillRepository> inner_;
+    Options options_;
+
+    mutable std::mutex mutex_;
+    std::condition_variable not_empty_;
+    std::condition_variable not_full_;
+    std::condition_variable drained_;
+    std::deque<Pending> queue_;
+    uint64_t enqueued_ = 0;   // 累计入队数
+    uint64_t completed_ = 0;  // 累计完成数
+    uint64_t flush_target_ = 0;
+    bool stopping_ = false;
+    Stats stats_;
+
+    // 内层仓库共用一条连接，写线程与调用线程对它的访问在此串行化
+    std::mutex db_mutex_;
+    std::thread worker_;
+};
@@ -1,105 +1,476 @@
 #include "BillRepositoryImpl.h"
+#include "Metrics.h"
 #include "irepositories.h"
+#include "EventCatalog.h"
+#include "BillSearchIndex.h"
 
-#include <algorithm>
+#include <limits>
+#include <map>
+#include <tuple>
+#include <utility>
 
 using namespace orm;
 
-void BillRepositoryImpl::save(const model::Bill& b) {
+namespace {
+
+// 列表查询的投影列，顺序与 model::BillRow 对应
+auto BillRowColumns() {
+    return columns(&model::Bill::id,
+                   &model::Bill::owner_id,
+                   &model::Bill::event_id,
+                   &model::Bill::amount,
+                   &model::Bill::created_at,
+                   &model::Bill::description,
+                   &model::Bill::has_annotation);
+}
+
+template<class Rows>
+std::vector<model::BillRow> ToBillRows(Rows& rows) {
+    std::vector<model::BillRow> result(rows.size());
+    for (size_t i = 0; i < rows.size(); ++i) {
+        auto& row = rows[i];
+        auto& r = result[i];
+        r.id = std::get<0>(row);
+        r.owner_id = std::get<1>(row);
+        r.event_id = std::get<2>(row);
+        r.amount = std::get<3>(row);
+        r.created_at = std::get<4>(row);
+        r.description = std::move(std::get<5>(row));
+        r.has_annotation = std::get<6>(row);
+    }
+    return result;
+}
+
+// 单表 SELECT，不 JOIN events，直接走 bills 上的索引
+template<class... Conditions>
+std::vector<model::BillRow> SelectBillRows(Storage& storage, Conditions&&... conditions) {
+    auto rows = storage.select(BillRowColumns(), std::forward<Conditions>(conditions)...);
+    return ToBillRows(rows);
+}
+
+// findById：账单列 + 事件列，LEFT JOIN 一次性取回 Bill::event
+auto BillWithEventColumns() {
+    return columns(&model::Bill::id,
+                   &model::Bill::owner_id,
+                   &model::Bill::event_id,
+                   &model::Bill::description,
+                   &model::Bill::amount,
+                   &model::Bill::created_at,
+                   &model::Bill::has_annotation,
+                   &model::Event::id,
+                   &model::Event::name,
+                   &model::Event::status,
+                   &model::Event::created_at);
+}
+
+template<class Row>
+void FillBill(model::Bill& b, Row& row) {
+    b.id = std::get<0>(row);
+    b.owner_id = std::get<1>(row);
+    b.event_id = std::get<2>(row);
+    b.description = std::move(std::get<3>(row));
+    b.amount = std::get<4>(row);
+    b.created_at = std::get<5>(row);
+    b.has_annotation = std::get<6>(row);
+    b.event.id = std::get<7>(row);
+    b.event.name = std::move(std::get<8>(row));
+    b.event.status = std::get<9>(row);
+    b.event.created_at = std::get<10>(row);
+}
+
+// INTEGER 列上的 SUM 是精确整数求和；CAST 后按 Money 取回，空集合为 NULL 即 0
+template<class Column>
+auto SumMoney(Column column) {
+    return cast<model::Money>(sum(column));
+}
+
+// 按手机号查账单：JOIN users 一步完成
+auto PrepareByPhone(Storage& storage) {
+    return storage.prepare(select(
+        BillRowColumns(),
+        inner_join<model::User>(on(c(&model::Bill::owner_id) == &model::User::id)),
+        where(c(&model::User::phone) == std::string())
+    ));
+}
+
+// pmr 查询直接 step 语句，把列写进调用方的 memory_resource，
+// 不经过 sqlite_orm 的 tuple 和临时 std::string。列顺序与 BillRowColumns() 一致。
+const std::string kSelectBillRowsSql =
+    "SELECT id, owner_id, event_id, amount, created_at, description, has_annotation FROM bills ";
+
+// 按时间范围取行，pmr 查询与 forEach 遍历共用
+const std::string kRowsByTimeSql = kSelectBillRowsSql + "WHERE created_at >= ?1 AND created_at <= ?2";
+const std::string kRowsByTimeOrderedSql = kRowsByTimeSql + " ORDER BY created_at";
+const std::string kRowsByTimeEventOrderedSql = kRowsByTimeSql + " ORDER BY created_at, event_id";
+
+// 把当前行写入 r（BillRow 或 PmrBillRow）
+template<class Row>
+void ReadBillRow(sqlite3_stmt* stmt, Row& r) {
+    r.id = sqlite3_column_int(stmt, 0);
+    r.owner_id = sqlite3_column_int(stmt, 1);
+    r.event_id = sqlite3_column_int(stmt, 2);
+    r.amount = model::Money(sqlite3_column_int64(stmt, 3));
+    r.created_at = sqlite3_column_int64(stmt, 4);
+    r.description.assign(reinterpret_cast<const char*>(sqlite3_column_text(stmt, 5)),
+                         static_cast<size_t>(sqlite3_column_bytes(stmt, 5)));
+    r.has_annotation = sqlite3_column_int(stmt, 6) != 0;
+}
+
+std::pmr::vector<model::PmrBillRow> ReadBillRows(RawStatement& statement, std::pmr::memory_resource* mr) {
+    std::pmr::vector<model::PmrBillRow> rows(mr);
+    while (statement.Step()) {
+        ReadBillRow(statement.Get(), rows.emplace_back());
+    }
+    return rows;
+}
+
+std::vector<model::BillRow> ReadBillRows(RawStatement& statement) {
+    std::vector<model::BillRow> rows;
+    while (statement.Step()) {
+        ReadBillRow(statement.Get(), rows.emplace_back());
+    }
+    return rows;
+}
+
+// 逐行读进同一个 BillRow 再回调，description 的缓冲区在行间复用；返回回调次数
+uint64_t VisitBillRows(RawStatement& statement, const repo::BillVisitor& visit) {
+    model::BillRow row;
+    uint64_t visited = 0;
+    while (statement.Step()) {
+        ReadBillRow(statement.Get(), row);
+        visit(row);
+        ++visited;
+    }
+    return visited;
+}
+
+constexpr model::Timestamp kSecondsPerDay = 86400;
+
+constexpr model::Timestamp kMinTimestamp = std::numeric_limits<model::Timestamp>::min();
+constexpr model::Timestamp kMaxTimestamp = std::numeric_limits<model::Timestamp>::max();
+
+// 所在 UTC 日 00:00:00 的时间戳；INT64_MIN 附近不足一天的部分饱和到 INT64_MIN
+model::Timestamp DayStart(model::Timestamp ts) {
+    model::Timestamp offset = ((ts % kSecondsPerDay) + kSecondsPerDay) % kSecondsPerDay;
+    return ts < kMinTimestamp + offset ? kMinTimestamp : ts - offset;
+}
+
+// 按粒度生成 date(column, 'unixepoch', ...) 周期表达式交给 f
+template<class Column, class F>
+void WithPeriod(Column column, model::Granularity granularity, F&& f) {
+    switch (granularity) {
+        case model::Granularity::Day:
+            f(date(column, "unixepoch"));
+            break;
+        case model::Granularity::Week:
+            // 回退 6 天后取下一个周一，即本周周一
+            f(date(column, "unixepoch", "-6 days", "weekday 1"));
+            break;
+        case model::Granularity::Month:
+            f(date(column, "unixepoch", "start of month"));
+            break;
+        case model::Granularity::Year:
+            f(date(column, "unixepoch", "start of year"));
+            break;
+    }
+}
+
+using PeriodTotals = std::map<std::string, model::PeriodTotal>;
+
+// GROUP BY 周期表达式，结果按周期累加进 merged
+template<class Period, class Count, class Sum, class Condition>
+void AccumulatePeriodTotals(Storage& storage, Period period, Count count_expr, Sum sum_expr,
+                            Condition condition, PeriodTotals& merged) {
+    auto rows = storage.select(
+        columns(period, count_expr, sum_expr),
+        where(condition),
+        group_by(period)
+    );
+    for (auto& row : rows) {
+        auto& t = merged[std::get<0>(row)];
+        t.period = std::get<0>(row);
+        t.count += static_cast<int64_t>(std::get<1>(row));
+        t.sum += std::get<2>(row);
+    }
+}
+
+using RollupKey = std::tuple<int, int, model::Timestamp>;   // owner_id, event_id, day
+using RollupDeltas = std::map<RollupKey, std::pair<int64_t, model::Money>>;
+
+void AddRollupDelta(RollupDeltas& deltas, const model::Bill& b, int sign) {
+    auto& d = deltas[RollupKey{b.owner_id, b.event_id, DayStart(b.created_at)}];
+    d.first += sign;
+    d.second += b.amount * sign;
+}
+
+// 把增量写入 bill_rollup_daily，需在调用方的事务内执行
+void ApplyRollupDeltas(Storage& storage, const RollupDeltas& deltas) {
+    for (const auto& [key, delta] : deltas) {
+        if (delta.first == 0 && delta.second == model::Money()) {
+            continue;
+        }
+        const auto& [owner_id, event_id, day] = key;
+        auto existing = storage.get_optional<model::DailyRollup>(owner_id, event_id, day);
+
+        model::DailyRollup r;
+        if (existing.has_value()) {
+            r = *existing;
+        } else {
+            r.owner_id = owner_id;
+            r.event_id = event_id;
+            r.day = day;
+        }
+        r.count += delta.first;
+        r.sum += delta.second;
+
+        if (r.count <= 0) {
+            if (existing.has_value()) {
+                storage.remove<model::DailyRollup>(owner_id, event_id, day);
+            }
+        } else {
+            storage.replace(r);
+        }
+    }
+}
+
+// 从 bills 全量重算每日汇总
+std::vector<model::DailyRollup> ComputeRollups(Storage& storage) {
+    auto day = date(&model::Bill::created_at, "unixepoch");
+    auto rows = storage.select(
+        columns(&model::Bill::owner_id,
+                &model::Bill::event_id,
+                min(&model::Bill::created_at),
+                count(&model::Bill::id),
+                SumMoney(&model::Bill::amount)),
+        group_by(&model::Bill::owner_id, &model::Bill::event_id, day)
+    );
+
+    std::vector<model::DailyRollup> rollups(rows.size());
+    for (size_t i = 0; i < rows.size(); ++i) {
+        rollups[i].owner_id = std::get<0>(rows[i]);
+        rollups[i].event_id = std::get<1>(rows[i]);
+        rollups[i].day = DayStart(*std::get<2>(rows[i]));
+        rollups[i].count = std::get<3>(rows[i]);
+        rollups[i].sum = std::get<4>(rows[i]);
+    }
+    return rollups;
+}
+
+template<class Rows>
+std::vector<model::BillTotal> ToBillTotals(Rows& rows) {
+    std::vector<model::BillTotal> totals(rows.size());
+    for (size_t i = 0; i < rows.size(); ++i) {
+        totals[i].key = std::get<0>(rows[i]);
+        totals[i].count = std::get<1>(rows[i]);
+        totals[i].sum = std::get<2>(rows[i]);
+    }
+    return totals;
+}
+
+}
+
+// 管理员查询用的预编译语句，构造仓库时准备一次，之后只重新绑定参数
+struct BillRepositoryImpl::PreparedStatements {
+    explicit PreparedStatements(Storage& storage)
+        : by_phone(PrepareByPhone(storage)),
+          rows_by_owner_time(storage, kSelectBillRowsSql +
+              "WHERE owner_id = ?1 AND created_at >= ?2 AND created_at <= ?3"),
+          rows_by_time(storage, kRowsByTimeSql),
+          rows_by_time_ordered(storage, kRowsByTimeOrderedSql),
+          rows_by_time_event_ordered(storage, kRowsByTimeEventOrderedSql),
+          // 行值比较让 idx_bills_created_id 直接从游标位置 seek
+          page_by_time(storage, kSelectBillRowsSql +
+              "WHERE created_at >= ?1 AND created_at <= ?2 AND (created_at, id) > (?3, ?4) "
+              "ORDER BY created_at, id LIMIT ?5") {}
+
+    decltype(PrepareByPhone(std::declval<Storage&>())) by_phone;
+
+    // pmr 重载
+    RawStatement rows_by_owner_time;
+    RawStatement rows_by_time;
+    RawStatement rows_by_time_ordered;
+    RawStatement rows_by_time_event_ordered;
+
+    // queryByTimePage（sqlite_orm 无法表达行值比较）
+    RawStatement page_by_time;
+};
+
+BillRepositoryImpl::BillRepositoryImpl(std::shared_ptr<DatabaseORM> db)
+    : db_(db), statements_(std::make_unique<PreparedStatements>(db_->GetStorage())) {}
+
+BillRepositoryImpl::~BillRepositoryImpl() = default;
+
+int BillRepositoryImpl::save(const model::Bill& b) {
+    METRICS_SCOPE(timer, "BillRepository.save");
     auto& storage = db_->GetStorage();
+    RollupDeltas deltas;
+    int id = b.id;
     
+    auto guard = storage.transaction_guard();
     if (b.id == 0) {
-        storage.insert(b);
+        id = storage.insert(b);
     } else {
+        auto old = storage.get_optional<model::Bill>(b.id);
+        if (!old.has_value()) {
+            return b.id;
+        }
         storage.update(b);
+        AddRollupDelta(deltas, *old, -1);
     }
+    AddRollupDelta(deltas, b, +1);
+    ApplyRollupDeltas(storage, deltas);
+    db_->GetSearchIndex().Refresh(id);
+    guard.commit();
+
+    return id;
+}
+
+std::vector<int> BillRepositoryImpl::saveBatch(const std::vector<model::Bill>& bills) {
+    METRICS_SCOPE(timer, "BillRepository.saveBatch");
+    auto& storage = db_->GetStorage();
+    std::vector<int> ids;
+    if (bills.empty()) {
+        return ids;
+    }
+    ids.reserve(bills.size());
+
+    // 整批共用一个事务和一条预编译 INSERT，出错时 guard 析构自动回滚
+    auto guard = storage.transaction_guard();
+    auto statement = storage.prepare(insert(bills.front()));
+    RollupDeltas deltas;
+    auto& search_index = db_->GetSearchIndex();
+    for (const auto& b : bills) {
+        get<0>(statement) = b;
+        ids.push_back(static_cast<int>(storage.execute(statement)));
+        AddRollupDelta(deltas, b, +1);
+        search_index.Refresh(ids.back());
+    }
+    ApplyRollupDeltas(storage, deltas);
+    guard.commit();
+
+    timer.Rows(ids.size());
+    return ids;
 }
 
 std::optional<model::Bill> BillRepositoryImpl::findById(int id) {
+    METRICS_SCOPE(timer, "BillRepository.findById");
     auto& storage = db_->GetStorage();
 
-    auto bill = storage.get_optional<model::Bill>(id);
-    if (bill.has_value()) {
-        auto e = storage.get_optional<model::Event>(bill->event_id);
-        if (e.has_value()) {
-            bill->event = *e;
-        }
+    auto rows = storage.select(
+        BillWithEventColumns(),
+        left_join<model::Event>(on(c(&model::Bill::event_id) == &model::Event::id)),
+        where(c(&model::Bill::id) == id)
+    );
+    if (rows.empty()) {
+        return std::nullopt;
     }
+    model::Bill bill;
+    FillBill(bill, rows[0]);
+    timer.Rows(1);
     return bill;
-
 }
 
-std::vector<model::Bill> BillRepositoryImpl::queryByEvent(int ownerId, int eventId) {
+std::vector<model::BillRow> BillRepositoryImpl::queryByEvent(int ownerId, int eventId) {
+    METRICS_SCOPE(timer, "BillRepository.queryByEvent(owner)");
     auto& storage = db_->GetStorage();
     
-    return storage.get_all<model::Bill>(
+    return timer.Counted(SelectBillRows(storage,
         where(c(&model::Bill::owner_id) == ownerId && c(&model::Bill::event_id) == eventId)
-    );
+    ));
 }
 
-std::vector<model::Bill> BillRepositoryImpl::queryByEvent(const std::string& name) {
+std::vector<model::BillRow> BillRepositoryImpl::queryByEvent(const std::string& name) {
+    METRICS_SCOPE(timer, "BillRepository.queryByEvent(name)");
     auto& storage = db_->GetStorage();
-    
-    // 先查找事件
-    auto events = storage.get_all<model::Event>(
-        where(c(&model::Event::name) == name)
-    );
-    
-    if (events.empty()) {
+
+    // 事件名在内存字典中解析为 id，不再 JOIN events
+    auto event_id = db_->GetEventCatalog().IdOf(name);
+    if (!event_id.has_value()) {
         return {};
     }
-    
-    int event_id = events[0].id;
-    
-    return storage.get_all<model::Bill>(
-        where(c(&model::Bill::event_id) == event_id)
-    );
+    return timer.Counted(SelectBillRows(storage, where(c(&model::Bill::event_id) == *event_id)));
 }
 
-std::vector<model::Bill> BillRepositoryImpl::queryByTime(int ownerId, 
+std::vector<model::BillRow> BillRepositoryImpl::queryByTime(int ownerId, 
                                                           model::Timestamp from, 
                                                           model::Timestamp to) {
+    METRICS_SCOPE(timer, "BillRepository.queryByTime(owner)");
     auto& storage = db_->GetStorage();
     
-    return storage.get_all<model::Bill>(
+    return timer.Counted(SelectBillRows(storage,
         where(
             c(&model::Bill::owner_id) == ownerId &&
             c(&model::Bill::created_at) >= from &&
             c(&model::Bill::created_at) <= to
         )
-    );
+    ));
 }
 
-std::vector<model::Bill> BillRepositoryImpl::queryByTime(model::Timestamp from, 
+std::vector<model::BillRow> BillRepositoryImpl::queryByTime(model::Timestamp from, 
                                                           model::Timestamp to) {
+    METRICS_SCOPE(timer, "BillRepository.queryByTime");
     auto& storage = db_->GetStorage();
     
-    return storage.get_all<model::Bill>(
+    return timer.Counted(SelectBillRows(storage,
         where(
             c(&model::Bill::created_at) >= from &&
             c(&model::Bill::created_at) <= to
         )
-    );
+    ));
+}
+
+model::BillPage BillRepositoryImpl::queryByTimePage(model::Timestamp from,
+                                                    model::Timestamp to,
+                                                    const std::optional<model::BillCursor>& after,
+                                                    int page_size) {
+    METRICS_SCOPE(timer, "BillRepository.queryByTimePage");
+    model::BillPage page;
+    if (page_size <= 0) {
+        return page;
+    }
+
+    // 游标之后、[from, to] 之内的行。没有游标时取 (from, INT64_MIN)，范围内的任何行都排在它之后；
+    // 游标早于 from 时同样从 from 开始，晚于 to 时返回空页
+    model::Timestamp after_created_at = from;
+    int64_t after_id = std::numeric_limits<int64_t>::min();
+    if (after.has_value()) {
+        after_created_at = after->created_at;
+        after_id = after->id;
+    }
+
+    // 多取一行用于判断是否还有下一页
+    statements_->page_by_time.Bind({from, to, after_created_at, after_id, static_cast<int64_t>(page_size) + 1});
+    page.bills = ReadBillRows(statements_->page_by_time);
+
+    if (page.bills.size() > static_cast<size_t>(page_size)) {
+        page.bills.pop_back();
+        const auto& last = page.bills.back();
+        page.next = model::BillCursor{last.created_at, last.id};
+    }
+    timer.Rows(page.bills.size());
+    return page;
 }
 
-std::vector<model::Bill> BillRepositoryImpl::queryByTimeInOrder(model::Timestamp from, 
+std::vector<model::BillRow> BillRepositoryImpl::queryByTimeInOrder(model::Timestamp from, 
                                                                  model::Timestamp to) {
+    METRICS_SCOPE(timer, "BillRepository.queryByTimeInOrder");
     auto& storage = db_->GetStorage();
     
-    return storage.get_all<model::Bill>(
+    return timer.Counted(SelectBillRows(storage,
         where(
             c(&model::Bill::created_at) >= from &&
             c(&model::Bill::created_at) <= to
         ),
         order_by(&model::Bill::created_at).asc()
-    );
+    ));
 }
 
-std::vector<model::Bill> BillRepositoryImpl::queryByTimeAndEventInOrder(model::Timestamp from, 
+std::vector<model::BillRow> BillRepositoryImpl::queryByTimeAndEventInOrder(model::Timestamp from, 
                                                                          model::Timestamp to) {
+    METRICS_SCOPE(timer, "BillRepository.queryByTimeAndEventInOrder");
     auto& storage = db_->GetStorage();
     
-    return storage.get_all<model::Bill>(
+    return timer.Counted(SelectBillRows(storage,
         where(
             c(&model::Bill::created_at) >= from &&
             c(&model::Bill::created_at) <= to
@@ -108,34 +479,256 @@ std::vector<model::Bill> BillRepositoryImpl::queryByTimeAndEventInOrder(model::T
             order_by(&model::Bill::created_at).asc(),
             order_by(&model::Bill::event_id).asc()
         )
+    ));
+}
+
+std::pmr::vector<model::PmrBillRow> BillRepositoryImpl::queryByTime(int ownerId,
+                                                                     model::Timestamp from,
+                                                                     model::Timestamp to,
+                                                                     std::pmr::memory_resource* mr) {
+    METRICS_SCOPE(timer, "BillRepository.queryByTime(owner,pmr)");
+    statements_->rows_by_owner_time.Bind({ownerId, from, to});
+    return timer.Counted(ReadBillRows(statements_->rows_by_owner_time, mr));
+}
+
+std::pmr::vector<model::PmrBillRow> BillRepositoryImpl::queryByTime(model::Timestamp from,
+                                                                     model::Timestamp to,
+                                                                     std::pmr::memory_resource* mr) {
+    METRICS_SCOPE(timer, "BillRepository.queryByTime(pmr)");
+    statements_->rows_by_time.Bind({from, to});
+    return timer.Counted(ReadBillRows(statements_->rows_by_time, mr));
+}
+
+std::pmr::vector<model::PmrBillRow> BillRepositoryImpl::queryByTimeInOrder(model::Timestamp from,
+                                                                            model::Timestamp to,
+                                                                            std::pmr::memory_resource* mr) {
+    METRICS_SCOPE(timer, "BillRepository.queryByTimeInOrder(pmr)");
+    statements_->rows_by_time_ordered.Bind({from, to});
+    return timer.Counted(ReadBillRows(statements_->rows_by_time_ordered, mr));
+}
+
+std::pmr::vector<model::PmrBillRow> BillRepositoryImpl::queryByTimeAndEventInOrder(model::Timestamp from,
+                                                                                    model::Timestamp to,
+                                                                                    std::pmr::memory_resource* mr) {
+    METRICS_SCOPE(timer, "BillRepository.queryByTimeAndEventInOrder(pmr)");
+    statements_->rows_by_time_event_ordered.Bind({from, to});
+    return timer.Counted(ReadBillRows(statements_->rows_by_time_event_ordered, mr));
+}
+
+std::vector<model::BillTotal> BillRepositoryImpl::totalsByEvent(model::Timestamp from,
+                                                                model::Timestamp to) {
+    METRICS_SCOPE(timer, "BillRepository.totalsByEvent");
+    auto& storage = db_->GetStorage();
+
+    // 只读 idx_bills_created_cover，不回表
+    auto rows = storage.select(
+        columns(&model::Bill::event_id, count(&model::Bill::id), SumMoney(&model::Bill::amount)),
+        where(
+            c(&model::Bill::created_at) >= from &&
+            c(&model::Bill::created_at) <= to
+        ),
+        group_by(&model::Bill::event_id)
     );
+    return timer.Counted(ToBillTotals(rows));
 }
 
-std::vector<model::Bill> BillRepositoryImpl::queryByPhone(const std::string& phone) {
+std::vector<model::BillTotal> BillRepositoryImpl::totalsByOwner(model::Timestamp from,
+                                                                model::Timestamp to) {
+    METRICS_SCOPE(timer, "BillRepository.totalsByOwner");
     auto& storage = db_->GetStorage();
-    
-    // 先查找用户
-    auto users = storage.get_all<model::User>(
-        where(c(&model::User::phone) == phone)
+
+    auto rows = storage.select(
+        columns(&model::Bill::owner_id, count(&model::Bill::id), SumMoney(&model::Bill::amount)),
+        where(
+            c(&model::Bill::created_at) >= from &&
+            c(&model::Bill::created_at) <= to
+        ),
+        group_by(&model::Bill::owner_id)
     );
-    
-    if (users.empty()) {
-        return {};
+    return timer.Counted(ToBillTotals(rows));
+}
+
+std::vector<model::PeriodTotal> BillRepositoryImpl::totalsByPeriod(model::Timestamp from,
+                                                                   model::Timestamp to,
+                                                                   model::Granularity granularity) {
+    METRICS_SCOPE(timer, "BillRepository.totalsByPeriod");
+    auto& storage = db_->GetStorage();
+    PeriodTotals merged;
+
+    // [first_day, end_day) 内的完整自然日读汇总表，首尾不足一天的部分直接聚合 bills。
+    // 边界按 INT64 饱和计算，调用方可能传入 0..INT64_MAX
+    model::Timestamp first_day = DayStart(from);
+    if (first_day != from) {
+        first_day = first_day > kMaxTimestamp - kSecondsPerDay ? kMaxTimestamp : first_day + kSecondsPerDay;
     }
-    
-    int user_id = users[0].id;
-    
-    return storage.get_all<model::Bill>(
-        where(c(&model::Bill::owner_id) == user_id)
+    // to 是当日最后一秒时当天也完整；不写成 DayStart(to + 1)，to 可能是 INT64_MAX
+    model::Timestamp end_day = DayStart(to);
+    if (to - end_day == kSecondsPerDay - 1 && end_day <= kMaxTimestamp - kSecondsPerDay) {
+        end_day += kSecondsPerDay;
+    }
+
+    auto accumulate_bills = [&](model::Timestamp lo, model::Timestamp hi) {
+        if (lo > hi) {
+            return;
+        }
+        WithPeriod(&model::Bill::created_at, granularity, [&](auto period) {
+            AccumulatePeriodTotals(storage, period,
+                count(&model::Bill::id), SumMoney(&model::Bill::amount),
+                c(&model::Bill::created_at) >= lo && c(&model::Bill::created_at) <= hi,
+                merged);
+        });
+    };
+
+    if (first_day < end_day) {
+        WithPeriod(&model::DailyRollup::day, granularity, [&](auto period) {
+            AccumulatePeriodTotals(storage, period,
+                total(&model::DailyRollup::count), SumMoney(&model::DailyRollup::sum),
+                c(&model::DailyRollup::day) >= first_day && c(&model::DailyRollup::day) < end_day,
+                merged);
+        });
+        if (first_day > from) {
+            accumulate_bills(from, first_day - 1);
+        }
+        accumulate_bills(end_day, to);
+    } else {
+        accumulate_bills(from, to);
+    }
+
+    std::vector<model::PeriodTotal> totals;
+    totals.reserve(merged.size());
+    for (auto& entry : merged) {
+        totals.push_back(std::move(entry.second));
+    }
+    timer.Rows(totals.size());
+    return totals;
+}
+
+void BillRepositoryImpl::rebuildRollups() {
+    METRICS_SCOPE(timer, "BillRepository.rebuildRollups");
+    auto& storage = db_->GetStorage();
+
+    auto guard = storage.transaction_guard();
+    storage.remove_all<model::DailyRollup>();
+    for (const auto& r : ComputeRollups(storage)) {
+        storage.replace(r);
+    }
+    guard.commit();
+}
+
+std::vector<model::RollupMismatch> BillRepositoryImpl::checkRollups() {
+    METRICS_SCOPE(timer, "BillRepository.checkRollups");
+    auto& storage = db_->GetStorage();
+    std::map<RollupKey, model::RollupMismatch> diff;
+
+    for (const auto& r : ComputeRollups(storage)) {
+        auto& m = diff[RollupKey{r.owner_id, r.event_id, r.day}];
+        m.expected_count = r.count;
+        m.expected_sum = r.sum;
+    }
+    for (const auto& r : storage.get_all<model::DailyRollup>()) {
+        auto& m = diff[RollupKey{r.owner_id, r.event_id, r.day}];
+        m.actual_count = r.count;
+        m.actual_sum = r.sum;
+    }
+
+    std::vector<model::RollupMismatch> mismatches;
+    for (auto& [key, m] : diff) {
+        if (m.expected_count == m.actual_count && m.expected_sum == m.actual_sum) {
+            continue;
+        }
+        std::tie(m.owner_id, m.event_id, m.day) = key;
+        mismatches.push_back(m);
+    }
+    timer.Rows(mismatches.size());
+    return mismatches;
+}
+
+model::BillSummary BillRepositoryImpl::summary(model::Timestamp from, model::Timestamp to) {
+    METRICS_SCOPE(timer, "BillRepository.summary");
+    auto& storage = db_->GetStorage();
+    model::BillSummary result;
+
+    auto rows = storage.select(
+        columns(count(&model::Bill::id),
+                SumMoney(&model::Bill::amount),
+                min(&model::Bill::amount),
+                max(&model::Bill::amount)),
+        where(
+            c(&model::Bill::created_at) >= from &&
+            c(&model::Bill::created_at) <= to
+        )
     );
+    if (rows.empty() || std::get<0>(rows[0]) == 0) {
+        return result;
+    }
+
+    auto& row = rows[0];
+    result.count = std::get<0>(row);
+    result.sum = std::get<1>(row);
+    result.min = std::get<2>(row) ? *std::get<2>(row) : model::Money();
+    result.max = std::get<3>(row) ? *std::get<3>(row) : model::Money();
+    // 整数除法四舍五入（远离零）
+    int64_t half = result.sum.cents >= 0 ? result.count / 2 : -(result.count / 2);
+    result.avg = model::Money((result.sum.cents + half) / result.count);
+    return result;
+}
+
+// 遍历语句每次现编译而不复用 PreparedStatements：回调里再查询本仓库时不会重置正在遍历的语句
+void BillRepositoryImpl::forEachByTime(model::Timestamp from,
+                                       model::Timestamp to,
+                                       const repo::BillVisitor& visit) {
+    METRICS_SCOPE(timer, "BillRepository.forEachByTime");
+    RawStatement statement(db_->GetStorage(), kRowsByTimeSql);
+    statement.Bind({from, to});
+    timer.Rows(VisitBillRows(statement, visit));
+}
+
+void BillRepositoryImpl::forEachByTimeInOrder(model::Timestamp from,
+                                              model::Timestamp to,
+                                              const repo::BillVisitor& visit) {
+    METRICS_SCOPE(timer, "BillRepository.forEachByTimeInOrder");
+    RawStatement statement(db_->GetStorage(), kRowsByTimeOrderedSql);
+    statement.Bind({from, to});
+    timer.Rows(VisitBillRows(statement, visit));
+}
+
+void BillRepositoryImpl::forEachByTimeAndEventInOrder(model::Timestamp from,
+                                                      model::Timestamp to,
+                                                      const repo::BillVisitor& visit) {
+    METRICS_SCOPE(timer, "BillRepository.forEachByTimeAndEventInOrder");
+    RawStatement statement(db_->GetStorage(), kRowsByTimeEventOrderedSql);
+    statement.Bind({from, to});
+    timer.Rows(VisitBillRows(statement, visit));
+}
+
+std::vector<model::BillRow> BillRepositoryImpl::queryByPhone(const std::string& phone) {
+    METRICS_SCOPE(timer, "BillRepository.queryByPhone");
+    auto& storage = db_->GetStorage();
+    
+    get<0>(statements_->by_phone) = phone;
+    auto rows = storage.execute(statements_->by_phone);
+    return timer.Counted(ToBillRows(rows));
 }
 
 void BillRepositoryImpl::remove(int id) {
+    METRICS_SCOPE(timer, "BillRepository.remove");
     auto& storage = db_->GetStorage();
     
     try {
+        auto guard = storage.transaction_guard();
+        auto old = storage.get_optional<model::Bill>(id);
+        if (!old.has_value()) {
+            return;
+        }
         storage.remove<model::Bill>(id);
+
+        RollupDeltas deltas;
+        AddRollupDelta(deltas, *old, -1);
+        ApplyRollupDeltas(storage, deltas);
+        db_->GetSearchIndex().Remove(id);
+        guard.commit();
     } catch (const std::exception& e) {
+        timer.Fail();
         // 可选：记录日志或忽略
     }
 }
\ No newline at end of file
@@ -1,26 +1,57 @@
 #pragma once
 #include <irepositories.h>
 #include "DatabaseORM.h"
+#include <memory>
 
+// 非线程安全：pmr 重载、分页与按手机号查询复用实例内的预编译语句（PreparedStatements），
+// 一个实例同一时间只能由一个线程使用；多线程访问时每个线程各建一个实例或在外部加锁
 class BillRepositoryImpl : public repo::IBillRepository {
 public:
-    explicit BillRepositoryImpl(std::shared_ptr<DatabaseORM> db) : db_(db) {}
-    void save(const model::Bill& b);
+    explicit BillRepositoryImpl(std::shared_ptr<DatabaseORM> db);
+    ~BillRepositoryImpl() override;
+    int save(const model::Bill& b) override;
+    std::vector<int> saveBatch(const std::vector<model::Bill>& bills) override;
 
     std::optional<model::Bill> findById(int id) override;
 
-    std::vector<model::Bill> queryByEvent(int ownerId, int eventId) override;
-    std::vector<model::Bill> queryByEvent(const std::string& name) override; // 仅管理员可用
+    std::vector<model::BillRow> queryByEvent(int ownerId, int eventId) override;
+    std::vector<model::BillRow> queryByEvent(const std::string& name) override; // 仅管理员可用
 
-    std::vector<model::Bill> queryByTime(int ownerId, model::Timestamp from, model::Timestamp to) override;
-    std::vector<model::Bill> queryByTime(model::Timestamp from, model::Timestamp to) override; // 仅管理员可用
+    std::vector<model::BillRow> queryByTime(int ownerId, model::Timestamp from, model::Timestamp to) override;
+    std::vector<model::BillRow> queryByTime(model::Timestamp from, model::Timestamp to) override; // 仅管理员可用
+    model::BillPage queryByTimePage(model::Timestamp from, model::Timestamp to,
+                                    const std::optional<model::BillCursor>& after, int page_size) override; // 仅管理员可用
 
-    std::vector<model::Bill> queryByPhone(const std::string& phone) override; // 仅管理员可用
+    std::vector<model::BillRow> queryByPhone(const std::string& phone) override; // 仅管理员可用
 
-    std::vector<model::Bill> queryByTimeInOrder(model::Timestamp from, model::Timestamp to) override; // 仅管理员可用
-    std::vector<model::Bill> queryByTimeAndEventInOrder(model::Timestamp from, model::Timestamp to) override; // 仅管理员可用
+    std::vector<model::BillRow> queryByTimeInOrder(model::Timestamp from, model::Timestamp to) override; // 仅管理员可用
+    std::vector<model::BillRow> queryByTimeAndEventInOrder(model::Timestamp from, model::Timestamp to) override; // 仅管理员可用
+
+    std::pmr::vector<model::PmrBillRow> queryByTime(int ownerId, model::Timestamp from, model::Timestamp to,
+                                                    std::pmr::memory_resource* mr) override;
+    std::pmr::vector<model::PmrBillRow> queryByTime(model::Timestamp from, model::Timestamp to,
+                                                    std::pmr::memory_resource* mr) override; // 仅管理员可用
+    std::pmr::vector<model::PmrBillRow> queryByTimeInOrder(model::Timestamp from, model::Timestamp to,
+                                                           std::pmr::memory_resource* mr) override; // 仅管理员可用
+    std::pmr::vector<model::PmrBillRow> queryByTimeAndEventInOrder(model::Timestamp from, model::Timestamp to,
+                                                                   std::pmr::memory_resource* mr) override; // 仅管理员可用
+
+    std::vector<model::BillTotal> totalsByEvent(model::Timestamp from, model::Timestamp to) override; // 仅管理员可用
+    std::vector<model::BillTotal> totalsByOwner(model::Timestamp from, model::Timestamp to) override; // 仅管理员可用
+    std::vector<model::PeriodTotal> totalsByPeriod(model::Timestamp from, model::Timestamp to, model::Granularity granularity) override; // 仅管理员可用
+    model::BillSummary summary(model::Timestamp from, model::Timestamp to) override; // 仅管理员可用
+
+    void rebuildRollups() override; // 仅管理员可用
+    std::vector<model::RollupMismatch> checkRollups() override; // 仅管理员可用
+
+    void forEachByTime(model::Timestamp from, model::Timestamp to, const repo::BillVisitor& visit) override; // 仅管理员可用
+    void forEachByTimeInOrder(model::Timestamp from, model::Timestamp to, const repo::BillVisitor& visit) override; // 仅管理员可用
+    void forEachByTimeAndEventInOrder(model::Timestamp from, model::Timestamp to, const repo::BillVisitor& visit) override; // 仅管理员可用
 
     void remove(int id) override;
 private:
+    struct PreparedStatements;
+
     std::shared_ptr<DatabaseORM> db_;
+    std::unique_ptr<PreparedStatements> statements_;
 };
@@ -0,0 +1,174 @@
+#include "BillSearchIndex.h"
+#include <stdexcept>
+
+namespace {
+
+// trigram 分词按连续三个字符建索引，中文等不以空格分词的文本也能按子串命中
+const char* const kCreateSql =
+    "CREATE VIRTUAL TABLE bill_search USING fts5("
+    "description, annotations, tokenize = 'trigram')";
+
+// 账单 id 为 ?1 的索引行内容；也用于全量填充（去掉 WHERE）
+const std::string kSelectDocumentSql =
+    "SELECT b.id, b.description, "
+    "COALESCE((SELECT group_concat(a.content, ' ') FROM annotations a WHERE a.bill_id = b.id), '') "
+    "FROM bills b ";
+
+// 搜索语句的公共部分：?1 为用户（0 不过滤），?2 / ?3 为 LIMIT / OFFSET，?4 为 MATCH 表达式，
+// ?5 起为各个子串的 LIKE 模式
+const std::string kSearchSelectSql =
+    "SELECT b.id, b.owner_id, b.event_id, b.amount, b.created_at, b.description, b.has_annotation "
+    "FROM bill_search s JOIN bills b ON b.id = s.rowid "
+    "WHERE (?1 = 0 OR b.owner_id = ?1) ";
+const char* const kMatchSql = "AND bill_search MATCH ?4 ";
+// 描述命中比批注命中权重更高
+const char* const kRankOrderSql = "ORDER BY bm25(bill_search, 2.0, 1.0), b.id LIMIT ?2 OFFSET ?3";
+// 没有 MATCH 时无相关度可比，新账单在前
+const char* const kRecentOrderSql = "ORDER BY b.id DESC LIMIT ?2 OFFSET ?3";
+
+// 子串的 LIKE 模式，转义其中的 %、_ 与转义符本身
+std::string LikePattern(const std::string& text) {
+    std::string pattern = "%";
+    for (char ch : text) {
+        if (ch == '%' || ch == '_' || ch == '\\') {
+            pattern += '\\';
+        }
+        pattern += ch;
+    }
+    pattern += '%';
+    return pattern;
+}
+
+// 不抛异常的 sqlite3_exec，失败时由调用方决定回滚还是跳过
+bool TryExec(sqlite3* db, const char* sql) {
+    return sqlite3_exec(db, sql, nullptr, nullptr, nullptr) == SQLITE_OK;
+}
+
+}
+
+struct BillSearchIndex::Statements {
+    explicit Statements(Storage& storage)
+        : storage(storage),
+          remove(storage, "DELETE FROM bill_search WHERE rowid = ?1"),
+          insert(storage, "INSERT INTO bill_search(rowid, description, annotations) " +
+                          kSelectDocumentSql + "WHERE b.id = ?1"),
+          search(storage, kSearchSelectSql + kMatchSql + kRankOrderSql) {}
+
+    Storage& storage;
+    RawStatement remove;
+    RawStatement insert;
+    RawStatement search;
+};
+
+BillSearchIndex::BillSearchIndex(Storage& storage) {
+    try {
+        statements_ = std::make_unique<Statements>(storage);
+        available_ = true;
+    } catch (const std::exception&) {
+        // 迁移时 SQLite 不支持 FTS5 / trigram，没有建出 bill_search，不影响其余功能
+        available_ = false;
+    }
+}
+
+bool BillSearchIndex::Build(sqlite3* db) {
+    // 失败时回到保存点，旧表（如果有）保持原样
+    if (!TryExec(db, "SAVEPOINT build_bill_search")) {
+        throw std::runtime_error(std::string("SAVEPOINT build_bill_search: ") + sqlite3_errmsg(db));
+    }
+    if (!TryExec(db, "DROP TABLE IF EXISTS bill_search") || !TryExec(db, kCreateSql)) {
+        // 通常是 no such module: fts5 或 no such tokenizer: trigram
+        TryExec(db, "ROLLBACK TO build_bill_search");
+        TryExec(db, "RELEASE build_bill_search");
+        return false;
+    }
+    const std::string fill = "INSERT INTO bill_search(rowid, description, annotations) " + kSelectDocumentSql;
+    if (!TryExec(db, fill.c_str())) {
+        std::string msg = sqlite3_errmsg(db);
+        TryExec(db, "ROLLBACK TO build_bill_search");
+        TryExec(db, "RELEASE build_bill_search");
+        throw std::runtime_error(fill + ": " + msg);
+    }
+    TryExec(db, "RELEASE build_bill_search");
+    return true;
+}
+
+BillSearchIndex::~BillSearchIndex() = default;
+
+void BillSearchIndex::Refresh(int bill_id) {
+    if (!available_) {
+        return;
+    }
+    // 先删后插；账单已不存在时 INSERT ... SELECT 不产生行，等同删除
+    Remove(bill_id);
+    statements_->insert.Bind({bill_id});
+    statements_->insert.Step();
+}
+
+void BillSearchIndex::Remove(int bill_id) {
+    if (!available_) {
+        return;
+    }
+    statements_->remove.Bind({bill_id});
+    statements_->remove.Step();
+}
+
+model::SearchPage BillSearchIndex::Search(const std::string& match, const std::vector<std::string>& substrings,
+                                          int owner_id, int offset, int limit) {
+    model::SearchPage page;
+    if (!available_ || (match.empty() && substrings.empty()) || limit <= 0) {
+        return page;
+    }
+
+    // 带子串条件的语句随子串个数变化，每次现编译；其代价远小于 LIKE 逐行过滤本身
+    std::unique_ptr<RawStatement> adhoc;
+    RawStatement* statement = &statements_->search;
+    if (!substrings.empty()) {
+        std::string sql = kSearchSelectSql;
+        if (!match.empty()) {
+            sql += kMatchSql;
+        }
+        for (size_t i = 0; i < substrings.size(); ++i) {
+            const std::string param = "?" + std::to_string(5 + i);
+            sql += "AND (s.description LIKE " + param + " ESCAPE '\\' OR s.annotations LIKE " + param +
+                   " ESCAPE '\\') ";
+        }
+        sql += match.empty() ? kRecentOrderSql : kRankOrderSql;
+        adhoc = std::make_unique<RawStatement>(statements_->storage, sql);
+        statement = adhoc.get();
+    }
+
+    // 多取一行用来判断是否还有下一页
+    statement->Bind({owner_id, limit + 1, offset});
+    if (!match.empty()) {
+        statement->BindText(4, match);
+    }
+    for (size_t i = 0; i < substrings.size(); ++i) {
+        statement->BindText(static_cast<int>(5 + i), LikePattern(substrings[i]));
+    }
+    auto* stmt = statement->Get();
+    try {
+        while (statement->Step()) {
+            auto& r = page.bills.emplace_back();
+            r.id = sqlite3_column_int(stmt, 0);
+            r.owner_id = sqlite3_column_int(stmt, 1);
+            r.event_id = sqlite3_column_int(stmt, 2);
+            r.amount = model::Money(sqlite3_column_int64(stmt, 3));
+            r.created_at = sqlite3_column_int64(stmt, 4);
+            r.description.assign(reinterpret_cast<const char*>(sqlite3_column_text(stmt, 5)),
+                                 static_cast<size_t>(sqlite3_column_bytes(stmt, 5)));
+            r.has_annotation = sqlite3_column_int(stmt, 6) != 0;
+        }
+    } catch (const std::runtime_error&) {
+        // 只有 MATCH 表达式语法错误按无结果处理；BUSY、IO 错误等照常抛出
+        if (sqlite3_errcode(sqlite3_db_handle(stmt)) != SQLITE_ERROR) {
+            throw;
+        }
+        return model::SearchPage();
+    }
+
+    if (page.bills.size() > static_cast<size_t>(limit)) {
+        page.bills.pop_back();
+        page.next_offset = offset + limit;
+    }
+    return page;
+}
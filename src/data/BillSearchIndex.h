@@ -0,0 +1,43 @@
+#pragma once
+#include "DatabaseORM.h"
+#include <memory>
+#include <string>
+#include <vector>
+
+// bills.description 与 annotations.content 的 FTS5 全文索引（bill_search 表，rowid 即账单 id）。
+// 每张账单一行：description 列为账单描述，annotations 列为该账单全部批注拼接。
+// 使用 trigram 分词，查询按子串匹配且大小写不敏感。短于 3 个字符的词没有 trigram 可查，
+// 改用 LIKE 在 bill_search 上逐行过滤：结果正确，但耗时随账单总数线性增长。
+// 表由 DatabaseORM 的迁移 3 调用 Build 创建并从现有数据全量填充；此后由 BillRepositoryImpl 与
+// AnnotationRepositoryImpl 的写路径调用 Refresh / Remove 保持同步。
+// 迁移时 SQLite 未编译 FTS5（或不支持 trigram）则不建表，索引不可用，搜索返回空结果。
+class BillSearchIndex {
+public:
+    explicit BillSearchIndex(Storage& storage);
+    ~BillSearchIndex();
+
+    BillSearchIndex(const BillSearchIndex&) = delete;
+    BillSearchIndex& operator=(const BillSearchIndex&) = delete;
+
+    bool Available() const { return available_; }
+
+    // 删除已有的 bill_search，按 trigram 分词重建并从 bills / annotations 全量填充。
+    // SQLite 不支持 FTS5 / trigram 时返回 false，数据库保持原样；其余错误抛出 std::runtime_error
+    static bool Build(sqlite3* db);
+
+    // 按 bills / annotations 当前内容重写账单的索引行，账单不存在时删除
+    void Refresh(int bill_id);
+    void Remove(int bill_id);
+
+    // match 为 FTS5 查询表达式（可为空）；substrings 中每一项都须作为子串（LIKE，大小写不敏感）
+    // 出现在描述或批注中。owner_id 为 0 时不按用户过滤。有 match 时按 bm25 升序（越相关越靠前），
+    // 只有 substrings 时按账单 id 倒序。表达式语法错误时返回空页，其余 SQLite 错误抛出 std::runtime_error
+    model::SearchPage Search(const std::string& match, const std::vector<std::string>& substrings, int owner_id,
+                             int offset, int limit);
+
+private:
+    struct Statements;
+
+    bool available_ = false;
+    std::unique_ptr<Statements> statements_;
+};
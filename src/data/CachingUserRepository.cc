@@ -0,0 +1,151 @@
+#include "CachingUserRepository.h"
+
+#include <algorithm>
+#include <iterator>
+#include <utility>
+
+CachingUserRepository::CachingUserRepository(std::shared_ptr<repo::IUserRepository> inner, size_t capacity)
+    : inner_(std::move(inner)), capacity_(std::max<size_t>(capacity, 1)) {}
+
+int CachingUserRepository::save(const model::User& u) {
+    int id = inner_->save(u);
+    // 手机号可能被修改，按 id 和新手机号各失效一次
+    Invalidate(id, u.phone);
+    return id;
+}
+
+std::optional<model::User> CachingUserRepository::findById(int id) {
+    uint64_t version = 0;
+    if (auto cached = Lookup(id, version)) {
+        return cached;
+    }
+
+    auto user = inner_->findById(id);
+    if (user.has_value()) {
+        Insert(*user, version);
+    }
+    return user;
+}
+
+std::optional<model::User> CachingUserRepository::queryByPhone(const std::string& phone) {
+    uint64_t version = 0;
+    if (auto cached = Lookup(phone, version)) {
+        return cached;
+    }
+
+    auto user = inner_->queryByPhone(phone);
+    if (user.has_value()) {
+        Insert(*user, version);
+    }
+    return user;
+}
+
+std::vector<model::User> CachingUserRepository::queryByPhonePartial(const std::string& partial) {
+    return inner_->queryByPhonePartial(partial);
+}
+
+bool CachingUserRepository::setBalanceByPhone(const std::string& phone, model::Money balance) {
+    bool updated = inner_->setBalanceByPhone(phone, balance);
+    Invalidate(0, phone);
+    return updated;
+}
+
+CachingUserRepository::Stats CachingUserRepository::stats() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return stats_;
+}
+
+size_t CachingUserRepository::size() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return entries_.size();
+}
+
+void CachingUserRepository::clear() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    entries_.clear();
+    by_id_.clear();
+    by_phone_.clear();
+    ++version_;
+}
+
+std::optional<model::User> CachingUserRepository::Lookup(int id, uint64_t& version) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = by_id_.find(id);
+    if (it == by_id_.end()) {
+        ++stats_.misses;
+        version = version_;
+        return std::nullopt;
+    }
+    ++stats_.hits;
+    entries_.splice(entries_.begin(), entries_, it->second);
+    return *it->second;
+}
+
+std::optional<model::User> CachingUserRepository::Lookup(const std::string& phone, uint64_t& version) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = by_phone_.find(phone);
+    if (it == by_phone_.end()) {
+        ++stats_.misses;
+        version = version_;
+        return std::nullopt;
+    }
+    ++stats_.hits;
+    entries_.splice(entries_.begin(), entries_, it->second);
+    return *it->second;
+}
+
+void CachingUserRepository::Insert(const model::User& u, uint64_t version) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    // 读库期间发生过写入，读到的可能已是旧值，不放入缓存
+    if (version != version_) {
+        return;
+    }
+
+    // 别的线程可能已放入同一用户，以本次读到的为准
+    EraseId(u.id);
+    ErasePhone(u.phone);
+
+    entries_.push_front(u);
+    by_id_[u.id] = entries_.begin();
+    by_phone_[u.phone] = entries_.begin();
+
+    while (entries_.size() > capacity_) {
+        Erase(std::prev(entries_.end()));
+        ++stats_.evictions;
+    }
+}
+
+void CachingUserRepository::Invalidate(int id, const std::string& phone) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    ++version_;
+    if (EraseId(id)) {
+        ++stats_.invalidations;
+    }
+    if (ErasePhone(phone)) {
+        ++stats_.invalidations;
+    }
+}
+
+void CachingUserRepository::Erase(Entries::iterator it) {
+    by_id_.erase(it->id);
+    by_phone_.erase(it->phone);
+    entries_.erase(it);
+}
+
+bool CachingUserRepository::EraseId(int id) {
+    auto it = by_id_.find(id);
+    if (it == by_id_.end()) {
+        return false;
+    }
+    Erase(it->second);
+    return true;
+}
+
+bool CachingUserRepository::ErasePhone(const std::string& phone) {
+    auto it = by_phone_.find(phone);
+    if (it == by_phone_.end()) {
+        return false;
+    }
+    Erase(it->second);
+    return true;
+}
@@ -0,0 +1,59 @@
+#pragma once
+#include <irepositories.h>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+// 用户仓库的读穿透缓存装饰器：findById / queryByPhone 命中时不访问 SQLite。
+// 按 id 与手机号两个索引指向同一条 LRU 记录，容量满时淘汰最久未用的用户。
+// save / setBalanceByPhone 写入内层仓库后使对应记录失效。
+// 假设所有对 users 表的写入都经过本对象，否则缓存可能读到旧值。
+class CachingUserRepository : public repo::IUserRepository {
+public:
+    struct Stats {
+        int64_t hits = 0;
+        int64_t misses = 0;
+        int64_t evictions = 0;
+        int64_t invalidations = 0;
+    };
+
+    explicit CachingUserRepository(std::shared_ptr<repo::IUserRepository> inner, size_t capacity = 1024);
+
+    int save(const model::User& u) override;
+
+    std::optional<model::User> findById(int id) override;
+
+    std::optional<model::User> queryByPhone(const std::string& phone) override; // 仅管理员可用
+    std::vector<model::User> queryByPhonePartial(const std::string& partial) override; // 仅管理员可用，不缓存
+
+    bool setBalanceByPhone(const std::string& phone, model::Money balance) override; // 仅管理员可用
+
+    Stats stats() const;
+    size_t size() const;
+    void clear();
+
+private:
+    using Entries = std::list<model::User>; // 头部为最近使用
+
+    // 未命中时通过 version 返回当前写入版本，供 Insert 判断读库期间是否发生过写入
+    std::optional<model::User> Lookup(int id, uint64_t& version);
+    std::optional<model::User> Lookup(const std::string& phone, uint64_t& version);
+    void Insert(const model::User& u, uint64_t version);
+    void Invalidate(int id, const std::string& phone);
+    void Erase(Entries::iterator it);
+    bool EraseId(int id);
+    bool ErasePhone(const std::string& phone);
+
+    std::shared_ptr<repo::IUserRepository> inner_;
+    size_t capacity_;
+
+    mutable std::mutex mutex_;
+    Entries entries_;
+    std::unordered_map<int, Entries::iterator> by_id_;
+    std::unordered_map<std::string, Entries::iterator> by_phone_;
+    uint64_t version_ = 0; // 每次写入加一
+    Stats stats_;
+};
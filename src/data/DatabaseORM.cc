@@ -1,11 +1,382 @@
 #include "DatabaseORM.h"
+#include "BillSearchIndex.h"
+#include "EventCatalog.h"
+#include "PhoneTrigramIndex.h"
+#include "StatementProfiler.h"
+#include <algorithm>
+#include <functional>
 #include <iostream>
+#include <stdexcept>
 
-DatabaseORM::DatabaseORM(const std::string& db_path) 
-    : storage_(CreateStorage(db_path)), db_path_(db_path) {
+namespace {
+
+const char* ToPragmaValue(DatabaseOptions::JournalMode mode) {
+    switch (mode) {
+        case DatabaseOptions::JournalMode::Delete:   return "DELETE";
+        case DatabaseOptions::JournalMode::Truncate: return "TRUNCATE";
+        case DatabaseOptions::JournalMode::Persist:  return "PERSIST";
+        case DatabaseOptions::JournalMode::Memory:   return "MEMORY";
+        case DatabaseOptions::JournalMode::Wal:      return "WAL";
+        case DatabaseOptions::JournalMode::Off:      return "OFF";
+    }
+    return "DELETE";
+}
+
+void ExecOrThrow(sqlite3* db, const std::string& sql) {
+    char* err = nullptr;
+    if (sqlite3_exec(db, sql.c_str(), nullptr, nullptr, &err) != SQLITE_OK) {
+        std::string msg = err ? err : sqlite3_errmsg(db);
+        sqlite3_free(err);
+        throw std::runtime_error(sql + ": " + msg);
+    }
+}
+
+// 执行查询并返回第 column 列的文本值
+std::vector<std::string> QueryColumn(sqlite3* db, const std::string& sql, int column) {
+    std::vector<std::string> values;
+    sqlite3_stmt* stmt = nullptr;
+    if (sqlite3_prepare_v2(db, sql.c_str(), -1, &stmt, nullptr) != SQLITE_OK) {
+        throw std::runtime_error(sql + ": " + sqlite3_errmsg(db));
+    }
+    while (sqlite3_step(stmt) == SQLITE_ROW) {
+        auto text = sqlite3_column_text(stmt, column);
+        values.emplace_back(text ? reinterpret_cast<const char*>(text) : "");
+    }
+    sqlite3_finalize(stmt);
+    return values;
+}
+
+bool TableExists(sqlite3* db, const std::string& table) {
+    return !QueryColumn(db, "SELECT name FROM sqlite_master WHERE type = 'table' AND name = '" + table + "'", 0).empty();
+}
+
+// 列的声明类型（大写），表或列不存在时返回空串
+std::string ColumnType(sqlite3* db, const std::string& table, const std::string& column) {
+    auto types = QueryColumn(db,
+        "SELECT upper(type) FROM pragma_table_info('" + table + "') WHERE name = '" + column + "'", 0);
+    return types.empty() ? "" : types[0];
+}
+
+// 金额列由 REAL（元）改为 INTEGER（分）。SQLite 不能修改列类型，
+// 旧表先改名为 <table>_real_legacy，sync_schema 建新表后再按 ROUND(x * 100) 拷回。
+struct MoneyColumn {
+    const char* table;
+    const char* column;
+};
+
+// users 先于 bills 拷贝，保证外键引用的行已存在
+const MoneyColumn kMoneyColumns[] = {
+    {"users", "balance"},
+    {"bills", "amount"},
+};
+
+std::string LegacyName(const MoneyColumn& m) {
+    return std::string(m.table) + "_real_legacy";
+}
+
+// 迁移期间关闭外键检查并使用旧式 RENAME，避免其他表的 REFERENCES 被改写到旧表上
+void WithoutForeignKeys(sqlite3* db, const std::function<void()>& f) {
+    bool foreign_keys = QueryColumn(db, "PRAGMA foreign_keys", 0) == std::vector<std::string>{"1"};
+    ExecOrThrow(db, "PRAGMA foreign_keys = OFF");
+    ExecOrThrow(db, "PRAGMA legacy_alter_table = ON");
+    try {
+        ExecOrThrow(db, "BEGIN");
+        f();
+        ExecOrThrow(db, "COMMIT");
+    } catch (...) {
+        sqlite3_exec(db, "ROLLBACK", nullptr, nullptr, nullptr);
+        ExecOrThrow(db, "PRAGMA legacy_alter_table = OFF");
+        ExecOrThrow(db, std::string("PRAGMA foreign_keys = ") + (foreign_keys ? "ON" : "OFF"));
+        throw;
+    }
+    ExecOrThrow(db, "PRAGMA legacy_alter_table = OFF");
+    ExecOrThrow(db, std::string("PRAGMA foreign_keys = ") + (foreign_keys ? "ON" : "OFF"));
+}
+
+// sync_schema 之前：把仍为 REAL 的金额表改名让出位置，旧汇总表直接丢弃（启动时会重建）
+void BeginMoneyMigration(sqlite3* db) {
+    std::vector<MoneyColumn> pending;
+    for (const auto& m : kMoneyColumns) {
+        if (ColumnType(db, m.table, m.column) == "REAL") {
+            pending.push_back(m);
+        }
+    }
+    bool stale_rollups = ColumnType(db, "bill_rollup_daily", "sum") == "REAL";
+    if (pending.empty() && !stale_rollups) {
+        return;
+    }
+
+    WithoutForeignKeys(db, [&] {
+        for (const auto& m : pending) {
+            // 索引随表改名后仍占用原名，先删掉，由 sync_schema 在新表上重建
+            auto indexes = QueryColumn(db,
+                std::string("SELECT name FROM sqlite_master WHERE type = 'index' AND sql IS NOT NULL "
+                            "AND tbl_name = '") + m.table + "'", 0);
+            for (const auto& index : indexes) {
+                ExecOrThrow(db, "DROP INDEX \"" + index + "\"");
+            }
+            ExecOrThrow(db, std::string("ALTER TABLE \"") + m.table + "\" RENAME TO \"" + LegacyName(m) + "\"");
+        }
+        if (stale_rollups) {
+            ExecOrThrow(db, "DROP TABLE bill_rollup_daily");
+        }
+    });
+}
+
+// sync_schema 之后：把旧表中两边都有的列拷回新表，金额换算为分。
+// 只依据旧表是否存在判断，上次迁移中途退出时会在下次启动继续完成。
+void FinishMoneyMigration(sqlite3* db) {
+    std::vector<MoneyColumn> pending;
+    for (const auto& m : kMoneyColumns) {
+        if (TableExists(db, LegacyName(m))) {
+            pending.push_back(m);
+        }
+    }
+    if (pending.empty()) {
+        return;
+    }
+
+    WithoutForeignKeys(db, [&] {
+        for (const auto& m : pending) {
+            auto legacy = LegacyName(m);
+            auto old_columns = QueryColumn(db, "PRAGMA table_info(\"" + legacy + "\")", 1);
+            std::string target;
+            std::string source;
+            for (const auto& column : QueryColumn(db, std::string("PRAGMA table_info(\"") + m.table + "\")", 1)) {
+                if (std::find(old_columns.begin(), old_columns.end(), column) == old_columns.end()) {
+                    continue;
+                }
+                std::string quoted = "\"" + column + "\"";
+                target += (target.empty() ? "" : ", ") + quoted;
+                source += (source.empty() ? "" : ", ") +
+                          (column == m.column ? "CAST(ROUND(" + quoted + " * 100) AS INTEGER)" : quoted);
+            }
+            ExecOrThrow(db, std::string("INSERT INTO \"") + m.table + "\" (" + target + ") SELECT " + source +
+                            " FROM \"" + legacy + "\"");
+            ExecOrThrow(db, "DROP TABLE \"" + legacy + "\"");
+        }
+    });
+}
+
+int UserVersion(sqlite3* db) {
+    auto values = QueryColumn(db, "PRAGMA user_version", 0);
+    return values.empty() ? 0 : std::stoi(values[0]);
+}
+
+}
+
+DatabaseOptions DatabaseOptions::Durable() {
+    DatabaseOptions o;
+    o.synchronous = Synchronous::Full;
+    o.cache_size = -16384;
+    o.mmap_size = 0;
+    return o;
+}
+
+DatabaseOptions DatabaseOptions::Balanced() {
+    return DatabaseOptions{};
+}
+
+DatabaseOptions DatabaseOptions::Ingest() {
+    DatabaseOptions o;
+    o.synchronous = Synchronous::Off;
+    o.cache_size = -262144;
+    o.mmap_size = 1LL << 30;
+    return o;
+}
+
+std::optional<DatabaseOptions> DatabaseOptions::FromPreset(const std::string& name) {
+    if (name == "durable") {
+        return Durable();
+    } else if (name == "balanced") {
+        return Balanced();
+    } else if (name == "ingest") {
+        return Ingest();
+    }
+    return std::nullopt;
+}
+
+DatabaseORM::DatabaseORM(const std::string& db_path, DatabaseOptions options) 
+    : storage_(CreateStorage(db_path)), db_path_(db_path), options_(options),
+      profiler_(options_.profile_statements
+                    ? std::make_shared<StatementProfiler>(
+                          StatementProfiler::Options{options_.slow_query_ms, options_.slow_query_log})
+                    : nullptr),
+      event_catalog_(std::make_shared<EventCatalog>(storage_)),
+      phone_index_(std::make_shared<PhoneTrigramIndex>(storage_)) {
+    storage_.on_open = [this](sqlite3* db) { ApplyOptions(db); };
+
+    // 内存数据库的连接在构造 storage 时已经打开，on_open 不会再触发
+    if (db_path_.empty() || db_path_ == ":memory:") {
+        auto con = storage_.get_connection();
+        ApplyOptions(con.get());
+    } else if (options_.keep_open) {
+        storage_.open_forever();
+    }
     Initialize();
+
+    // bill_search 由迁移 3 建立，这里只预编译语句
+    search_index_ = std::make_unique<BillSearchIndex>(storage_);
+}
+
+DatabaseORM::DatabaseORM(DatabaseORM& primary, SharedConnection)
+    : storage_(CreateStorage(primary.db_path_)), db_path_(primary.db_path_), options_(primary.options_),
+      profiler_(primary.profiler_),
+      event_catalog_(primary.event_catalog_),
+      phone_index_(primary.phone_index_) {
+    storage_.on_open = [this](sqlite3* db) { ApplyOptions(db); };
+    if (options_.keep_open) {
+        storage_.open_forever();
+    }
+
+    // schema 已由 primary 迁移到最新版本
+    search_index_ = std::make_unique<BillSearchIndex>(storage_);
+}
+
+std::shared_ptr<DatabaseORM> DatabaseORM::OpenConnection() {
+    if (db_path_.empty() || db_path_ == ":memory:") {
+        throw std::invalid_argument("内存数据库不能在多个连接间共享");
+    }
+    return std::shared_ptr<DatabaseORM>(new DatabaseORM(*this, SharedConnection{}));
+}
+
+DatabaseORM::~DatabaseORM() {
+    // 剖析器先于连接析构，关闭连接时不能再回调到它
+    if (profiler_) {
+        auto con = storage_.get_connection();
+        profiler_->FlushSlowLog(con.get());
+        StatementProfiler::Detach(con.get());
+    }
+}
+
+void DatabaseORM::FlushSlowLog() {
+    if (profiler_) {
+        auto con = storage_.get_connection();
+        profiler_->FlushSlowLog(con.get());
+    }
+}
+
+const std::vector<DatabaseORM::Migration>& DatabaseORM::Migrations() {
+    static const std::vector<Migration> migrations = {
+        {1, false, &DatabaseORM::MigrateBaseline},
+        {2, true, &DatabaseORM::DropCreatedEventIndex},
+        {kSearchIndexMigration, true, &DatabaseORM::BuildSearchIndex},
+    };
+    return migrations;
+}
+
+int DatabaseORM::SchemaVersion() {
+    return Migrations().back().version;
 }
 
 void DatabaseORM::Initialize() {
-    storage_.sync_schema();
-}
\ No newline at end of file
+    // 迁移与 sync_schema 共用同一个连接
+    auto con = storage_.get_connection();
+    sqlite3* db = con.get();
+
+    int version = UserVersion(db);
+    if (version == SchemaVersion()) {
+        return;
+    }
+    if (version > SchemaVersion()) {
+        throw std::runtime_error("数据库 schema 版本 " + std::to_string(version) + " 高于程序支持的版本 " +
+                                 std::to_string(SchemaVersion()) + "，请使用更新的程序打开");
+    }
+
+    for (const auto& migration : Migrations()) {
+        if (migration.version <= version) {
+            continue;
+        }
+        const std::string stamp = "PRAGMA user_version = " + std::to_string(migration.version);
+        if (!migration.transactional) {
+            // 自行管理事务的迁移须可重入：中途退出时下次启动会从头再执行一次
+            (this->*migration.apply)(db);
+            ExecOrThrow(db, stamp);
+            continue;
+        }
+        ExecOrThrow(db, "BEGIN");
+        try {
+            (this->*migration.apply)(db);
+            ExecOrThrow(db, stamp);
+            ExecOrThrow(db, "COMMIT");
+        } catch (...) {
+            sqlite3_exec(db, "ROLLBACK", nullptr, nullptr, nullptr);
+            throw;
+        }
+    }
+}
+
+void DatabaseORM::MigrateBaseline(sqlite3* db) {
+    // 版本化之前的数据库也从 0 开始，sync_schema 对已对齐的表不做改动，只补齐缺失的部分
+    BeginMoneyMigration(db);
+    auto results = storage_.sync_schema();
+    FinishMoneyMigration(db);
+
+    auto it = results.find("bill_rollup_daily");
+    rollups_created_ = it != results.end() &&
+                       it->second == orm::sync_schema_result::new_table_created;
+}
+
+void DatabaseORM::DropCreatedEventIndex(sqlite3* db) {
+    ExecOrThrow(db, "DROP INDEX IF EXISTS idx_bills_created_event");
+}
+
+void DatabaseORM::BuildSearchIndex(sqlite3* db) {
+    BillSearchIndex::Build(db);
+}
+
+void DatabaseORM::ApplyOptions(sqlite3* db) const {
+    // busy_timeout 必须先设置，切换 WAL 时可能需要等待其他连接
+    sqlite3_busy_timeout(db, options_.busy_timeout_ms);
+    ExecOrThrow(db, std::string("PRAGMA journal_mode = ") + ToPragmaValue(options_.journal_mode));
+    ExecOrThrow(db, "PRAGMA synchronous = " + std::to_string(static_cast<int>(options_.synchronous)));
+    ExecOrThrow(db, "PRAGMA cache_size = " + std::to_string(options_.cache_size));
+    ExecOrThrow(db, "PRAGMA mmap_size = " + std::to_string(options_.mmap_size));
+    ExecOrThrow(db, "PRAGMA temp_store = " + std::to_string(static_cast<int>(options_.temp_store)));
+    if (profiler_) {
+        profiler_->Attach(db);
+    }
+}
+
+std::vector<std::string> DatabaseORM::ExplainQueryPlan(const std::string& sql) {
+    auto con = storage_.get_connection();
+
+    // 列依次为 id, parent, notused, detail
+    return QueryColumn(con.get(), "EXPLAIN QUERY PLAN " + sql, 3);
+}
+
+RawStatement::RawStatement(Storage& storage, const std::string& sql) : con_(storage.get_connection()) {
+    if (sqlite3_prepare_v3(con_.get(), sql.c_str(), -1, SQLITE_PREPARE_PERSISTENT, &stmt_, nullptr) != SQLITE_OK) {
+        throw std::runtime_error(sql + ": " + sqlite3_errmsg(con_.get()));
+    }
+}
+
+RawStatement::~RawStatement() {
+    sqlite3_finalize(stmt_);
+}
+
+void RawStatement::Bind(std::initializer_list<int64_t> params) {
+    sqlite3_reset(stmt_);
+    int index = 1;
+    for (int64_t value : params) {
+        sqlite3_bind_int64(stmt_, index++, value);
+    }
+}
+
+void RawStatement::BindText(int index, const std::string& value) {
+    sqlite3_bind_text(stmt_, index, value.data(), static_cast<int>(value.size()), SQLITE_TRANSIENT);
+}
+
+bool RawStatement::Step() {
+    int rc = sqlite3_step(stmt_);
+    if (rc == SQLITE_ROW) {
+        return true;
+    }
+    // 结束或出错都立即 reset，不让语句继续持有读事务
+    std::string msg = rc == SQLITE_DONE ? "" : sqlite3_errmsg(con_.get());
+    sqlite3_reset(stmt_);
+    if (rc != SQLITE_DONE) {
+        throw std::runtime_error(msg);
+    }
+    return false;
+}
@@ -1,23 +1,89 @@
 #pragma once
 #include "models.h"
 #include <sqlite_orm/sqlite_orm.h>
+#include <cstdint>
+#include <initializer_list>
 #include <memory>
+#include <optional>
+#include <string>
+#include <vector>
 
 namespace orm = sqlite_orm;
 
+class EventCatalog;
+class PhoneTrigramIndex;
+class BillSearchIndex;
+class StatementProfiler;
+
+// model::Money 以 INTEGER（分）存储
+namespace sqlite_orm {
+
+template<>
+struct type_printer<model::Money> : public integer_printer {};
+
+template<>
+struct statement_binder<model::Money> {
+    int bind(sqlite3_stmt* stmt, int index, const model::Money& value) const {
+        return sqlite3_bind_int64(stmt, index, value.cents);
+    }
+};
+
+template<>
+struct field_printer<model::Money> {
+    std::string operator()(const model::Money& value) const {
+        return std::to_string(value.cents);
+    }
+};
+
+template<>
+struct row_extractor<model::Money> {
+    model::Money extract(const char* row_value) const {
+        return model::Money(row_value ? std::stoll(row_value) : 0);
+    }
+
+    model::Money extract(sqlite3_stmt* stmt, int column_index) const {
+        return model::Money(sqlite3_column_int64(stmt, column_index));
+    }
+
+    model::Money extract(sqlite3_value* value) const {
+        return model::Money(sqlite3_value_int64(value));
+    }
+};
+
+}
+
+// 新建数据库由基线迁移按此定义建表；已有数据库启动时不再对齐，
+// 修改表或索引时须在 DatabaseORM::Migrations 末尾追加一条迁移
 inline auto CreateStorage(const std::string& db_path) {
     using namespace sqlite_orm;
     
     return make_storage(
         db_path,
 
+        // 二级索引（需声明在表之前，sync_schema 会在建表后创建）
+        // queryByTime(ownerId, from, to) / queryByPhone
+        make_index("idx_bills_owner_created", &model::Bill::owner_id, &model::Bill::created_at),
+        // queryByEvent(ownerId, eventId)
+        make_index("idx_bills_owner_event", &model::Bill::owner_id, &model::Bill::event_id),
+        // queryByEvent(name)
+        make_index("idx_bills_event_created", &model::Bill::event_id, &model::Bill::created_at),
+        // queryByTime(from, to) / queryByTimeInOrder / queryByTimePage 键集分页
+        make_index("idx_bills_created_id", &model::Bill::created_at, &model::Bill::id),
+        // queryByTimeAndEventInOrder，同时覆盖按时间范围的聚合统计（不回表）
+        make_index("idx_bills_created_cover", &model::Bill::created_at, &model::Bill::event_id,
+                   &model::Bill::owner_id, &model::Bill::amount),
+        // 按日汇总的区间查询
+        make_index("idx_rollup_daily_day", &model::DailyRollup::day),
+        // AnnotationRepositoryImpl::findByBillId
+        make_index("idx_annotations_bill_created", &model::Annotation::bill_id, &model::Annotation::created_at),
+
         make_table("users",
             make_column("id", &model::User::id, primary_key(). autoincrement()),
             make_column("phone", &model::User::phone, unique()),
             make_column("username", &model::User::username),
             make_column("password", &model::User::password),
             make_column("role", &model::User::role, default_value("user")),
-            make_column("balance", &model::User::balance, default_value(0.0)),
+            make_column("balance", &model::User::balance, default_value(0)),
             make_column("created_at", &model::User::created_at)
         ),
 
@@ -47,21 +113,152 @@ inline auto CreateStorage(const std::string& db_path) {
             make_column("authorid", &model::Annotation::authorid),
             make_column("created_at", &model::Annotation::created_at),
             foreign_key(&model::Annotation::bill_id).references(&model::Bill::id)
+        ),
+
+        // 由 BillRepositoryImpl 的写路径增量维护
+        make_table("bill_rollup_daily",
+            make_column("owner_id", &model::DailyRollup::owner_id),
+            make_column("event_id", &model::DailyRollup::event_id),
+            make_column("day", &model::DailyRollup::day),
+            make_column("count", &model::DailyRollup::count),
+            make_column("sum", &model::DailyRollup::sum),
+            primary_key(&model::DailyRollup::owner_id, &model::DailyRollup::event_id, &model::DailyRollup::day)
         )
     );
 }
 
 using Storage = decltype(CreateStorage(""));
 
+// 每个连接打开时通过 on_open 应用的 PRAGMA 配置
+struct DatabaseOptions {
+    enum class JournalMode { Delete, Truncate, Persist, Memory, Wal, Off };
+    enum class Synchronous { Off = 0, Normal = 1, Full = 2, Extra = 3 };
+    enum class TempStore { Default = 0, File = 1, Memory = 2 };
+
+    JournalMode journal_mode = JournalMode::Wal;
+    Synchronous synchronous = Synchronous::Normal;
+    int cache_size = -65536;             // 负数单位为 KiB，即 64MB
+    int64_t mmap_size = 256LL << 20;     // 0 表示关闭 mmap
+    TempStore temp_store = TempStore::Memory;
+    int busy_timeout_ms = 5000;
+    bool keep_open = true;               // 常驻连接，避免每次操作重新打开文件
+
+    // 语句级剖析（sqlite3_trace_v2），默认关闭；开启后每条语句多两次回调、每个结果行多一次回调，
+    // 语句结束时加一次锁；慢语句的查询计划在 FlushSlowLog 时补做
+    bool profile_statements = false;
+    double slow_query_ms = 100.0;        // 不低于该耗时的语句写入慢查询日志
+    std::string slow_query_log;          // 慢查询日志路径，空串表示只汇总不写日志
+
+    // 命名预设
+    static DatabaseOptions Durable();    // WAL + FULL，每次提交都 fsync
+    static DatabaseOptions Balanced();   // WAL + NORMAL，默认配置
+    static DatabaseOptions Ingest();     // WAL + OFF，批量导入用，断电可能丢失最近提交
+    static std::optional<DatabaseOptions> FromPreset(const std::string& name);
+};
+
 class DatabaseORM {
 public:
-    explicit DatabaseORM(const std::string& db_path);
+    explicit DatabaseORM(const std::string& db_path,
+                         DatabaseOptions options = DatabaseOptions::Balanced());
+    ~DatabaseORM();
+
+    // on_open 捕获了 this，不允许拷贝
+    DatabaseORM(const DatabaseORM&) = delete;
+    DatabaseORM& operator=(const DatabaseORM&) = delete;
+
+    // 在同一数据库文件上再开一个连接（如异步写线程专用）：不执行迁移，只准备本连接的语句；
+    // 事件字典、手机号索引与剖析器和本对象共享，因此返回的连接不能比本对象存活更久。
+    // 内存数据库无法共享，抛出 std::invalid_argument
+    std::shared_ptr<DatabaseORM> OpenConnection();
     
     Storage& GetStorage() { return storage_; }
     
+    // 按 PRAGMA user_version 依次应用尚未执行的迁移；已是最新版本时只读一次 user_version
     void Initialize();
+
+    // 本程序的 schema 版本，即最后一条迁移的编号
+    static int SchemaVersion();
+
+    // 建立 bill_search 的迁移编号。删除 bill_search 后把 user_version 置为它的前一个版本，下次打开时重建
+    static constexpr int kSearchIndexMigration = 3;
+
+    // 返回 EXPLAIN QUERY PLAN 的 detail 列，用于检查查询是否命中索引
+    std::vector<std::string> ExplainQueryPlan(const std::string& sql);
+
+    const DatabaseOptions& GetOptions() const { return options_; }
+
+    // 本连接上共享的事件字典，首次调用时载入
+    EventCatalog& GetEventCatalog() { return *event_catalog_; }
+
+    // users.phone 的子串索引，首次调用时构建
+    PhoneTrigramIndex& GetPhoneIndex() { return *phone_index_; }
+
+    // 账单描述与批注的 FTS5 索引，由账单与批注仓库的写路径维护
+    BillSearchIndex& GetSearchIndex() { return *search_index_; }
+
+    // profile_statements 关闭时返回 nullptr
+    StatementProfiler* GetProfiler() { return profiler_.get(); }
+
+    // 在本连接上为排队的慢语句补做查询计划并写入慢查询日志；未开启剖析时什么也不做。
+    // 连接析构时也会调用一次
+    void FlushSlowLog();
+
+    // bill_rollup_daily 是本次启动新建的，需要从 bills 重建一次
+    bool NeedsRollupRebuild() const { return rollups_created_; }
     
 private:
+    struct SharedConnection {};
+    DatabaseORM(DatabaseORM& primary, SharedConnection);
+
+    // 编号连续递增的前向迁移。已发布的迁移不再修改；改动 CreateStorage 中的表结构时在末尾追加一条
+    struct Migration {
+        int version;
+        bool transactional;                     // 与 user_version 的更新在同一事务中提交
+        void (DatabaseORM::*apply)(sqlite3* db);
+    };
+    static const std::vector<Migration>& Migrations();
+
+    // 1：以 sync_schema 建立（或对齐）CreateStorage 描述的全部表与索引，含旧版金额列的转换
+    void MigrateBaseline(sqlite3* db);
+    // 2：idx_bills_created_event 已由覆盖索引 idx_bills_created_cover 取代，旧库上删掉以免写入时继续维护
+    void DropCreatedEventIndex(sqlite3* db);
+    // 3：建立 trigram 分词的 bill_search 并全量填充，替换旧版 unicode61 分词的表；SQLite 不支持时跳过
+    void BuildSearchIndex(sqlite3* db);
+
+    void ApplyOptions(sqlite3* db) const;
+
     Storage storage_;
     std::string db_path_;
-};
\ No newline at end of file
+    DatabaseOptions options_;
+    bool rollups_created_ = false;
+    // 以下三者由 OpenConnection 打开的连接共享
+    std::shared_ptr<StatementProfiler> profiler_;
+    std::shared_ptr<EventCatalog> event_catalog_;
+    std::shared_ptr<PhoneTrigramIndex> phone_index_;
+    std::unique_ptr<BillSearchIndex> search_index_;
+};
+
+// 直接使用 sqlite3 语句句柄的查询，供需要自定义行映射的路径（如 pmr 结果集、FTS5）使用。
+// 持有一个连接引用，语句只准备一次，析构时 finalize。
+class RawStatement {
+public:
+    RawStatement(Storage& storage, const std::string& sql);
+    ~RawStatement();
+
+    RawStatement(const RawStatement&) = delete;
+    RawStatement& operator=(const RawStatement&) = delete;
+
+    // 重置语句并按顺序绑定 ?1, ?2, ...
+    void Bind(std::initializer_list<int64_t> params);
+    // 在 Bind 之后绑定文本参数 ?index
+    void BindText(int index, const std::string& value);
+
+    // 前进一行，返回 false 表示结束；出错时抛出 std::runtime_error
+    bool Step();
+
+    sqlite3_stmt* Get() const { return stmt_; }
+
+private:
+    decltype(std::declval<Storage&>().get_connection()) con_;
+    sqlite3_stmt* stmt_ = nullptr;
+};
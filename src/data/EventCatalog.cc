@@ -0,0 +1,108 @@
+#include "EventCatalog.h"
+
+using namespace orm;
+
+void EventCatalog::EnsureLoaded() {
+    std::call_once(loaded_, [this] {
+        auto events = storage_.get_all<model::Event>();
+        std::unique_lock<std::shared_mutex> lock(mutex_);
+        for (const auto& e : events) {
+            PutLocked(e);
+        }
+    });
+}
+
+const model::Event* EventCatalog::GetLocked(int id) const {
+    if (id <= 0 || static_cast<size_t>(id) >= by_id_.size() || by_id_[id].id == 0) {
+        return nullptr;
+    }
+    return &by_id_[id];
+}
+
+void EventCatalog::PutLocked(const model::Event& e) {
+    if (e.id <= 0) {
+        return;
+    }
+    if (static_cast<size_t>(e.id) >= by_id_.size()) {
+        by_id_.resize(static_cast<size_t>(e.id) + 1);
+    }
+    // 改名时去掉旧名称
+    auto& slot = by_id_[e.id];
+    if (slot.id != 0 && slot.name != e.name) {
+        by_name_.erase(slot.name);
+    }
+    slot = e;
+    by_name_[e.name] = e.id;
+}
+
+std::optional<model::Event> EventCatalog::FindById(int id) {
+    EnsureLoaded();
+    {
+        std::shared_lock<std::shared_mutex> lock(mutex_);
+        if (auto e = GetLocked(id)) {
+            return *e;
+        }
+    }
+    if (id <= 0) {
+        return std::nullopt;
+    }
+
+    auto e = storage_.get_optional<model::Event>(id);
+    if (e.has_value()) {
+        Put(*e);
+    }
+    return e;
+}
+
+std::optional<model::Event> EventCatalog::FindByName(const std::string& name) {
+    EnsureLoaded();
+    {
+        std::shared_lock<std::shared_mutex> lock(mutex_);
+        auto it = by_name_.find(name);
+        if (it != by_name_.end()) {
+            return *GetLocked(it->second);
+        }
+    }
+
+    auto events = storage_.get_all<model::Event>(where(c(&model::Event::name) == name));
+    if (events.empty()) {
+        return std::nullopt;
+    }
+    Put(events[0]);
+    return events[0];
+}
+
+std::optional<int> EventCatalog::IdOf(const std::string& name) {
+    auto e = FindByName(name);
+    if (!e.has_value()) {
+        return std::nullopt;
+    }
+    return e->id;
+}
+
+bool EventCatalog::IsFrozen(int id) {
+    auto e = FindById(id);
+    return e.has_value() && e->status == model::EventStatus::Frozen;
+}
+
+void EventCatalog::Put(const model::Event& e) {
+    EnsureLoaded();
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    PutLocked(e);
+}
+
+bool EventCatalog::SetStatus(int id, int status) {
+    EnsureLoaded();
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    if (!GetLocked(id)) {
+        return false;
+    }
+    by_id_[id].status = status;
+    return true;
+}
+
+size_t EventCatalog::Size() {
+    EnsureLoaded();
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    return by_name_.size();
+}
@@ -0,0 +1,43 @@
+#pragma once
+#include "DatabaseORM.h"
+#include <mutex>
+#include <optional>
+#include <shared_mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// 进程内的事件字典：按 id 下标存放的稠密数组 + 名称到 id 的哈希表。
+// 首次使用时从 events 表整体载入，之后由 EventRepositoryImpl 的写路径保持同步。
+// 未命中时回查一次数据库，用来接住其他连接新建的事件。
+class EventCatalog {
+public:
+    explicit EventCatalog(Storage& storage) : storage_(storage) {}
+
+    EventCatalog(const EventCatalog&) = delete;
+    EventCatalog& operator=(const EventCatalog&) = delete;
+
+    std::optional<model::Event> FindById(int id);
+    std::optional<model::Event> FindByName(const std::string& name);
+    std::optional<int> IdOf(const std::string& name);
+
+    bool IsFrozen(int id);
+
+    // 写入数据库成功后调用
+    void Put(const model::Event& e);
+    bool SetStatus(int id, int status);
+
+    size_t Size();
+
+private:
+    void EnsureLoaded();
+    void PutLocked(const model::Event& e);
+    const model::Event* GetLocked(int id) const;
+
+    Storage& storage_;
+    std::once_flag loaded_;
+
+    std::shared_mutex mutex_;
+    std::vector<model::Event> by_id_; // 下标即 id，id 为 0 的位置为空
+    std::unordered_map<std::string, int> by_name_;
+};
@@ -1,70 +1,82 @@
 #include "EventRepositoryImpl.h"
+#include "Metrics.h"
+#include "EventCatalog.h"
 
 using namespace sqlite_orm;
 
-void EventRepositoryImpl::save(const model::Event& e) {
+int EventRepositoryImpl::save(const model::Event& e) {
+    METRICS_SCOPE(timer, "EventRepository.save");
     auto& storage = db_->GetStorage();
     
+    model::Event saved = e;
     if (e.id == 0) {
         // 插入新事件
-        model::Event event_copy = e;
-        event_copy.id = storage.insert(event_copy);
+        saved.id = storage.insert(e);
     } else {
-        // 更新现有事件
+        // 更新现有事件，记录不存在时不写入字典
         storage.update(e);
+        if (storage.changes() == 0) {
+            return e.id;
+        }
     }
+    db_->GetEventCatalog().Put(saved);
+    return saved.id;
 }
 
 std::optional<model::Event> EventRepositoryImpl::findById(int id) {
-    auto& storage = db_->GetStorage();
-    
+    METRICS_SCOPE(timer, "EventRepository.findById");
     try {
-        auto event = storage.get<model::Event>(id);
-        return event;
-    } catch (const std::system_error&) {
-        // 记录未找到
-        return std::nullopt;
+        return timer.Counted(db_->GetEventCatalog().FindById(id));
     } catch (const std::exception& ex) {
-        // 其他错误
+        timer.Fail();
         return std::nullopt;
     }
 }
 
 std::optional<model::Event> EventRepositoryImpl::findByName(const std::string& name) {
-    auto& storage = db_->GetStorage();
-    
+    METRICS_SCOPE(timer, "EventRepository.findByName");
     try {
-        auto events = storage.get_all<model::Event>(
-            where(c(&model::Event::name) == name)
-        );
-        
-        if (events.empty()) {
-            return std::nullopt;
-        }
-        
-        return events[0];
+        return timer.Counted(db_->GetEventCatalog().FindByName(name));
     } catch (const std::exception& ex) {
+        timer.Fail();
         return std::nullopt;
     }
 }
 
+bool EventRepositoryImpl::isFrozen(int id) {
+    METRICS_SCOPE(timer, "EventRepository.isFrozen");
+    try {
+        return db_->GetEventCatalog().IsFrozen(id);
+    } catch (const std::exception& ex) {
+        timer.Fail();
+        return false;
+    }
+}
+
 bool EventRepositoryImpl::setStatusById(int id, int status) {
+    METRICS_SCOPE(timer, "EventRepository.setStatusById");
     auto& storage = db_->GetStorage();
+    auto& catalog = db_->GetEventCatalog();
     
     try {
-        // 先查找事件
-        auto event_opt = findById(id);
-        if (!event_opt.has_value()) {
+        // 存在性由字典判断，数据库只执行一条 UPDATE
+        if (!catalog.FindById(id).has_value()) {
             return false;
         }
         
-        // 更新状态
-        auto event = event_opt.value();
-        event.status = status;
-        storage.update(event);
+        storage.update_all(
+            set(c(&model::Event::status) = status),
+            where(c(&model::Event::id) == id)
+        );
+        // 记录已被其他连接删除时字典仍有旧条目，与 save 一样以实际更新的行数为准
+        if (storage.changes() == 0) {
+            return false;
+        }
+        catalog.SetStatus(id, status);
         
         return true;
     } catch (const std::exception& ex) {
+        timer.Fail();
         return false;
     }
-}
\ No newline at end of file
+}
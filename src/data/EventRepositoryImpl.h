@@ -7,10 +7,11 @@ class EventRepositoryImpl : public repo::IEventRepository {
 public:
     explicit EventRepositoryImpl(std::shared_ptr<DatabaseORM> db) : db_(db) {}
     
-    void save(const model::Event& e) override;
+    int save(const model::Event& e) override;
     std::optional<model::Event> findById(int id) override;
     std::optional<model::Event> findByName(const std::string& name) override;
     bool setStatusById(int id, int status) override;
+    bool isFrozen(int id) override;
     
 private:
     std::shared_ptr<DatabaseORM> db_;
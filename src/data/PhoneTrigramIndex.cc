@@ -0,0 +1,133 @@
+#include "PhoneTrigramIndex.h"
+
+#include <algorithm>
+
+using namespace orm;
+
+std::vector<PhoneTrigramIndex::Trigram> PhoneTrigramIndex::Trigrams(const std::string& s) {
+    std::vector<Trigram> grams;
+    if (s.size() < 3) {
+        return grams;
+    }
+    grams.reserve(s.size() - 2);
+    for (size_t i = 0; i + 3 <= s.size(); ++i) {
+        grams.push_back(static_cast<Trigram>(static_cast<unsigned char>(s[i])) << 16 |
+                        static_cast<Trigram>(static_cast<unsigned char>(s[i + 1])) << 8 |
+                        static_cast<Trigram>(static_cast<unsigned char>(s[i + 2])));
+    }
+    // 同一手机号中重复的三元组只记一次
+    std::sort(grams.begin(), grams.end());
+    grams.erase(std::unique(grams.begin(), grams.end()), grams.end());
+    return grams;
+}
+
+void PhoneTrigramIndex::EnsureLoaded() {
+    std::call_once(loaded_, [this] {
+        auto rows = storage_.select(columns(&model::User::id, &model::User::phone),
+                                    order_by(&model::User::id));
+        std::unique_lock<std::shared_mutex> lock(mutex_);
+        for (auto& row : rows) {
+            PutLocked(std::get<0>(row), std::get<1>(row));
+        }
+    });
+}
+
+void PhoneTrigramIndex::RemoveLocked(int id) {
+    if (static_cast<size_t>(id) >= phones_.size() || phones_[id].empty()) {
+        return;
+    }
+    for (auto gram : Trigrams(phones_[id])) {
+        auto it = postings_.find(gram);
+        if (it == postings_.end()) {
+            continue;
+        }
+        auto& list = it->second;
+        auto pos = std::lower_bound(list.begin(), list.end(), id);
+        if (pos != list.end() && *pos == id) {
+            list.erase(pos);
+        }
+        if (list.empty()) {
+            postings_.erase(it);
+        }
+    }
+    phones_[id].clear();
+    --size_;
+}
+
+void PhoneTrigramIndex::PutLocked(int id, const std::string& phone) {
+    if (id <= 0) {
+        return;
+    }
+    if (static_cast<size_t>(id) >= phones_.size()) {
+        phones_.resize(static_cast<size_t>(id) + 1);
+    }
+    if (phones_[id] == phone) {
+        return;
+    }
+    RemoveLocked(id);
+    if (phone.empty()) {
+        return;
+    }
+
+    phones_[id] = phone;
+    ++size_;
+    for (auto gram : Trigrams(phone)) {
+        auto& list = postings_[gram];
+        // 新用户 id 递增，通常直接追加
+        if (list.empty() || list.back() < id) {
+            list.push_back(id);
+        } else {
+            list.insert(std::lower_bound(list.begin(), list.end(), id), id);
+        }
+    }
+}
+
+void PhoneTrigramIndex::Put(int id, const std::string& phone) {
+    EnsureLoaded();
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    PutLocked(id, phone);
+}
+
+std::vector<int> PhoneTrigramIndex::Search(const std::string& partial) {
+    EnsureLoaded();
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    std::vector<int> ids;
+    if (partial.empty()) {
+        return ids;
+    }
+
+    // 关键字太短，没有三元组可用
+    if (partial.size() < 3) {
+        for (size_t id = 1; id < phones_.size(); ++id) {
+            if (!phones_[id].empty() && phones_[id].find(partial) != std::string::npos) {
+                ids.push_back(static_cast<int>(id));
+            }
+        }
+        return ids;
+    }
+
+    const std::vector<int>* shortest = nullptr;
+    for (auto gram : Trigrams(partial)) {
+        auto it = postings_.find(gram);
+        if (it == postings_.end()) {
+            return ids;
+        }
+        if (!shortest || it->second.size() < shortest->size()) {
+            shortest = &it->second;
+        }
+    }
+
+    // 三元组全部命中不代表相邻，逐个核对
+    for (int id : *shortest) {
+        if (phones_[id].find(partial) != std::string::npos) {
+            ids.push_back(id);
+        }
+    }
+    return ids;
+}
+
+size_t PhoneTrigramIndex::Size() {
+    EnsureLoaded();
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    return size_;
+}
@@ -0,0 +1,44 @@
+#pragma once
+#include "DatabaseORM.h"
+#include <cstdint>
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// users.phone 的内存三元组倒排索引，替代 LIKE '%partial%' 全表扫描。
+// 每个手机号的所有 3 字节子串各对应一个按 id 升序的倒排表；查询时取
+// 关键字各三元组中最短的倒排表，再逐个核对子串。不足 3 字节的关键字
+// 直接扫描内存中的手机号。首次使用时从 users 表载入，由 UserRepositoryImpl 的写路径保持同步。
+class PhoneTrigramIndex {
+public:
+    explicit PhoneTrigramIndex(Storage& storage) : storage_(storage) {}
+
+    PhoneTrigramIndex(const PhoneTrigramIndex&) = delete;
+    PhoneTrigramIndex& operator=(const PhoneTrigramIndex&) = delete;
+
+    // 返回手机号包含 partial 的用户 id，按 id 升序
+    std::vector<int> Search(const std::string& partial);
+
+    // 写入数据库成功后调用，手机号变化时替换旧的倒排项
+    void Put(int id, const std::string& phone);
+
+    size_t Size();
+
+private:
+    using Trigram = uint32_t;
+    static std::vector<Trigram> Trigrams(const std::string& s);
+
+    void EnsureLoaded();
+    void PutLocked(int id, const std::string& phone);
+    void RemoveLocked(int id);
+
+    Storage& storage_;
+    std::once_flag loaded_;
+
+    std::shared_mutex mutex_;
+    std::vector<std::string> phones_; // 下标即用户 id，空串表示无此用户
+    std::unordered_map<Trigram, std::vector<int>> postings_;
+    size_t size_ = 0;
+};
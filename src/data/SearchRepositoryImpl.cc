@@ -0,0 +1,11 @@
+#include "SearchRepositoryImpl.h"
+#include "Metrics.h"
+#include "BillSearchIndex.h"
+
+model::SearchPage SearchRepositoryImpl::search(const std::string& match, const std::vector<std::string>& substrings,
+                                               int ownerId, int offset, int limit) {
+    METRICS_SCOPE(timer, "SearchRepository.search");
+    auto page = db_->GetSearchIndex().Search(match, substrings, ownerId, offset, limit);
+    timer.Rows(page.bills.size());
+    return page;
+}
@@ -0,0 +1,15 @@
+#pragma once
+#include "irepositories.h"
+#include "DatabaseORM.h"
+#include <memory>
+
+class SearchRepositoryImpl : public repo::ISearchRepository {
+public:
+    explicit SearchRepositoryImpl(std::shared_ptr<DatabaseORM> db) : db_(db) {}
+
+    model::SearchPage search(const std::string& match, const std::vector<std::string>& substrings,
+                             int ownerId, int offset, int limit) override;
+
+private:
+    std::shared_ptr<DatabaseORM> db_;
+};
@@ -0,0 +1,365 @@
+#include "StatementProfiler.h"
+#include <algorithm>
+#include <cctype>
+#include <cstring>
+#include <ctime>
+#include <iomanip>
+#include <optional>
+#include <ostream>
+
+namespace {
+
+// FlushSlowLog 执行的 EXPLAIN 也会触发回调，期间忽略
+thread_local bool in_profiler = false;
+
+// 原始 SQL -> 归一化 SQL 的缓存上限，超过后整体清空
+constexpr size_t kMaxNormalizedCache = 4096;
+
+// 两次 FlushSlowLog 之间最多排队的慢语句数
+constexpr size_t kMaxPendingSlow = 1024;
+
+// 正在执行的语句：STMT 事件时开始计时，ROW 事件计数，PROFILE 事件结束。
+// 一条语句从开始到结束都在同一线程上 step，按线程保存即可免去 STMT / ROW 事件上的加锁；
+// 以语句指针为键，同一线程上交错执行的多条语句互不影响
+struct Running {
+    uint64_t start_ticks = 0;
+    uint64_t rows = 0;
+};
+thread_local std::unordered_map<sqlite3_stmt*, Running> running;
+
+bool IsIdentifierChar(char c) {
+    return std::isalnum(static_cast<unsigned char>(c)) || c == '_' || (c & 0x80);
+}
+
+bool EndsWith(const std::string& s, const char* suffix) {
+    size_t n = std::strlen(suffix);
+    return s.size() >= n && s.compare(s.size() - n, n, suffix) == 0;
+}
+
+// 追加一个参数占位符；紧跟在 "?, " 之后时并入前一个，使 IN (?, ?, ?) 与 IN (?) 归为同一条
+void AppendPlaceholder(std::string& out) {
+    for (const char* list : {"?, ", "?,"}) {
+        if (EndsWith(out, list)) {
+            out.resize(out.size() - std::strlen(list) + 1);
+            return;
+        }
+    }
+    out += '?';
+}
+
+// 多行 VALUES (?), (?), ... 同样合并为一组
+void AppendCloseParen(std::string& out) {
+    out += ')';
+    for (const char* rows : {"(?), (?)", "(?),(?)"}) {
+        if (EndsWith(out, rows)) {
+            out.resize(out.size() - std::strlen(rows) + 3);
+            return;
+        }
+    }
+}
+
+bool StartsWithKeyword(const std::string& sql, const char* keyword) {
+    size_t n = std::strlen(keyword);
+    if (sql.size() < n) {
+        return false;
+    }
+    for (size_t i = 0; i < n; ++i) {
+        if (std::toupper(static_cast<unsigned char>(sql[i])) != keyword[i]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// 带实际参数的 SQL，便于直接复现
+std::string ExpandedSql(sqlite3_stmt* stmt) {
+    std::string sql;
+    if (char* expanded = sqlite3_expanded_sql(stmt)) {
+        sql = expanded;
+        sqlite3_free(expanded);
+    } else {
+        sql = sqlite3_sql(stmt);
+    }
+    while (!sql.empty() && (sql.back() == ';' || std::isspace(static_cast<unsigned char>(sql.back())))) {
+        sql.pop_back();
+    }
+    return sql;
+}
+
+std::vector<std::string> ExplainPlan(sqlite3* db, const char* sql) {
+    std::vector<std::string> plan;
+    sqlite3_stmt* stmt = nullptr;
+    std::string explain = std::string("EXPLAIN QUERY PLAN ") + sql;
+    if (sqlite3_prepare_v2(db, explain.c_str(), -1, &stmt, nullptr) != SQLITE_OK) {
+        // DDL、事务控制等语句没有查询计划
+        sqlite3_finalize(stmt);
+        return plan;
+    }
+    while (sqlite3_step(stmt) == SQLITE_ROW) {
+        // 列依次为 id, parent, notused, detail
+        auto text = sqlite3_column_text(stmt, 3);
+        plan.emplace_back(text ? reinterpret_cast<const char*>(text) : "");
+    }
+    sqlite3_finalize(stmt);
+    return plan;
+}
+
+}
+
+StatementProfiler::StatementProfiler(Options options) : options_(std::move(options)) {
+    // 先完成刻度校准，避免第一次回调时停顿约 10ms
+    metrics::NsPerTick();
+    if (!options_.slow_query_log.empty()) {
+        slow_log_.open(options_.slow_query_log, std::ios::app);
+    }
+}
+
+void StatementProfiler::Attach(sqlite3* db) {
+    sqlite3_trace_v2(db, SQLITE_TRACE_STMT | SQLITE_TRACE_ROW | SQLITE_TRACE_PROFILE, &StatementProfiler::OnTrace,
+                     this);
+}
+
+void StatementProfiler::Detach(sqlite3* db) {
+    sqlite3_trace_v2(db, 0, nullptr, nullptr);
+}
+
+int StatementProfiler::OnTrace(unsigned type, void* context, void* p, void* x) {
+    if (in_profiler) {
+        return 0;
+    }
+    auto* self = static_cast<StatementProfiler*>(context);
+    auto* stmt = static_cast<sqlite3_stmt*>(p);
+    switch (type) {
+        case SQLITE_TRACE_STMT: {
+            // 触发器内的子语句以 "--" 开头，耗时计入外层语句
+            auto* text = static_cast<const char*>(x);
+            if (text != nullptr && std::strncmp(text, "--", 2) == 0) {
+                break;
+            }
+            running[stmt] = Running{metrics::Ticks(), 0};
+            break;
+        }
+        case SQLITE_TRACE_ROW: {
+            auto it = running.find(stmt);
+            if (it != running.end()) {
+                ++it->second.rows;
+            }
+            break;
+        }
+        case SQLITE_TRACE_PROFILE:
+            // SQLite 给出的耗时只有毫秒精度，仅在缺少 STMT 事件时使用
+            self->Finish(stmt, *static_cast<sqlite3_int64*>(x));
+            break;
+        default:
+            break;
+    }
+    return 0;
+}
+
+void StatementProfiler::Finish(sqlite3_stmt* stmt, int64_t sqlite_ns) {
+    const uint64_t now = metrics::Ticks();
+    const char* sql = sqlite3_sql(stmt);
+    if (sql == nullptr) {
+        return;
+    }
+
+    uint64_t elapsed_ns = static_cast<uint64_t>(std::max<int64_t>(sqlite_ns, 0));
+    uint64_t rows = 0;
+    auto started = running.find(stmt);
+    if (started != running.end()) {
+        elapsed_ns = static_cast<uint64_t>(static_cast<double>(now - started->second.start_ticks) *
+                                           metrics::NsPerTick());
+        rows = started->second.rows;
+        running.erase(started);
+    }
+
+    // 回调中只记下语句文本，查询计划留给 FlushSlowLog：在正在 step 的连接上再 prepare 语句不安全
+    std::optional<SlowQuery> slow;
+    if (slow_log_.is_open() && static_cast<double>(elapsed_ns) >= options_.slow_query_ms * 1e6) {
+        slow = SlowQuery{sql, ExpandedSql(stmt), elapsed_ns, 0, std::time(nullptr)};
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto cached = normalized_.find(sql);
+    if (cached == normalized_.end()) {
+        if (normalized_.size() >= kMaxNormalizedCache) {
+            normalized_.clear();
+        }
+        cached = normalized_.emplace(sql, NormalizeSql(sql)).first;
+    }
+    const std::string& key = cached->second;
+
+    // 写语句没有结果行，改记影响的行数
+    if (rows == 0 && (StartsWithKeyword(key, "INSERT") || StartsWithKeyword(key, "UPDATE") ||
+                      StartsWithKeyword(key, "DELETE") || StartsWithKeyword(key, "REPLACE"))) {
+        rows = static_cast<uint64_t>(sqlite3_changes(sqlite3_db_handle(stmt)));
+    }
+
+    auto& s = stats_[key];
+    if (s.buckets.empty()) {
+        s.name = key;
+        s.buckets.assign(metrics::kBuckets, 0);
+    }
+    ++s.calls;
+    s.rows += rows;
+    s.total_ns += elapsed_ns;
+    s.max_ns = std::max(s.max_ns, elapsed_ns);
+    ++s.buckets[metrics::BucketOf(elapsed_ns)];
+
+    if (slow) {
+        if (pending_slow_.size() < kMaxPendingSlow) {
+            slow->rows = rows;
+            pending_slow_.push_back(std::move(*slow));
+        } else {
+            ++dropped_slow_;
+        }
+    }
+}
+
+void StatementProfiler::FlushSlowLog(sqlite3* db) {
+    std::vector<SlowQuery> pending;
+    uint64_t dropped = 0;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        pending.swap(pending_slow_);
+        std::swap(dropped, dropped_slow_);
+    }
+    if (pending.empty() && dropped == 0) {
+        return;
+    }
+
+    // EXPLAIN 本身也会触发回调，期间忽略
+    std::vector<std::vector<std::string>> plans;
+    plans.reserve(pending.size());
+    in_profiler = true;
+    for (const auto& query : pending) {
+        plans.push_back(ExplainPlan(db, query.sql.c_str()));
+    }
+    in_profiler = false;
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (size_t i = 0; i < pending.size(); ++i) {
+        const auto& query = pending[i];
+        slow_log_ << "-- " << std::put_time(std::localtime(&query.finished_at), "%Y-%m-%d %H:%M:%S")
+                  << " | " << std::fixed << std::setprecision(3) << static_cast<double>(query.elapsed_ns) / 1e6
+                  << " ms | rows " << query.rows << '\n'
+                  << query.expanded_sql << ";\n";
+        for (const auto& detail : plans[i]) {
+            slow_log_ << "--   " << detail << '\n';
+        }
+        slow_log_ << '\n';
+    }
+    if (dropped > 0) {
+        slow_log_ << "-- 另有 " << dropped << " 条慢语句因队列已满未记录\n\n";
+    }
+    slow_log_.flush();
+}
+
+std::vector<metrics::MetricSnapshot> StatementProfiler::Snapshot() const {
+    std::vector<metrics::MetricSnapshot> result;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        result.reserve(stats_.size());
+        for (const auto& entry : stats_) {
+            result.push_back(entry.second);
+        }
+    }
+    std::sort(result.begin(), result.end(), [](const metrics::MetricSnapshot& a, const metrics::MetricSnapshot& b) {
+        return a.total_ns != b.total_ns ? a.total_ns > b.total_ns : a.name < b.name;
+    });
+    return result;
+}
+
+void StatementProfiler::Dump(std::ostream& out) const {
+    auto us = [](double ns) { return ns / 1000.0; };
+    out << std::right << std::setw(10) << "calls" << std::setw(12) << "rows" << std::setw(14) << "total_us"
+        << std::setw(12) << "mean_us" << std::setw(12) << "p50_us" << std::setw(12) << "p99_us"
+        << std::setw(12) << "max_us" << "  sql\n";
+    out << std::fixed << std::setprecision(1);
+    for (const auto& s : Snapshot()) {
+        out << std::setw(10) << s.calls << std::setw(12) << s.rows
+            << std::setw(14) << us(static_cast<double>(s.total_ns))
+            << std::setw(12) << us(s.MeanNs())
+            << std::setw(12) << us(static_cast<double>(s.PercentileNs(0.50)))
+            << std::setw(12) << us(static_cast<double>(s.PercentileNs(0.99)))
+            << std::setw(12) << us(static_cast<double>(s.max_ns)) << "  " << s.name << '\n';
+    }
+    out.flush();
+}
+
+void StatementProfiler::Reset() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stats_.clear();
+}
+
+std::string StatementProfiler::NormalizeSql(const std::string& sql) {
+    std::string out;
+    out.reserve(sql.size());
+    bool pending_space = false;
+    size_t i = 0;
+    const size_t n = sql.size();
+    while (i < n) {
+        char c = sql[i];
+        if (std::isspace(static_cast<unsigned char>(c))) {
+            pending_space = !out.empty();
+            ++i;
+            continue;
+        }
+        if (pending_space) {
+            out += ' ';
+            pending_space = false;
+        }
+
+        const bool after_identifier = !out.empty() && IsIdentifierChar(out.back());
+        if (c == '\'' || ((c == 'x' || c == 'X') && !after_identifier && i + 1 < n && sql[i + 1] == '\'')) {
+            // 字符串与 BLOB 字面量，'' 为转义的单引号
+            i += c == '\'' ? 1 : 2;
+            while (i < n) {
+                if (sql[i] == '\'' && !(i + 1 < n && sql[i + 1] == '\'')) {
+                    ++i;
+                    break;
+                }
+                i += sql[i] == '\'' ? 2 : 1;
+            }
+            AppendPlaceholder(out);
+        } else if (c == '"' || c == '`' || c == '[') {
+            // 带引号的标识符原样保留
+            char close = c == '[' ? ']' : c;
+            size_t end = sql.find(close, i + 1);
+            end = end == std::string::npos ? n : end + 1;
+            out.append(sql, i, end - i);
+            i = end;
+        } else if (!after_identifier && (std::isdigit(static_cast<unsigned char>(c)) ||
+                                         (c == '.' && i + 1 < n && std::isdigit(static_cast<unsigned char>(sql[i + 1]))))) {
+            // 数值字面量，含小数、十六进制与指数
+            ++i;
+            while (i < n && (IsIdentifierChar(sql[i]) || sql[i] == '.' ||
+                             ((sql[i] == '+' || sql[i] == '-') && (sql[i - 1] == 'e' || sql[i - 1] == 'E')))) {
+                ++i;
+            }
+            AppendPlaceholder(out);
+        } else if (c == '?' || ((c == ':' || c == '@' || c == '$') && i + 1 < n && IsIdentifierChar(sql[i + 1]))) {
+            // ?NNN、:name、@name、$name
+            ++i;
+            while (i < n && IsIdentifierChar(sql[i])) {
+                ++i;
+            }
+            AppendPlaceholder(out);
+        } else if (IsIdentifierChar(c)) {
+            while (i < n && IsIdentifierChar(sql[i])) {
+                out += sql[i++];
+            }
+        } else if (c == ')') {
+            AppendCloseParen(out);
+            ++i;
+        } else {
+            out += c;
+            ++i;
+        }
+    }
+    // 去掉末尾的分号
+    while (!out.empty() && (out.back() == ';' || out.back() == ' ')) {
+        out.pop_back();
+    }
+    return out;
+}
@@ -0,0 +1,67 @@
+#pragma once
+#include "Metrics.h"
+#include <sqlite3.h>
+#include <cstdint>
+#include <ctime>
+#include <fstream>
+#include <iosfwd>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// 基于 sqlite3_trace_v2 的语句级剖析：按归一化后的 SQL 汇总执行次数、耗时分布与返回行数，
+// 超过阈值的语句先在回调中排队，由 FlushSlowLog 在回调之外补做 EXPLAIN QUERY PLAN 后写入慢查询日志。
+// 一个实例可挂到多个连接上；STMT / ROW 回调只访问本线程的状态，语句结束时加一次锁汇总。
+class StatementProfiler {
+public:
+    struct Options {
+        double slow_query_ms = 100.0;   // 不低于该耗时的语句写入慢查询日志
+        std::string slow_query_log;     // 慢查询日志路径（追加写），空串表示不写
+    };
+
+    explicit StatementProfiler(Options options);
+
+    StatementProfiler(const StatementProfiler&) = delete;
+    StatementProfiler& operator=(const StatementProfiler&) = delete;
+
+    // 在连接上注册 STMT / ROW / PROFILE 回调；Detach 取消注册
+    void Attach(sqlite3* db);
+    static void Detach(sqlite3* db);
+
+    // 在 db 上为排队的慢语句执行 EXPLAIN QUERY PLAN 并写入日志。不能在 trace 回调中调用；
+    // db 须与产生这些语句的连接打开同一个数据库
+    void FlushSlowLog(sqlite3* db);
+
+    // 每条归一化 SQL 一项，name 为 SQL 文本，按总耗时降序；errors 恒为 0
+    std::vector<metrics::MetricSnapshot> Snapshot() const;
+
+    // 以表格形式输出 Snapshot，时间单位为微秒
+    void Dump(std::ostream& out) const;
+
+    void Reset();
+
+    // 字面量与参数统一替换为 ?，IN 列表等连续的 ?, ?, ... 合并为一个 ?，空白压缩为单个空格
+    static std::string NormalizeSql(const std::string& sql);
+
+private:
+    // 等待补做查询计划的慢语句
+    struct SlowQuery {
+        std::string sql;            // sqlite3_sql，用于 EXPLAIN
+        std::string expanded_sql;   // 带实际参数，写入日志
+        uint64_t elapsed_ns = 0;
+        uint64_t rows = 0;
+        std::time_t finished_at = 0;
+    };
+
+    static int OnTrace(unsigned type, void* context, void* p, void* x);
+    void Finish(sqlite3_stmt* stmt, int64_t sqlite_ns);
+
+    Options options_;
+    mutable std::mutex mutex_;
+    std::unordered_map<std::string, std::string> normalized_;          // 原始 SQL -> 归一化 SQL
+    std::unordered_map<std::string, metrics::MetricSnapshot> stats_;   // 归一化 SQL -> 汇总
+    std::vector<SlowQuery> pending_slow_;
+    uint64_t dropped_slow_ = 0;   // 队列已满时丢弃的慢语句数
+    std::ofstream slow_log_;
+};
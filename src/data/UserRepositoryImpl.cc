@@ -1,41 +1,71 @@
 #include "UserRepositoryImpl.h"
+#include "Metrics.h"
+#include "PhoneTrigramIndex.h"
+#include <algorithm>
 
 using namespace orm;
 
-void UserRepositoryImpl::save(const model::User& u) {
+namespace {
+
+// 按 id 取回用户时每条语句绑定的参数个数，低于 SQLITE_MAX_VARIABLE_NUMBER
+constexpr size_t kIdsPerQuery = 500;
+
+}
+
+int UserRepositoryImpl::save(const model::User& u) {
+    METRICS_SCOPE(timer, "UserRepository.save");
+    int id = u.id;
     if (u.id == 0) {
-        db_->GetStorage().insert(u);
+        id = db_->GetStorage().insert(u);
     } else {
         db_->GetStorage().update(u);
-    }    
+    }
+    db_->GetPhoneIndex().Put(id, u.phone);
+    return id;
 }
 
 std::optional<model::User> UserRepositoryImpl::findById(int id) {
+    METRICS_SCOPE(timer, "UserRepository.findById");
     if (id <= 0) {
         return std::nullopt;
     } 
 
-    return db_->GetStorage().get_optional<model::User>(id);
+    return timer.Counted(db_->GetStorage().get_optional<model::User>(id));
 }
 
 std::optional<model::User> UserRepositoryImpl::queryByPhone(const std::string& phone) {
+    METRICS_SCOPE(timer, "UserRepository.queryByPhone");
     if (phone.empty()) {
         return std::nullopt;
     }
 
     auto users = db_->GetStorage().get_all_optional<model::User>(where(c(&model::User::phone) == phone));
-    return users.empty() ? std::nullopt : users[0];
+    return timer.Counted(users.empty() ? std::nullopt : users[0]);
 }
 
 std::vector<model::User> UserRepositoryImpl::queryByPhonePartial(const std::string& partial) {
+    METRICS_SCOPE(timer, "UserRepository.queryByPhonePartial");
     if (partial.empty()) {
         return {};
     }
 
-    return db_->GetStorage().get_all<model::User>(where(like(&model::User::phone, "%" + partial + "%")));
+    // 子串匹配由三元组索引完成，数据库只按主键取行
+    auto ids = db_->GetPhoneIndex().Search(partial);
+    std::vector<model::User> users;
+    users.reserve(ids.size());
+    for (size_t begin = 0; begin < ids.size(); begin += kIdsPerQuery) {
+        std::vector<int> chunk(ids.begin() + begin, ids.begin() + std::min(ids.size(), begin + kIdsPerQuery));
+        auto rows = db_->GetStorage().get_all<model::User>(
+            where(in(&model::User::id, chunk)),
+            order_by(&model::User::id));
+        std::move(rows.begin(), rows.end(), std::back_inserter(users));
+    }
+    timer.Rows(users.size());
+    return users;
 }
 
-bool UserRepositoryImpl::setBalanceByPhone(const std::string& phone, double balance) {
+bool UserRepositoryImpl::setBalanceByPhone(const std::string& phone, model::Money balance) {
+    METRICS_SCOPE(timer, "UserRepository.setBalanceByPhone");
     if (phone.empty()) {
         return false;
     }
@@ -5,55 +5,129 @@
 #include <optional>
 #include <memory>
 #include <map>
+#include <functional>
+#include <stdexcept>
+#include <string>
 
 // 声明了仓库接口，待数据层实现
 namespace repo {
 
     struct IUserRepository {
         virtual ~IUserRepository() = default;
-        virtual void save(const model::User& u) = 0;
+        virtual int save(const model::User& u) = 0; // 返回插入或更新的记录 id
 
         virtual std::optional<model::User> findById(int id) = 0; 
 
         virtual std::optional<model::User> queryByPhone(const std::string& phone) = 0; // 仅管理员可用
         virtual std::vector<model::User> queryByPhonePartial(const std::string& partial) = 0; // 仅管理员可用
 
-        virtual bool setBalanceByPhone(const std::string& phone, double balance) = 0; // 仅管理员可用
+        virtual bool setBalanceByPhone(const std::string& phone, model::Money balance) = 0; // 仅管理员可用
     };
 
-    struct IBillRepository {
-        virtual ~IBillRepository() = default;
-        virtual void save(const model::Bill& b) = 0;
-
-        virtual std::optional<model::Bill> findById(int id) = 0;
+    // 流式遍历回调，只带 bills 表本身的列；传入的引用只在回调期间有效，遍历中会被下一行覆盖
+    using BillVisitor = std::function<void(const model::BillRow&)>;
 
-        virtual std::vector<model::Bill> queryByEvent(int ownerId, int eventId) = 0;
-        virtual std::vector<model::Bill> queryByEvent(const std::string& name) = 0; // 仅管理员可用
-
-        virtual std::vector<model::Bill> queryByTime(int ownerId, model::Timestamp from, model::Timestamp to) = 0;
-        virtual std::vector<model::Bill> queryByTime(model::Timestamp from, model::Timestamp to) = 0; // 仅管理员可用
-
-        virtual std::vector<model::Bill> queryByPhone(const std::string& phone) = 0; // 仅管理员可用
+    // 异步写入结果：id 为分配的记录 id，durable 表示所在事务已提交，失败时 error 为原因
+    struct SaveResult {
+        int id = 0;
+        bool durable = false;
+        std::string error;
+    };
+    using SaveCallback = std::function<void(const SaveResult&)>;
 
-        virtual std::vector<model::Bill> queryByTimeInOrder(model::Timestamp from, model::Timestamp to) = 0; // 仅管理员可用
-        virtual std::vector<model::Bill> queryByTimeAndEventInOrder(model::Timestamp from, model::Timestamp to) = 0; // 仅管理员可用
+    struct IBillRepository {
+        virtual ~IBillRepository() = default;
+        virtual int save(const model::Bill& b) = 0; // 返回插入或更新的记录 id
+
+        // 提交后立即返回，结果通过 done 通知；默认实现同步写入，在调用线程回调
+        virtual void saveAsync(const model::Bill& b, SaveCallback done) {
+            SaveResult result;
+            try {
+                result.id = save(b);
+                result.durable = true;
+            } catch (const std::exception& e) {
+                result.error = e.what();
+            }
+            if (done) {
+                done(result);
+            }
+        }
+        virtual std::vector<int> saveBatch(const std::vector<model::Bill>& bills) = 0; // 单事务批量插入，返回新 id
+
+        virtual std::optional<model::Bill> findById(int id) = 0; // 唯一返回完整 Bill（含 event）的查询
+
+        // 列表查询只返回 BillRow 投影
+
+        virtual std::vector<model::BillRow> queryByEvent(int ownerId, int eventId) = 0;
+        virtual std::vector<model::BillRow> queryByEvent(const std::string& name) = 0; // 仅管理员可用
+
+        virtual std::vector<model::BillRow> queryByTime(int ownerId, model::Timestamp from, model::Timestamp to) = 0;
+        virtual std::vector<model::BillRow> queryByTime(model::Timestamp from, model::Timestamp to) = 0; // 仅管理员可用
+        virtual model::BillPage queryByTimePage(model::Timestamp from, model::Timestamp to,
+                                                const std::optional<model::BillCursor>& after, int page_size) = 0; // 仅管理员可用，按 (created_at, id) 升序
+
+        virtual std::vector<model::BillRow> queryByPhone(const std::string& phone) = 0; // 仅管理员可用
+
+        virtual std::vector<model::BillRow> queryByTimeInOrder(model::Timestamp from, model::Timestamp to) = 0; // 仅管理员可用
+        virtual std::vector<model::BillRow> queryByTimeAndEventInOrder(model::Timestamp from, model::Timestamp to) = 0; // 仅管理员可用
+
+        // 同上，但结果的行与字符串全部从 mr 分配（配合 QueryArena 使用）
+        virtual std::pmr::vector<model::PmrBillRow> queryByTime(int ownerId, model::Timestamp from, model::Timestamp to,
+                                                                std::pmr::memory_resource* mr) = 0;
+        virtual std::pmr::vector<model::PmrBillRow> queryByTime(model::Timestamp from, model::Timestamp to,
+                                                                std::pmr::memory_resource* mr) = 0; // 仅管理员可用
+        virtual std::pmr::vector<model::PmrBillRow> queryByTimeInOrder(model::Timestamp from, model::Timestamp to,
+                                                                       std::pmr::memory_resource* mr) = 0; // 仅管理员可用
+        virtual std::pmr::vector<model::PmrBillRow> queryByTimeAndEventInOrder(model::Timestamp from, model::Timestamp to,
+                                                                               std::pmr::memory_resource* mr) = 0; // 仅管理员可用
+
+        // SQL 侧 GROUP BY 聚合，只返回汇总行
+        virtual std::vector<model::BillTotal> totalsByEvent(model::Timestamp from, model::Timestamp to) = 0; // 仅管理员可用
+        virtual std::vector<model::BillTotal> totalsByOwner(model::Timestamp from, model::Timestamp to) = 0; // 仅管理员可用
+        virtual std::vector<model::PeriodTotal> totalsByPeriod(model::Timestamp from, model::Timestamp to, model::Granularity granularity) = 0; // 仅管理员可用
+        virtual model::BillSummary summary(model::Timestamp from, model::Timestamp to) = 0; // 仅管理员可用
+
+        // 每日汇总表维护：全量重建、与 bills 全量重算结果比对
+        virtual void rebuildRollups() = 0; // 仅管理员可用
+        virtual std::vector<model::RollupMismatch> checkRollups() = 0; // 仅管理员可用
+
+        // 逐行遍历，不在内存中物化结果集
+        virtual void forEachByTime(model::Timestamp from, model::Timestamp to, const BillVisitor& visit) = 0; // 仅管理员可用
+        virtual void forEachByTimeInOrder(model::Timestamp from, model::Timestamp to, const BillVisitor& visit) = 0; // 仅管理员可用
+        virtual void forEachByTimeAndEventInOrder(model::Timestamp from, model::Timestamp to, const BillVisitor& visit) = 0; // 仅管理员可用
 
         virtual void remove(int id) = 0;
     };
 
     struct IEventRepository {
         virtual ~IEventRepository() = default;
-        virtual void save(const model::Event& e) = 0; // 仅管理员可用
+        virtual int save(const model::Event& e) = 0; // 仅管理员可用，返回记录 id
 
         virtual std::optional<model::Event> findById(int Id) = 0; // 仅管理员可用
         virtual std::optional<model::Event> findByName(const std::string& name) = 0; // 仅管理员可用
 
         virtual bool setStatusById(int id, int status) = 0; // 仅管理员可用
+
+        // 默认实现经 findById 判断，EventRepositoryImpl 直接查内存字典
+        virtual bool isFrozen(int id) {
+            auto e = findById(id);
+            return e.has_value() && e->status == model::EventStatus::Frozen;
+        }
+    };
+
+    // 账单描述与批注内容的全文检索
+    struct ISearchRepository {
+        virtual ~ISearchRepository() = default;
+        // match 为 FTS5 查询表达式（可为空），substrings 中的每一项都须作为子串出现在描述或批注中，
+        // 两者之间为 AND。ownerId 为 0 时搜索全部用户（仅管理员可用）。
+        // 有 match 时按相关度排序，只有 substrings 时按账单 id 倒序
+        virtual model::SearchPage search(const std::string& match, const std::vector<std::string>& substrings,
+                                         int ownerId, int offset, int limit) = 0;
     };
 
     struct IAnnotationRepository {
         virtual ~IAnnotationRepository() = default;
-        virtual void save(const model::Annotation& a) = 0; // 仅管理员可用
+        virtual int save(const model::Annotation& a) = 0; // 仅管理员可用，返回记录 id
 
         virtual std::optional<model::Annotation> findById(int Id) = 0; 
     };
@@ -15,12 +15,14 @@ App::App(std::shared_ptr<AuthService> auth_service,
          std::shared_ptr<BillService> bill_service,
          std::shared_ptr<EventService> event_service,
          std::shared_ptr<UserService> user_service,
-         std::shared_ptr<StatisticsService> stats_service)
+         std::shared_ptr<StatisticsService> stats_service,
+         std::shared_ptr<SearchService> search_service)
     : auth_service_(auth_service)
     , bill_service_(bill_service)
     , event_service_(event_service)
     , user_service_(user_service)
-    , stats_service_(stats_service) {
+    , stats_service_(stats_service)
+    , search_service_(search_service) {
     instance_ = this;
     RegisterScreens();
 }
@@ -53,6 +55,20 @@ void App::Run() {
     router.SetOnRouteChange([&](Route) {
         screen.PostEvent(ftxui::Event::Custom);
     });
+
+    // 离开页面时作废它发出的后台请求
+    router.SetOnRouteLeave([this](Route) {
+        task_executor_.CancelPending();
+    });
+
+    // 后台结果回到 UI 线程执行，随后补一帧重绘
+    task_executor_.SetPoster([&screen](TaskExecutor::Closure closure) {
+        screen.Post(std::move(closure));
+        screen.PostEvent(ftxui::Event::Custom);
+    });
     
     screen.Loop(main_container);
+
+    task_executor_.SetPoster(nullptr);
+    task_executor_.CancelPending();
 }
\ No newline at end of file
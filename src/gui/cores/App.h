@@ -1,11 +1,13 @@
 #pragma once
 #include "Router.h"
 #include "Session.h"
+#include "TaskExecutor.h"
 #include "AuthService.h"
 #include "BillService.h"
 #include "EventService.h"
 #include "UserService.h"
 #include "StatisticsService.h"
+#include "SearchService.h"
 #include <memory>
 
 class App {
@@ -14,7 +16,8 @@ public:
         std::shared_ptr<BillService> bill_service,
         std::shared_ptr<EventService> event_service,
         std::shared_ptr<UserService> user_service,
-        std::shared_ptr<StatisticsService> stats_service);
+        std::shared_ptr<StatisticsService> stats_service,
+        std::shared_ptr<SearchService> search_service);
     
     void Run();
     
@@ -24,6 +27,10 @@ public:
     EventService& GetEventService() { return *event_service_; }
     UserService& GetUserService() { return *user_service_; }
     StatisticsService& GetStatisticsService() { return *stats_service_; }
+    SearchService& GetSearchService() { return *search_service_; }
+
+    // 页面里的服务调用经此提交到后台线程，结果回到 UI 线程
+    TaskExecutor& GetTaskExecutor() { return task_executor_; }
     
     static App& Instance() { return *instance_; }
     
@@ -35,6 +42,9 @@ private:
     std::shared_ptr<EventService> event_service_;
     std::shared_ptr<UserService> user_service_;
     std::shared_ptr<StatisticsService> stats_service_;
+    std::shared_ptr<SearchService> search_service_;
+
+    TaskExecutor task_executor_;
     
     static App* instance_;
 };
\ No newline at end of file
@@ -14,6 +14,10 @@ void Router::NavigateTo(Route route) {
         return;
     }
 
+    if (on_route_leave_) {
+        on_route_leave_(current_route_);
+    }
+
     current_route_ = route;
     current_screen_ = it->second();
     
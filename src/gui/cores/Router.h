@@ -39,6 +39,11 @@ public:
     void SetOnRouteChange(std::function<void(Route)> callback) {
         on_route_change_ = callback;
     }
+
+    // 离开当前页面、创建新页面之前调用，参数为即将离开的路由
+    void SetOnRouteLeave(std::function<void(Route)> callback) {
+        on_route_leave_ = callback;
+    }
     
 private:
     Router() = default;
@@ -47,4 +52,5 @@ private:
     Route current_route_ = Route::Visit;
     ftxui::Component current_screen_;
     std::function<void(Route)> on_route_change_;
+    std::function<void(Route)> on_route_leave_;
 };
\ No newline at end of file
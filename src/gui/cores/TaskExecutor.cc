@@ -0,0 +1,79 @@
+#include "TaskExecutor.h"
+#include <algorithm>
+#include <exception>
+
+TaskExecutor::TaskExecutor(size_t threads) {
+    threads = std::max<size_t>(threads, 1);
+    workers_.reserve(threads);
+    for (size_t i = 0; i < threads; ++i) {
+        workers_.emplace_back([this] { Run(); });
+    }
+}
+
+TaskExecutor::~TaskExecutor() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+        queue_.clear();
+    }
+    ++generation_;
+    not_empty_.notify_all();
+    for (auto& worker : workers_) {
+        worker.join();
+    }
+}
+
+void TaskExecutor::SetPoster(Poster poster) {
+    std::lock_guard<std::mutex> lock(poster_mutex_);
+    poster_ = std::move(poster);
+}
+
+void TaskExecutor::CancelPending() {
+    ++generation_;
+    std::lock_guard<std::mutex> lock(mutex_);
+    queue_.clear();
+}
+
+size_t TaskExecutor::PendingCount() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return queue_.size();
+}
+
+void TaskExecutor::Enqueue(Closure task) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (stopping_) {
+            return;
+        }
+        queue_.push_back(std::move(task));
+    }
+    not_empty_.notify_one();
+}
+
+void TaskExecutor::PostToUi(Closure task) {
+    std::lock_guard<std::mutex> lock(poster_mutex_);
+    if (poster_) {
+        poster_(std::move(task));
+    }
+}
+
+void TaskExecutor::Run() {
+    while (true) {
+        Closure task;
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            not_empty_.wait(lock, [this] { return !queue_.empty() || stopping_; });
+            if (stopping_) {
+                return;
+            }
+            task = std::move(queue_.front());
+            queue_.pop_front();
+        }
+
+        try {
+            task();
+        } catch (...) {
+            // work 的异常已在 Submit 中转给 failed，这里只兜住 poster 抛出的异常，保证工作线程不退出
+        }
+    }
+}
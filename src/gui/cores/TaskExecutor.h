@@ -0,0 +1,90 @@
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+// 页面的后台查询线程：work 在工作线程执行，done / failed 通过 poster 回到 UI 线程执行。
+// 每次离开页面调用 CancelPending()，之前提交的请求不再执行、结果也不再回调。
+//
+// 线程约定：所有服务共用同一个 DatabaseORM 连接，其上的 transaction_guard 与仓库里复用的
+// 预编译语句（BillRepositoryImpl::PreparedStatements、RawStatement 等）都不是线程安全的，
+// 因此默认只开一个工作线程，保证同一时间只有一个 work 访问仓库。只有在每个工作线程
+// 使用各自的连接与仓库实例时才能把 threads 调大。
+class TaskExecutor {
+public:
+    using Closure = std::function<void()>;
+    using Poster = std::function<void(Closure)>; // 把闭包交给 UI 线程，需线程安全
+
+    explicit TaskExecutor(size_t threads = 1);
+    ~TaskExecutor(); // 丢弃未开始的任务，等待正在执行的任务结束
+
+    TaskExecutor(const TaskExecutor&) = delete;
+    TaskExecutor& operator=(const TaskExecutor&) = delete;
+
+    // 未设置 poster 时结果直接丢弃
+    void SetPoster(Poster poster);
+
+    // work 的返回值原样传给 done；work 抛出异常时改为调用 failed(what())。
+    // 两者恰好调用其一（请求被取消时都不调用）；结果类型需可拷贝
+    template<class Work, class Done, class Failed>
+    void Submit(Work work, Done done, Failed failed) {
+        const uint64_t generation = generation_.load();
+        Enqueue([this, generation, work = std::move(work), done = std::move(done),
+                 failed = std::move(failed)]() mutable {
+            if (IsStale(generation)) {
+                return;
+            }
+            std::optional<decltype(work())> result;
+            std::string error;
+            try {
+                result.emplace(work());
+            } catch (const std::exception& e) {
+                error = e.what();
+            } catch (...) {
+                error = "未知错误";
+            }
+            PostToUi([this, generation, done = std::move(done), failed = std::move(failed),
+                      result = std::move(result), error = std::move(error)]() mutable {
+                // 在 UI 线程上再判断一次，NavigateTo 也在 UI 线程执行
+                if (IsStale(generation)) {
+                    return;
+                }
+                if (result.has_value()) {
+                    done(std::move(*result));
+                } else {
+                    failed(error);
+                }
+            });
+        });
+    }
+
+    void CancelPending();
+
+    size_t PendingCount() const;
+
+private:
+    void Enqueue(Closure task);
+    void PostToUi(Closure task);
+    bool IsStale(uint64_t generation) const { return generation != generation_.load(); }
+    void Run();
+
+    std::atomic<uint64_t> generation_{0};
+
+    mutable std::mutex mutex_;
+    std::condition_variable not_empty_;
+    std::deque<Closure> queue_;
+    bool stopping_ = false;
+
+    std::mutex poster_mutex_;
+    Poster poster_;
+
+    std::vector<std::thread> workers_;
+};
@@ -12,6 +12,7 @@ Component CreateLoginScreen() {
     auto phone = std::make_shared<std::string>();
     auto password = std::make_shared<std::string>();
     auto error_msg = std::make_shared<std::string>();
+    auto busy = std::make_shared<bool>(false);
     
     auto phone_input = Input(phone.get(), "手机号");
     InputOption password_option;
@@ -19,20 +20,34 @@ Component CreateLoginScreen() {
     auto password_input = Input(password.get(), "密码", password_option);
     
     auto login_button = Button("登 录", [=] {
+        if (*busy) {
+            return;
+        }
         if (phone->empty() || password->empty()) {
             *error_msg = "手机号和密码不能为空";
             return;
         }
         
-        auto& auth = App::Instance().GetAuthService();
-        auto result = auth.Login(*phone, *password);
-        
-        if (result.has_value()) {
-            Session::Instance().Login(*result);
-            Router::Instance().NavigateTo(Route::Home);
-        } else {
-            *error_msg = "登录失败：手机号或密码错误";
-        }
+        // 查库放到后台线程，结果回到 UI 线程再处理
+        *busy = true;
+        *error_msg = "正在登录...";
+        App::Instance().GetTaskExecutor().Submit(
+            [phone = *phone, password = *password] {
+                return App::Instance().GetAuthService().Login(phone, password);
+            },
+            [=](std::optional<model::User> result) {
+                *busy = false;
+                if (result.has_value()) {
+                    Session::Instance().Login(*result);
+                    Router::Instance().NavigateTo(Route::Home);
+                } else {
+                    *error_msg = "登录失败：手机号或密码错误";
+                }
+            },
+            [=](const std::string& error) {
+                *busy = false;
+                *error_msg = "系统错误：" + error;
+            });
     });
     
     auto return_button = Button("返 回", [=] {
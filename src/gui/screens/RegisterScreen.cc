@@ -15,6 +15,7 @@ ftxui::Component CreateRegisterScreen() {
     auto confirm_password = std::make_shared<std::string>();
     auto error_msg = std::make_shared<std::string>();
     auto success_msg = std::make_shared<std::string>();
+    auto busy = std::make_shared<bool>(false);
     
     // 输入框配置
     InputOption phone_option;
@@ -98,34 +99,40 @@ ftxui::Component CreateRegisterScreen() {
     
     // 注册按钮
     auto register_btn = Button("注 册", [=] {
-        if (!validate()) {
+        if (*busy || !validate()) {
             return;
         }
         
-        try {
-            auto& auth_service = App::Instance().GetAuthService();
-            auto result = auth_service.Register(*phone, *username, *password);
-            
-            if (result. has_value()) {
-                *success_msg = "注册成功！即将跳转到登录页面... ";
-                *error_msg = "";
-                
-                // 清空输入
-                phone->clear();
-                username->clear();
-                password->clear();
-                confirm_password->clear();
-                
-                // 跳转到登录页面
-                Router::Instance().NavigateTo(Route::Login);
-            } else {
-                *error_msg = "注册失败：该手机号已被注册";
+        // 后台执行注册，结果回到 UI 线程再处理
+        *busy = true;
+        App::Instance().GetTaskExecutor().Submit(
+            [phone = *phone, username = *username, password = *password] {
+                return App::Instance().GetAuthService().Register(phone, username, password);
+            },
+            [=](std::optional<model::User> result) {
+                *busy = false;
+                if (result. has_value()) {
+                    *success_msg = "注册成功！即将跳转到登录页面... ";
+                    *error_msg = "";
+                    
+                    // 清空输入
+                    phone->clear();
+                    username->clear();
+                    password->clear();
+                    confirm_password->clear();
+                    
+                    // 跳转到登录页面
+                    Router::Instance().NavigateTo(Route::Login);
+                } else {
+                    *error_msg = "注册失败：该手机号已被注册";
+                    *success_msg = "";
+                }
+            },
+            [=](const std::string& error) {
+                *busy = false;
+                *error_msg = "系统错误：" + error;
                 *success_msg = "";
-            }
-        } catch (const std::exception& e) {
-            *error_msg = "系统错误：" + std::string(e.what());
-            *success_msg = "";
-        }
+            });
     });
 
     auto back_btn = Button("返 回", [] {
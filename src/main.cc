@@ -4,28 +4,63 @@
 #include "data/BillRepositoryImpl.h"
 #include "data/EventRepositoryImpl.h"
 #include "data/AnnotationRepositoryImpl.h"
+#include "data/AsyncBillWriter.h"
+#include "data/CachingUserRepository.h"
+#include "data/SearchRepositoryImpl.h"
+#include "data/StatementProfiler.h"
 #include "services/AuthService.h"
 #include "services/BillService.h"
 #include "services/EventService.h"
 #include "services/UserService.h"
 #include "services/StatisticsService.h"
+#include "services/SearchService.h"
+#include "common/Metrics.h"
 #include <iostream>
+#include <algorithm>
+#include <cstdlib>
 #include <filesystem>
+#include <fstream>
 #include <memory>
+#include <string>
 
-int main() {
+int main(int argc, char* argv[]) {
     try {
         // 1. 确保数据库目录存在
         std::filesystem::create_directories("database");
+
+        // 退出时把本次运行的方法级指标写入 database/metrics.txt
+        std::atexit([] {
+            std::ofstream out("database/metrics.txt");
+            metrics::Registry::Instance().Dump(out);
+        });
         
-        // 2. 初始化数据库（ORM）
-        auto db = std::make_shared<DatabaseORM>("database/bills.db");
+        // 2. 初始化数据库（ORM），WAL + synchronous=NORMAL
+        auto db_options = DatabaseOptions::Balanced();
+
+        // --profile-sql：按 SQL 汇总耗时，慢于 100ms 的语句连同查询计划写入 database/slow_queries.log
+        if (std::find(argv + 1, argv + argc, std::string("--profile-sql")) != argv + argc) {
+            db_options.profile_statements = true;
+            db_options.slow_query_log = "database/slow_queries.log";
+        }
+        auto db = std::make_shared<DatabaseORM>("database/bills.db", db_options);
         
         // 3. 创建 Repository 实现
-        auto user_repo = std::make_shared<UserRepositoryImpl>(db);
-        auto bill_repo = std::make_shared<BillRepositoryImpl>(db);
+        std::shared_ptr<repo::IUserRepository> user_repo = std::make_shared<UserRepositoryImpl>(db);
+
+        // --cache-users：登录与个人信息路径先查内存 LRU，写入时失效
+        if (std::find(argv + 1, argv + argc, std::string("--cache-users")) != argv + argc) {
+            user_repo = std::make_shared<CachingUserRepository>(user_repo);
+        }
+        std::shared_ptr<repo::IBillRepository> bill_repo = std::make_shared<BillRepositoryImpl>(db);
+
+        // --async-writes：账单写入交给后台线程分组提交，写线程使用独立连接（与 db 共享缓存和剖析器）
+        if (std::find(argv + 1, argv + argc, std::string("--async-writes")) != argv + argc) {
+            auto writer_db = db->OpenConnection();
+            bill_repo = std::make_shared<AsyncBillWriter>(std::make_shared<BillRepositoryImpl>(writer_db));
+        }
         auto event_repo = std::make_shared<EventRepositoryImpl>(db);
         auto annotation_repo = std::make_shared<AnnotationRepositoryImpl>(db);
+        auto search_repo = std::make_shared<SearchRepositoryImpl>(db);
         
         // 4. 创建 Service
         auto auth_service = std::make_shared<AuthService>(user_repo);
@@ -33,6 +68,29 @@ int main() {
         auto bill_service = std::make_shared<BillService>(bill_repo, annotation_repo);
         auto event_service = std::make_shared<EventService>(event_repo);
         auto stats_service = std::make_shared<StatisticsService>(bill_repo);
+        auto search_service = std::make_shared<SearchService>(search_repo);
+
+        // 每日汇总表首次创建时从 bills 补齐
+        if (db->NeedsRollupRebuild()) {
+            stats_service->RebuildRollups();
+        }
+
+        // 维护命令：--rebuild-rollups 重建汇总表，--check-rollups 校验汇总表
+        std::string command = argc > 1 ? argv[1] : "";
+        if (command == "--rebuild-rollups") {
+            stats_service->RebuildRollups();
+            std::cout << "汇总表已重建" << std::endl;
+            return 0;
+        } else if (command == "--check-rollups") {
+            auto mismatches = stats_service->CheckRollups();
+            for (const auto& m : mismatches) {
+                std::cout << "owner=" << m.owner_id << " event=" << m.event_id << " day=" << m.day
+                          << " count " << m.actual_count << "/" << m.expected_count
+                          << " sum(分) " << m.actual_sum.cents << "/" << m.expected_sum.cents << std::endl;
+            }
+            std::cout << "不一致行数: " << mismatches.size() << std::endl;
+            return mismatches.empty() ? 0 : 2;
+        }
         
         // 5.  创建并运行应用
         App app(
@@ -40,10 +98,17 @@ int main() {
             bill_service,
             event_service,
             user_service,
-            stats_service
+            stats_service,
+            search_service
         );
         
         app.Run();
+
+        if (auto* profiler = db->GetProfiler()) {
+            db->FlushSlowLog();
+            std::ofstream out("database/sql_profile.txt");
+            profiler->Dump(out);
+        }
         
     } catch (const std::exception& e) {
         std::cerr << "❌ 程序启动失败: " << e.what() << std::endl;
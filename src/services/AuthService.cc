@@ -1,14 +1,18 @@
 #include "AuthService.h"
+#include "Metrics.h"
 
 std::optional<model::User> AuthService::Login(const std::string& phone, const std::string& password){
+    METRICS_SCOPE(timer, "AuthService.Login");
     std::optional<model::User> user = user_repository_->queryByPhone(phone);
     if (!user.has_value() || user.value().password != password) {
         return std::nullopt;
     }
+    timer.Rows(1);
     return user;
 }
 
 std::optional<model::User> AuthService::Register(const std::string& phone, const std::string& username, const std::string& password){
+    METRICS_SCOPE(timer, "AuthService.Register");
     std::optional<model::User> user = user_repository_->queryByPhone(phone);
     if (user.has_value()) {
         return std::nullopt;
@@ -18,11 +22,13 @@ std::optional<model::User> AuthService::Register(const std::string& phone, const
         return std::nullopt;
     }
     model::User u(phone, username, password);
-    user_repository_->save(u);
+    u.id = user_repository_->save(u);
+    timer.Rows(1);
     return u;
 }
 
 bool AuthService::ResetPassword(int userId, const std::string& oldPwd, const std::string& newPwd){
+    METRICS_SCOPE(timer, "AuthService.ResetPassword");
     std::optional<model::User> user = user_repository_->findById(userId);
     if (!user.has_value()) {
         return false;
@@ -0,0 +1,148 @@
+#include "BillColumnStore.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define BILL_COLUMN_STORE_AVX2 1
+#include <immintrin.h>
+#endif
+
+namespace {
+
+struct Predicate {
+    bool use_owner = false;
+    int32_t owner_id = 0;
+    bool use_event = false;
+    int32_t event_id = 0;
+};
+
+BillColumnStore::Result SumKernelScalar(const int32_t* owner, const int32_t* event,
+                                        const int64_t* amount, size_t n, const Predicate& p) {
+    BillColumnStore::Result r;
+    for (size_t i = 0; i < n; ++i) {
+        bool hit = (!p.use_owner || owner[i] == p.owner_id) &&
+                   (!p.use_event || event[i] == p.event_id);
+        r.count += hit;
+        r.sum_cents += hit ? amount[i] : 0;
+    }
+    return r;
+}
+
+#ifdef BILL_COLUMN_STORE_AVX2
+// 每次处理 4 行：int32 的 owner/event 扩展为 int64 后与金额共用同一个掩码
+__attribute__((target("avx2")))
+BillColumnStore::Result SumKernelAvx2(const int32_t* owner, const int32_t* event,
+                                      const int64_t* amount, size_t n, const Predicate& p) {
+    const __m256i owner_v = _mm256_set1_epi64x(p.owner_id);
+    const __m256i event_v = _mm256_set1_epi64x(p.event_id);
+    // 未启用的谓词用全 1 掩码跳过
+    const __m256i skip_owner = _mm256_set1_epi64x(p.use_owner ? 0 : -1);
+    const __m256i skip_event = _mm256_set1_epi64x(p.use_event ? 0 : -1);
+
+    __m256i sum = _mm256_setzero_si256();
+    __m256i cnt = _mm256_setzero_si256();
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m256i o = _mm256_cvtepi32_epi64(_mm_loadu_si128(reinterpret_cast<const __m128i*>(owner + i)));
+        __m256i e = _mm256_cvtepi32_epi64(_mm_loadu_si128(reinterpret_cast<const __m128i*>(event + i)));
+        __m256i mask = _mm256_and_si256(
+            _mm256_or_si256(_mm256_cmpeq_epi64(o, owner_v), skip_owner),
+            _mm256_or_si256(_mm256_cmpeq_epi64(e, event_v), skip_event));
+        __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(amount + i));
+        sum = _mm256_add_epi64(sum, _mm256_and_si256(a, mask));
+        cnt = _mm256_sub_epi64(cnt, mask);  // 命中的 lane 为 -1
+    }
+
+    alignas(32) int64_t sums[4];
+    alignas(32) int64_t cnts[4];
+    _mm256_store_si256(reinterpret_cast<__m256i*>(sums), sum);
+    _mm256_store_si256(reinterpret_cast<__m256i*>(cnts), cnt);
+
+    auto r = SumKernelScalar(owner + i, event + i, amount + i, n - i, p);
+    r.sum_cents += sums[0] + sums[1] + sums[2] + sums[3];
+    r.count += cnts[0] + cnts[1] + cnts[2] + cnts[3];
+    return r;
+}
+#endif
+
+Predicate ToPredicate(const BillColumnStore::Filter& filter) {
+    Predicate p;
+    p.use_owner = filter.owner_id.has_value();
+    p.owner_id = filter.owner_id.value_or(0);
+    p.use_event = filter.event_id.has_value();
+    p.event_id = filter.event_id.value_or(0);
+    return p;
+}
+
+}
+
+void BillColumnStore::Load(repo::IBillRepository& repo, model::Timestamp from, model::Timestamp to) {
+    Clear();
+    repo.forEachByTimeInOrder(from, to, [this](const model::BillRow& b) {
+        Append(b.created_at, b.owner_id, b.event_id, b.amount.cents);
+    });
+}
+
+void BillColumnStore::Append(model::Timestamp created_at, int32_t owner_id, int32_t event_id,
+                             int64_t amount_cents) {
+    if (!created_at_.empty() && created_at < created_at_.back()) {
+        throw std::invalid_argument("BillColumnStore::Append: created_at must be non-decreasing");
+    }
+    created_at_.push_back(created_at);
+    owner_id_.push_back(owner_id);
+    event_id_.push_back(event_id);
+    amount_cents_.push_back(amount_cents);
+}
+
+void BillColumnStore::Reserve(size_t n) {
+    created_at_.reserve(n);
+    owner_id_.reserve(n);
+    event_id_.reserve(n);
+    amount_cents_.reserve(n);
+}
+
+void BillColumnStore::Clear() {
+    created_at_.clear();
+    owner_id_.clear();
+    event_id_.clear();
+    amount_cents_.clear();
+}
+
+std::pair<size_t, size_t> BillColumnStore::RangeOf(model::Timestamp from, model::Timestamp to) const {
+    auto begin = std::lower_bound(created_at_.begin(), created_at_.end(), from);
+    auto end = std::upper_bound(begin, created_at_.end(), to);
+    return {static_cast<size_t>(begin - created_at_.begin()), static_cast<size_t>(end - created_at_.begin())};
+}
+
+BillColumnStore::Result BillColumnStore::Sum(const Filter& filter) const {
+#ifdef BILL_COLUMN_STORE_AVX2
+    if (HasAvx2()) {
+        auto [begin, end] = RangeOf(filter.from, filter.to);
+        if (begin >= end) {
+            return {};
+        }
+        return SumKernelAvx2(owner_id_.data() + begin, event_id_.data() + begin,
+                             amount_cents_.data() + begin, end - begin, ToPredicate(filter));
+    }
+#endif
+    return SumScalar(filter);
+}
+
+BillColumnStore::Result BillColumnStore::SumScalar(const Filter& filter) const {
+    auto [begin, end] = RangeOf(filter.from, filter.to);
+    if (begin >= end) {
+        return {};
+    }
+    return SumKernelScalar(owner_id_.data() + begin, event_id_.data() + begin,
+                           amount_cents_.data() + begin, end - begin, ToPredicate(filter));
+}
+
+bool BillColumnStore::HasAvx2() {
+#ifdef BILL_COLUMN_STORE_AVX2
+    static const bool supported = __builtin_cpu_supports("avx2");
+    return supported;
+#else
+    return false;
+#endif
+}
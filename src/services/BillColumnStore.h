@@ -0,0 +1,49 @@
+#pragma once
+#include <irepositories.h>
+#include <cstdint>
+#include <optional>
+#include <utility>
+#include <vector>
+
+// 账单的列式（SoA）内存快照，用于即席统计。
+// 按 created_at 升序存放，时间范围先二分定位，再对区间内的 owner/event 谓词做向量化过滤求和。
+class BillColumnStore {
+public:
+    struct Filter {
+        model::Timestamp from = INT64_MIN;
+        model::Timestamp to = INT64_MAX;
+        std::optional<int32_t> owner_id;
+        std::optional<int32_t> event_id;
+    };
+
+    struct Result {
+        int64_t count = 0;
+        int64_t sum_cents = 0;
+    };
+
+    // 通过流式接口加载 [from, to] 内的账单，替换当前内容
+    void Load(repo::IBillRepository& repo,
+              model::Timestamp from = INT64_MIN, model::Timestamp to = INT64_MAX);
+
+    // 追加一行，created_at 必须不小于已有的最后一行
+    void Append(model::Timestamp created_at, int32_t owner_id, int32_t event_id, int64_t amount_cents);
+    void Reserve(size_t n);
+    void Clear();
+
+    size_t Size() const { return created_at_.size(); }
+
+    Result Sum(const Filter& filter) const;
+
+    // 强制使用标量实现，用于校验与对比
+    Result SumScalar(const Filter& filter) const;
+
+    static bool HasAvx2();
+
+private:
+    std::pair<size_t, size_t> RangeOf(model::Timestamp from, model::Timestamp to) const;
+
+    std::vector<int64_t> created_at_;
+    std::vector<int32_t> owner_id_;
+    std::vector<int32_t> event_id_;
+    std::vector<int64_t> amount_cents_;
+};
@@ -1,46 +1,86 @@
 #include <BillService.h>
+#include "Metrics.h"
 
 std::optional<model::Bill> BillService::CreateBill(int owner_id, model::Bill data) {
+    METRICS_SCOPE(timer, "BillService.CreateBill");
     if (owner_id <= 0) {
         return std::nullopt;
     }
 
-    if (data.amount <= 0.0) {
+    if (data.amount <= model::Money()) {
         return std::nullopt;
     } 
 
     data.owner_id = owner_id;
-    bill_repository_->save(data);
+    data.id = bill_repository_->save(data);
+    timer.Rows(1);
     return data;
 }
 
-std::vector<model::Bill> BillService::QueryByTime(int owner_id, model::Timestamp from, model::Timestamp to) {
+bool BillService::CreateBillAsync(int owner_id, model::Bill data, repo::SaveCallback done) {
+    METRICS_SCOPE(timer, "BillService.CreateBillAsync");
+    if (owner_id <= 0) {
+        return false;
+    }
+
+    if (data.amount <= model::Money()) {
+        return false;
+    }
+
+    data.owner_id = owner_id;
+    bill_repository_->saveAsync(data, std::move(done));
+    return true;
+}
+
+std::optional<std::vector<int>> BillService::CreateBills(int owner_id, std::vector<model::Bill> data) {
+    METRICS_SCOPE(timer, "BillService.CreateBills");
+    if (owner_id <= 0) {
+        return std::nullopt;
+    }
+
+    for (const auto& b : data) {
+        if (b.amount <= model::Money()) {
+            return std::nullopt;
+        }
+    }
+
+    for (auto& b : data) {
+        b.owner_id = owner_id;
+    }
+    return timer.Counted(bill_repository_->saveBatch(data));
+}
+
+std::vector<model::BillRow> BillService::QueryByTime(int owner_id, model::Timestamp from, model::Timestamp to) {
+    METRICS_SCOPE(timer, "BillService.QueryByTime");
     if (owner_id <= 0) {
         return {};
     }
 
     if (from > to) {
-        return std::vector<model::Bill>();
+        return std::vector<model::BillRow>();
     }
 
-    return bill_repository_->queryByTime(owner_id, from, to);
+    return timer.Counted(bill_repository_->queryByTime(owner_id, from, to));
 }
 
-std::vector<model::Bill> BillService::queryByEvent(int owner_id, int event_id) {
+std::vector<model::BillRow> BillService::queryByEvent(int owner_id, int event_id) {
+    METRICS_SCOPE(timer, "BillService.queryByEvent");
     if (owner_id <= 0 || event_id <= 0) {
         return {};
     }
-    return bill_repository_->queryByEvent(owner_id, event_id);
+    return timer.Counted(bill_repository_->queryByEvent(owner_id, event_id));
 }
 
-std::vector<model::Bill> BillService::queryByPhone(std::string phone) {
+std::vector<model::BillRow> BillService::queryByPhone(std::string phone) {
+    METRICS_SCOPE(timer, "BillService.queryByPhone");
     if (phone.empty()) {
         return {};
     }
-    return bill_repository_->queryByPhone(phone);
+    return timer.Counted(bill_repository_->queryByPhone(phone));
 }
 
 void BillService::editBill(int bill_id, model::Bill updates) {
+    METRICS_SCOPE(timer, "BillService.editBill");
     if (bill_id <= 0) {
         return;
     }
@@ -56,6 +96,7 @@ void BillService::editBill(int bill_id, model::Bill updates) {
 }
 
 void BillService::deleteBill(int bill_id) {
+    METRICS_SCOPE(timer, "BillService.deleteBill");
     if (bill_id <= 0) {
         return;
     }
@@ -68,6 +109,7 @@ void BillService::deleteBill(int bill_id) {
 }
 
 void BillService::annotateBill(int bill_id, model::Annotation a) {
+    METRICS_SCOPE(timer, "BillService.annotateBill");
     if (bill_id <= 0) {
         return;
     }
@@ -81,7 +123,9 @@ void BillService::annotateBill(int bill_id, model::Annotation a) {
         return;
     }
 
-    annotation_repository_->save(a);
+    // 批注归属以参数 bill_id 为准；仓库保存时按它刷新该账单的全文索引
+    a.bill_id = bill_id;
+    a.id = annotation_repository_->save(a);
     
     bill->annotation = a;
     bill->has_annotation = true;
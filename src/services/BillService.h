@@ -6,9 +6,12 @@ public:
     explicit BillService(std::shared_ptr<repo::IBillRepository> bill_repo, std::shared_ptr<repo::IAnnotationRepository> anno_repo):
         bill_repository_(bill_repo), annotation_repository_(anno_repo) {}
     std::optional<model::Bill> CreateBill(int owner_id, model::Bill data);
-    std::vector<model::Bill> QueryByTime(int owner_id, model::Timestamp from, model::Timestamp to);
-    std::vector<model::Bill> queryByEvent(int owner_id, int event_id);
-    std::vector<model::Bill> queryByPhone(std::string phone);
+    // 校验通过后交给仓库的 saveAsync，返回 false 表示参数不合法、未提交；结果经 done 通知
+    bool CreateBillAsync(int owner_id, model::Bill data, repo::SaveCallback done);
+    std::optional<std::vector<int>> CreateBills(int owner_id, std::vector<model::Bill> data); // 任一条不合法则整批拒绝
+    std::vector<model::BillRow> QueryByTime(int owner_id, model::Timestamp from, model::Timestamp to);
+    std::vector<model::BillRow> queryByEvent(int owner_id, int event_id);
+    std::vector<model::BillRow> queryByPhone(std::string phone);
     void editBill(int bill_id, model::Bill updates);
     void deleteBill(int bill_id);
     void annotateBill(int bill_id, model::Annotation a);
@@ -1,6 +1,8 @@
 #include "EventService.h"
+#include "Metrics.h"
 
 std::optional<model::Event> EventService::QueryByName(const std::string& name) {
+    METRICS_SCOPE(timer, "EventService.QueryByName");
     if (name.empty() || name == "") {
         return std::nullopt;
     }
@@ -9,10 +11,12 @@ std::optional<model::Event> EventService::QueryByName(const std::string& name) {
         return std::nullopt;
     }
 
+    timer.Rows(1);
     return e;
 }
 
 std::optional<model::Event> EventService::QueryById(int event_id) {
+    METRICS_SCOPE(timer, "EventService.QueryById");
     if (event_id <= 0) {
         return std::nullopt;
     }
@@ -22,10 +26,12 @@ std::optional<model::Event> EventService::QueryById(int event_id) {
         return std::nullopt;
     }
 
+    timer.Rows(1);
     return e;
 }
 
 std::optional<model::Event> EventService::CreateEvent(model::Event& e) {
+    METRICS_SCOPE(timer, "EventService.CreateEvent");
     if (e.name.empty() || e.name == "") {
         return std::nullopt;
     }
@@ -35,11 +41,13 @@ std::optional<model::Event> EventService::CreateEvent(model::Event& e) {
         return std::nullopt;
     }
 
-    event_repository_->save(e);
+    e.id = event_repository_->save(e);
+    timer.Rows(1);
     return e;
 }
 
 bool EventService::SetStatus(int event_id, int status){
+    METRICS_SCOPE(timer, "EventService.SetStatus");
     if (event_id <= 0) {
         return false;
     }
@@ -53,4 +61,12 @@ bool EventService::SetStatus(int event_id, int status){
         return false;
     }
     return true;
-}
\ No newline at end of file
+}
+
+bool EventService::IsFrozen(int event_id) {
+    METRICS_SCOPE(timer, "EventService.IsFrozen");
+    if (event_id <= 0) {
+        return false;
+    }
+    return event_repository_->isFrozen(event_id);
+}
@@ -10,6 +10,7 @@ public:
     std::optional<model::Event> QueryById(int event_id);
     std::optional<model::Event> CreateEvent(model::Event& e);
     bool SetStatus(int event_id, int status);
+    bool IsFrozen(int event_id);
 private:
     std::shared_ptr<repo::IEventRepository> event_repository_;
 };
@@ -0,0 +1,87 @@
+#include "SearchService.h"
+#include "Metrics.h"
+#include <algorithm>
+#include <cctype>
+
+namespace {
+
+constexpr int kMaxPageSize = 500;
+
+// trigram 索引能直接查询的最短词长（字符数）
+constexpr size_t kMinIndexedChars = 3;
+
+// UTF-8 字符数：不计 10xxxxxx 续字节
+size_t CharCount(const std::string& text) {
+    return static_cast<size_t>(std::count_if(text.begin(), text.end(), [](char ch) {
+        return (static_cast<unsigned char>(ch) & 0xC0) != 0x80;
+    }));
+}
+
+// 把词加引号作为短语追加到 FTS5 表达式，引号内的双引号写两次
+void AppendPhrase(std::string& match, const std::string& term) {
+    if (!match.empty()) {
+        match += ' ';
+    }
+    match += '"';
+    for (char ch : term) {
+        if (ch == '"') {
+            match += '"';
+        }
+        match += ch;
+    }
+    match += '"';
+}
+
+}
+
+std::vector<std::string> SearchService::SplitTerms(const std::string& text) {
+    std::vector<std::string> terms;
+    std::string term;
+    for (char ch : text) {
+        if (std::isspace(static_cast<unsigned char>(ch))) {
+            if (!term.empty()) {
+                terms.push_back(std::move(term));
+                term.clear();
+            }
+        } else {
+            term += ch;
+        }
+    }
+    if (!term.empty()) {
+        terms.push_back(std::move(term));
+    }
+    return terms;
+}
+
+std::string SearchService::ToMatchExpression(const std::string& text) {
+    std::string match;
+    for (const auto& term : SplitTerms(text)) {
+        AppendPhrase(match, term);
+    }
+    return match;
+}
+
+model::SearchPage SearchService::Search(int owner_id, const std::string& text, int page_size, int after) {
+    METRICS_SCOPE(timer, "SearchService.Search");
+    if (owner_id < 0 || page_size <= 0 || after < 0) {
+        return {};
+    }
+
+    // 不足 3 个字符的词（如 "餐饮"、"交通"）没有 trigram 可查，交给仓库按子串过滤
+    std::string match;
+    std::vector<std::string> substrings;
+    for (auto& term : SplitTerms(text)) {
+        if (CharCount(term) < kMinIndexedChars) {
+            substrings.push_back(std::move(term));
+        } else {
+            AppendPhrase(match, term);
+        }
+    }
+    if (match.empty() && substrings.empty()) {
+        return {};
+    }
+
+    auto page = search_repository_->search(match, substrings, owner_id, after, std::min(page_size, kMaxPageSize));
+    timer.Rows(page.bills.size());
+    return page;
+}
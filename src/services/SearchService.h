@@ -0,0 +1,24 @@
+#pragma once
+#include <irepositories.h>
+#include <string>
+#include <vector>
+
+class SearchService {
+public:
+    explicit SearchService(std::shared_ptr<repo::ISearchRepository> search_repo):
+        search_repository_(search_repo) {}
+
+    // 在账单描述与批注中搜索 text，每个词按子串匹配（"axi" 可命中 "taxi"），多个词之间为 AND。
+    // 3 个字符及以上的词走全文索引并按相关度排序；更短的词（"餐饮"、"交通"）按子串逐行过滤，
+    // 全部词都短时按账单 id 倒序。owner_id 为 0 时搜索全部用户（仅管理员可用）。
+    // after 传上一页返回的 next_offset
+    model::SearchPage Search(int owner_id, const std::string& text, int page_size, int after = 0);
+
+    // 按空白切词
+    static std::vector<std::string> SplitTerms(const std::string& text);
+
+    // 把用户输入转为 FTS5 表达式：按空白切词，每个词加引号转义为短语
+    static std::string ToMatchExpression(const std::string& text);
+private:
+    std::shared_ptr<repo::ISearchRepository> search_repository_;
+};
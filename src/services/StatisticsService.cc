@@ -1,21 +1,136 @@
 #include "StatisticsService.h"
+#include "Metrics.h"
 
-std::vector<model::Bill> StatisticsService::QueryByTimeInOrder(
+std::vector<model::BillRow> StatisticsService::QueryByTimeInOrder(
     model::Timestamp from, model::Timestamp to) {
+    METRICS_SCOPE(timer, "StatisticsService.QueryByTimeInOrder");
     
     if (from > to) {
         return {};
     }
     
-    return bill_repository_->queryByTimeInOrder(from, to);
+    return timer.Counted(bill_repository_->queryByTimeInOrder(from, to));
 }
 
-std::vector<model::Bill> StatisticsService::QueryByTimeAndEventInOrder(
+std::vector<model::BillRow> StatisticsService::QueryByTimeAndEventInOrder(
     model::Timestamp from, model::Timestamp to) {
+    METRICS_SCOPE(timer, "StatisticsService.QueryByTimeAndEventInOrder");
     
     if (from > to) {
         return {};
     }
     
-    return bill_repository_->queryByTimeAndEventInOrder(from, to);
+    return timer.Counted(bill_repository_->queryByTimeAndEventInOrder(from, to));
+}
+
+std::pmr::vector<model::PmrBillRow> StatisticsService::QueryByTimeInOrder(
+    model::Timestamp from, model::Timestamp to, std::pmr::memory_resource* mr) {
+    METRICS_SCOPE(timer, "StatisticsService.QueryByTimeInOrder(pmr)");
+
+    if (from > to) {
+        return std::pmr::vector<model::PmrBillRow>(mr);
+    }
+
+    return timer.Counted(bill_repository_->queryByTimeInOrder(from, to, mr));
+}
+
+std::pmr::vector<model::PmrBillRow> StatisticsService::QueryByTimeAndEventInOrder(
+    model::Timestamp from, model::Timestamp to, std::pmr::memory_resource* mr) {
+    METRICS_SCOPE(timer, "StatisticsService.QueryByTimeAndEventInOrder(pmr)");
+
+    if (from > to) {
+        return std::pmr::vector<model::PmrBillRow>(mr);
+    }
+
+    return timer.Counted(bill_repository_->queryByTimeAndEventInOrder(from, to, mr));
+}
+
+std::vector<model::BillTotal> StatisticsService::TotalsByEvent(
+    model::Timestamp from, model::Timestamp to) {
+    METRICS_SCOPE(timer, "StatisticsService.TotalsByEvent");
+    
+    if (from > to) {
+        return {};
+    }
+    
+    return timer.Counted(bill_repository_->totalsByEvent(from, to));
+}
+
+std::vector<model::BillTotal> StatisticsService::TotalsByOwner(
+    model::Timestamp from, model::Timestamp to) {
+    METRICS_SCOPE(timer, "StatisticsService.TotalsByOwner");
+    
+    if (from > to) {
+        return {};
+    }
+    
+    return timer.Counted(bill_repository_->totalsByOwner(from, to));
+}
+
+std::vector<model::PeriodTotal> StatisticsService::TotalsByPeriod(
+    model::Timestamp from, model::Timestamp to, model::Granularity granularity) {
+    METRICS_SCOPE(timer, "StatisticsService.TotalsByPeriod");
+    
+    if (from > to) {
+        return {};
+    }
+    
+    return timer.Counted(bill_repository_->totalsByPeriod(from, to, granularity));
+}
+
+model::BillSummary StatisticsService::Summary(
+    model::Timestamp from, model::Timestamp to) {
+    METRICS_SCOPE(timer, "StatisticsService.Summary");
+    
+    if (from > to) {
+        return {};
+    }
+    
+    return bill_repository_->summary(from, to);
+}
+
+void StatisticsService::RebuildRollups() {
+    METRICS_SCOPE(timer, "StatisticsService.RebuildRollups");
+    bill_repository_->rebuildRollups();
+}
+
+std::vector<model::RollupMismatch> StatisticsService::CheckRollups() {
+    METRICS_SCOPE(timer, "StatisticsService.CheckRollups");
+    return timer.Counted(bill_repository_->checkRollups());
+}
+
+void StatisticsService::ForEachByTimeInOrder(
+    model::Timestamp from, model::Timestamp to, const repo::BillVisitor& visit) {
+    METRICS_SCOPE(timer, "StatisticsService.ForEachByTimeInOrder");
+    
+    if (from > to || !visit) {
+        return;
+    }
+    
+    bill_repository_->forEachByTimeInOrder(from, to, visit);
+}
+
+void StatisticsService::ForEachByTimeAndEventInOrder(
+    model::Timestamp from, model::Timestamp to, const repo::BillVisitor& visit) {
+    METRICS_SCOPE(timer, "StatisticsService.ForEachByTimeAndEventInOrder");
+    
+    if (from > to || !visit) {
+        return;
+    }
+    
+    bill_repository_->forEachByTimeAndEventInOrder(from, to, visit);
+}
+
+model::BillPage StatisticsService::QueryByTimePage(
+    model::Timestamp from, model::Timestamp to,
+    const std::optional<model::BillCursor>& after, int page_size) {
+    METRICS_SCOPE(timer, "StatisticsService.QueryByTimePage");
+    
+    if (from > to || page_size <= 0) {
+        return {};
+    }
+    
+    auto page = bill_repository_->queryByTimePage(from, to, after, page_size);
+    timer.Rows(page.bills.size());
+    return page;
 }
\ No newline at end of file
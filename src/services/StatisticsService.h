@@ -5,8 +5,27 @@ class StatisticsService {
 public:
     explicit StatisticsService(std::shared_ptr<repo::IBillRepository> bill_repo):
         bill_repository_(bill_repo) {}
-    std::vector<model::Bill> QueryByTimeInOrder(model::Timestamp from, model::Timestamp to);
-    std::vector<model::Bill> QueryByTimeAndEventInOrder(model::Timestamp from, model::Timestamp to);
+    std::vector<model::BillRow> QueryByTimeInOrder(model::Timestamp from, model::Timestamp to);
+    std::vector<model::BillRow> QueryByTimeAndEventInOrder(model::Timestamp from, model::Timestamp to);
+    // 同上，结果从 mr 分配，可配合 QueryArena 在请求结束时整体释放
+    std::pmr::vector<model::PmrBillRow> QueryByTimeInOrder(model::Timestamp from, model::Timestamp to,
+                                                           std::pmr::memory_resource* mr);
+    std::pmr::vector<model::PmrBillRow> QueryByTimeAndEventInOrder(model::Timestamp from, model::Timestamp to,
+                                                                   std::pmr::memory_resource* mr);
+    // SQL 侧聚合，只传回汇总行
+    std::vector<model::BillTotal> TotalsByEvent(model::Timestamp from, model::Timestamp to);
+    std::vector<model::BillTotal> TotalsByOwner(model::Timestamp from, model::Timestamp to);
+    std::vector<model::PeriodTotal> TotalsByPeriod(model::Timestamp from, model::Timestamp to, model::Granularity granularity);
+    model::BillSummary Summary(model::Timestamp from, model::Timestamp to);
+    // 每日汇总表维护
+    void RebuildRollups();
+    std::vector<model::RollupMismatch> CheckRollups();
+    // 流式遍历，内存占用与行数无关；不填充 Bill::event
+    void ForEachByTimeInOrder(model::Timestamp from, model::Timestamp to, const repo::BillVisitor& visit);
+    void ForEachByTimeAndEventInOrder(model::Timestamp from, model::Timestamp to, const repo::BillVisitor& visit);
+    // 分页遍历任意大的时间范围，after 传上一页返回的 next
+    model::BillPage QueryByTimePage(model::Timestamp from, model::Timestamp to,
+                                   const std::optional<model::BillCursor>& after, int page_size);
     
 private:
     std::shared_ptr<repo::IBillRepository> bill_repository_;
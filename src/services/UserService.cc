@@ -1,6 +1,8 @@
 #include "UserService.h"
+#include "Metrics.h"
 
 std::optional<model::User> UserService::GetUser(int user_id){
+    METRICS_SCOPE(timer, "UserService.GetUser");
     if(user_id <= 0) {
         return std::nullopt;
     }
@@ -8,21 +10,25 @@ std::optional<model::User> UserService::GetUser(int user_id){
     if (!user.has_value()) {
         return std::nullopt;
     }
+    timer.Rows(1);
     return user;
 }
 
 std::vector<model::User> UserService::QueryUserByPhone(const std::string& phone){
+    METRICS_SCOPE(timer, "UserService.QueryUserByPhone");
     if (phone.empty()) {
         return std::vector<model::User>();
     }
     auto users = user_repository_->queryByPhonePartial(phone);
+    timer.Rows(users.size());
     return users;
 }
 
-void UserService::SetBalance(int user_id, double amount){
+void UserService::SetBalance(int user_id, model::Money amount){
+    METRICS_SCOPE(timer, "UserService.SetBalance");
     if (user_id <= 0) {
         return;
-    } else if (amount < 0) {
+    } else if (amount < model::Money()) {
         return;
     }
 
@@ -7,7 +7,7 @@ public:
 
     std::optional<model::User> GetUser(int user_id);
     std::vector<model::User> QueryUserByPhone(const std::string& phone);
-    void SetBalance(int user_id, double amount);
+    void SetBalance(int user_id, model::Money amount);
 private:
     std::shared_ptr<repo::IUserRepository> user_repository_;
 };
\ No newline at end of file
@@ -0,0 +1,152 @@
+#include <gtest/gtest.h>
+#include "TaskExecutor.h"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+// 代替 ftxui 的事件循环：poster 把闭包放进队列，由测试线程（充当 UI 线程）取出执行
+class FakeUiQueue {
+public:
+    TaskExecutor::Poster Poster() {
+        return [this](TaskExecutor::Closure closure) {
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                closures_.push_back(std::move(closure));
+            }
+            posted_.notify_one();
+        };
+    }
+
+    // 等待并执行一个回到 UI 线程的闭包，超时返回 false
+    bool RunOne(std::chrono::milliseconds timeout = std::chrono::seconds(5)) {
+        TaskExecutor::Closure closure;
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            if (!posted_.wait_for(lock, timeout, [this] { return !closures_.empty(); })) {
+                return false;
+            }
+            closure = std::move(closures_.front());
+            closures_.pop_front();
+        }
+        closure();
+        return true;
+    }
+
+private:
+    std::mutex mutex_;
+    std::condition_variable posted_;
+    std::deque<TaskExecutor::Closure> closures_;
+};
+
+class TaskExecutorTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        executor_ = std::make_unique<TaskExecutor>();
+        executor_->SetPoster(ui_.Poster());
+    }
+
+    void TearDown() override {
+        executor_.reset();
+    }
+
+    FakeUiQueue ui_;
+    std::unique_ptr<TaskExecutor> executor_;
+};
+
+TEST_F(TaskExecutorTest, Submit_DeliversResultOnUiThread) {
+    int result = 0;
+    std::string error;
+
+    executor_->Submit([] { return 42; },
+                      [&](int value) { result = value; },
+                      [&](const std::string& e) { error = e; });
+
+    ASSERT_TRUE(ui_.RunOne());
+    EXPECT_EQ(result, 42);
+    EXPECT_EQ(error, "");
+}
+
+TEST_F(TaskExecutorTest, Submit_WorkThrows_CallsFailed) {
+    bool done_called = false;
+    std::string error;
+
+    executor_->Submit([]() -> int { throw std::runtime_error("database is locked"); },
+                      [&](int) { done_called = true; },
+                      [&](const std::string& e) { error = e; });
+
+    ASSERT_TRUE(ui_.RunOne());
+    EXPECT_FALSE(done_called);
+    EXPECT_EQ(error, "database is locked");
+
+    // 工作线程没有因异常退出
+    int result = 0;
+    executor_->Submit([] { return 7; }, [&](int value) { result = value; }, [](const std::string&) {});
+    ASSERT_TRUE(ui_.RunOne());
+    EXPECT_EQ(result, 7);
+}
+
+TEST_F(TaskExecutorTest, CancelPending_DropsStaleResults) {
+    std::promise<void> started;
+    std::promise<void> release;
+    auto release_future = release.get_future().share();
+    std::atomic<bool> queued_ran{false};
+    bool done_called = false;
+
+    executor_->Submit(
+        [&started, release_future] {
+            started.set_value();
+            release_future.wait();
+            return 1;
+        },
+        [&](int) { done_called = true; },
+        [&](const std::string&) { done_called = true; });
+    executor_->Submit([&] { queued_ran = true; return 2; },
+                      [&](int) { done_called = true; },
+                      [&](const std::string&) { done_called = true; });
+    started.get_future().wait();
+
+    // 正在执行的请求跑完后结果被丢弃，排队中的请求不再执行
+    executor_->CancelPending();
+    EXPECT_EQ(executor_->PendingCount(), 0u);
+    release.set_value();
+
+    ASSERT_TRUE(ui_.RunOne());
+    EXPECT_FALSE(done_called);
+    EXPECT_FALSE(ui_.RunOne(std::chrono::milliseconds(50)));
+    EXPECT_FALSE(queued_ran);
+
+    // 取消之后提交的请求照常回调
+    int result = 0;
+    executor_->Submit([] { return 3; }, [&](int value) { result = value; }, [](const std::string&) {});
+    ASSERT_TRUE(ui_.RunOne());
+    EXPECT_EQ(result, 3);
+}
+
+TEST_F(TaskExecutorTest, Destructor_JoinsRunningWork) {
+    std::promise<void> started;
+    std::atomic<bool> finished{false};
+    std::atomic<bool> queued_ran{false};
+
+    executor_->Submit(
+        [&] {
+            started.set_value();
+            std::this_thread::sleep_for(std::chrono::milliseconds(50));
+            finished = true;
+            return 0;
+        },
+        [](int) {}, [](const std::string&) {});
+    executor_->Submit([&] { queued_ran = true; return 0; }, [](int) {}, [](const std::string&) {});
+    started.get_future().wait();
+
+    executor_.reset();
+
+    EXPECT_TRUE(finished);
+    EXPECT_FALSE(queued_ran);
+}
@@ -5,6 +5,7 @@
 #include "BillRepositoryImpl.h"
 #include "EventRepositoryImpl.h"
 #include "AnnotationRepositoryImpl.h"
+#include "QueryArena.h"
 #include <memory>
 
 class DatabaseTestBase : public ::testing::Test {
@@ -39,7 +40,7 @@ protected:
         user1.username = "TestUser1";
         user1.password = "password123";
         user1.role = "user";
-        user1.balance = 1000.0;
+        user1.balance = model::Money(100000);
         user_repo_->save(user1);
         
         model::User user2;
@@ -47,7 +48,7 @@ protected:
         user2.username = "TestAdmin";
         user2.password = "admin123";
         user2.role = "admin";
-        user2.balance = 5000.0;
+        user2.balance = model::Money(500000);
         user_repo_->save(user2);
         
         // 创建测试事件
@@ -76,7 +77,7 @@ protected:
         user.username = username;
         user.password = password;
         user.role = "user";
-        user.balance = 0.0;
+        user.balance = model::Money(0);
         return user;
     }
     
@@ -85,7 +86,7 @@ protected:
         model::Bill bill;
         bill.owner_id = owner_id;
         bill.event_id = event_id;
-        bill.amount = amount;
+        bill.amount = model::Money::FromDouble(amount);
         bill.description = desc;
         return bill;
     }
@@ -18,11 +18,9 @@ protected:
             model::Bill bill;
             bill.owner_id = user->id;
             bill.event_id = event->id;
-            bill.amount = 100.0;
+            bill.amount = model::Money(10000);
             bill.description = "Test bill for annotation";
-            bill_repo_->save(bill);
-            
-            test_bill_id_++;
+            test_bill_id_ = bill_repo_->save(bill);
         }
     }
 };
@@ -34,8 +32,7 @@ TEST_F(AnnotationRepositoryTest, Save_NewAnnotation_Success) {
     auto annotation = CreateAnnotation(test_bill_id_, test_user_id_, "This is a note");
     
     // Act
-    annotation_repo_->save(annotation);
-    annotation.id++;
+    annotation.id = annotation_repo_->save(annotation);
     
     // Assert
     auto saved = annotation_repo_->findById(annotation.id);
@@ -48,8 +45,7 @@ TEST_F(AnnotationRepositoryTest, Save_NewAnnotation_Success) {
 TEST_F(AnnotationRepositoryTest, Save_UpdateExisting_Success) {
     // Arrange
     auto annotation = CreateAnnotation(test_bill_id_, test_user_id_, "Original");
-    annotation_repo_->save(annotation);
-    annotation.id++;
+    annotation.id = annotation_repo_->save(annotation);
     int annotation_id = annotation.id;
     
     // Act
@@ -67,8 +63,7 @@ TEST_F(AnnotationRepositoryTest, Save_UpdateExisting_Success) {
 TEST_F(AnnotationRepositoryTest, FindById_Exists_ReturnsAnnotation) {
     // Arrange
     auto annotation = CreateAnnotation(test_bill_id_, test_user_id_, "Test");
-    annotation_repo_->save(annotation);
-    annotation.id++;
+    annotation.id = annotation_repo_->save(annotation);
     int annotation_id = annotation.id;
     
     // Act
@@ -92,8 +87,7 @@ TEST_F(AnnotationRepositoryTest, FindById_NotExists_ReturnsNullopt) {
 TEST_F(AnnotationRepositoryTest, Integration_CreateAndUpdate) {
     // 1. 创建注解
     auto annotation = CreateAnnotation(test_bill_id_, test_user_id_, "Initial");
-    annotation_repo_->save(annotation);
-    annotation.id++;
+    annotation.id = annotation_repo_->save(annotation);
     int annotation_id = annotation.id;
     
     // 2.  查询验证
@@ -109,4 +103,37 @@ TEST_F(AnnotationRepositoryTest, Integration_CreateAndUpdate) {
     auto updated = annotation_repo_->findById(annotation_id);
     ASSERT_TRUE(updated.has_value());
     EXPECT_EQ(updated->content, "Final version");
-}
\ No newline at end of file
+}
+
+// ==================== findByBillId 测试 ====================
+
+TEST_F(AnnotationRepositoryTest, FindByBillId_Pmr_MatchesDefault) {
+    // Arrange
+    for (const char* content : {"First note that is longer than the SSO buffer", "Second"}) {
+        annotation_repo_->save(CreateAnnotation(test_bill_id_, test_user_id_, content));
+    }
+    QueryArena arena(4096);
+    auto expected = annotation_repo_->findByBillId(test_bill_id_);
+
+    // Act
+    auto annotations = annotation_repo_->findByBillId(test_bill_id_, arena.Resource());
+
+    // Assert
+    ASSERT_EQ(annotations.size(), 2);
+    ASSERT_EQ(expected.size(), 2);
+    for (size_t i = 0; i < annotations.size(); ++i) {
+        EXPECT_EQ(annotations[i].id, expected[i].id);
+        EXPECT_EQ(annotations[i].content, expected[i].content);
+        EXPECT_EQ(annotations[i].content.get_allocator().resource(), arena.Resource());
+    }
+}
+
+TEST_F(AnnotationRepositoryTest, FindByBillId_Pmr_DatabaseError_Throws) {
+    // Arrange
+    auto con = db_->GetStorage().get_connection();
+    ASSERT_EQ(sqlite3_exec(con.get(), "DROP TABLE annotations", nullptr, nullptr, nullptr), SQLITE_OK);
+    QueryArena arena(4096);
+
+    // Act & Assert
+    EXPECT_THROW(annotation_repo_->findByBillId(test_bill_id_, arena.Resource()), std::runtime_error);
+}
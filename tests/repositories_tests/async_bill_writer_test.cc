@@ -0,0 +1,116 @@
+#include "DatabaseTestBase.h"
+#include "AsyncBillWriter.h"
+#include <atomic>
+#include <future>
+#include <set>
+
+class AsyncBillWriterTest : public DatabaseTestBase {
+protected:
+    void SetUp() override {
+        DatabaseTestBase::SetUp();
+        owner_id_ = user_repo_->queryByPhone("13800000001")->id;
+        event_id_ = event_repo_->findByName("餐饮")->id;
+    }
+
+    model::Bill MakeBill(int i) {
+        auto bill = CreateBill(owner_id_, event_id_, 10.0 + i, "Async_" + std::to_string(i));
+        bill.created_at = 1700000000 + i;
+        return bill;
+    }
+
+    int owner_id_ = 0;
+    int event_id_ = 0;
+};
+
+TEST_F(AsyncBillWriterTest, Submit_ReturnsAssignedIdAndDurable) {
+    AsyncBillWriter writer(bill_repo_);
+
+    auto result = writer.submit(MakeBill(0)).get();
+
+    EXPECT_TRUE(result.durable);
+    EXPECT_TRUE(result.error.empty());
+    ASSERT_GT(result.id, 0);
+    auto saved = bill_repo_->findById(result.id);
+    ASSERT_TRUE(saved.has_value());
+    EXPECT_EQ(saved->description, "Async_0");
+}
+
+TEST_F(AsyncBillWriterTest, Burst_GroupedIntoFewCommits) {
+    AsyncBillWriter::Options options;
+    options.max_batch_rows = 100;
+    options.max_delay = std::chrono::milliseconds(1000);
+    AsyncBillWriter writer(bill_repo_, options);
+
+    std::vector<std::future<repo::SaveResult>> futures;
+    for (int i = 0; i < 300; ++i) {
+        futures.push_back(writer.submit(MakeBill(i)));
+    }
+    writer.flush();
+
+    std::set<int> ids;
+    for (auto& f : futures) {
+        auto r = f.get();
+        EXPECT_TRUE(r.durable);
+        ids.insert(r.id);
+    }
+    EXPECT_EQ(ids.size(), 300u);
+
+    auto stats = writer.stats();
+    EXPECT_EQ(stats.rows, 300);
+    EXPECT_EQ(stats.failures, 0);
+    EXPECT_LE(stats.commits, 6);
+}
+
+TEST_F(AsyncBillWriterTest, Queries_SeePendingWrites) {
+    AsyncBillWriter::Options options;
+    options.max_delay = std::chrono::milliseconds(10000);
+    AsyncBillWriter writer(bill_repo_, options);
+
+    for (int i = 0; i < 5; ++i) {
+        writer.saveAsync(MakeBill(i), nullptr);
+    }
+
+    // 查询前先 flush，不必等 max_delay
+    auto rows = writer.queryByTime(owner_id_, 1700000000, 1700000010);
+    EXPECT_EQ(rows.size(), 5u);
+}
+
+TEST_F(AsyncBillWriterTest, Update_AppliedInOrder) {
+    AsyncBillWriter writer(bill_repo_);
+    auto bill = MakeBill(0);
+    bill.id = writer.submit(bill).get().id;
+
+    bill.description = "Updated";
+    auto result = writer.submit(bill).get();
+
+    EXPECT_TRUE(result.durable);
+    EXPECT_EQ(result.id, bill.id);
+    EXPECT_EQ(writer.findById(bill.id)->description, "Updated");
+}
+
+TEST_F(AsyncBillWriterTest, Destructor_DrainsQueue) {
+    std::atomic<int> done{0};
+    {
+        AsyncBillWriter::Options options;
+        options.max_delay = std::chrono::milliseconds(10000);
+        AsyncBillWriter writer(bill_repo_, options);
+        for (int i = 0; i < 20; ++i) {
+            writer.saveAsync(MakeBill(i), [&done](const repo::SaveResult& r) {
+                if (r.durable) {
+                    ++done;
+                }
+            });
+        }
+    }
+
+    EXPECT_EQ(done.load(), 20);
+    EXPECT_EQ(bill_repo_->queryByTime(owner_id_, 1700000000, 1700000100).size(), 20u);
+}
+
+TEST_F(AsyncBillWriterTest, DefaultSaveAsync_WritesSynchronously) {
+    repo::SaveResult result;
+    bill_repo_->saveAsync(MakeBill(0), [&result](const repo::SaveResult& r) { result = r; });
+
+    EXPECT_TRUE(result.durable);
+    EXPECT_TRUE(bill_repo_->findById(result.id).has_value());
+}
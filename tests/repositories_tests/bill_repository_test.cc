@@ -1,4 +1,6 @@
 #include "DatabaseTestBase.h"
+#include <limits>
+#include <memory_resource>
 
 class BillRepositoryTest : public DatabaseTestBase {
 protected:
@@ -14,7 +16,7 @@ protected:
                 model::Bill bill;
                 bill.owner_id = user->id;
                 bill.event_id = event->id;
-                bill.amount = 100.0 * (i + 1);
+                bill.amount = model::Money(10000 * (i + 1));
                 bill.description = "TestBill_" + std::to_string(i);
                 bill.created_at = model::Now() - (5 - i) * 3600;  // 每小时一条
                 bill_repo_->save(bill);
@@ -25,8 +27,7 @@ protected:
 
 // ==================== save 测试 ====================
 
-// 暂时禁用，目前save无法返回id，无法通过id获取save信息
-TEST_F(BillRepositoryTest, DISABLED_Save_NewBill_Success) {
+TEST_F(BillRepositoryTest, Save_NewBill_Success) {
     // Arrange
     auto user = user_repo_->queryByPhone("13800000001");
     auto event = event_repo_->findByName("交通");
@@ -36,12 +37,13 @@ TEST_F(BillRepositoryTest, DISABLED_Save_NewBill_Success) {
     auto bill = CreateBill(user->id, event->id, 88.50, "Bus ticket");
     
     // Act
-    bill_repo_->save(bill);
+    bill.id = bill_repo_->save(bill);
     
     // Assert
+    EXPECT_GT(bill.id, 0);
     auto saved = bill_repo_->findById(bill.id);
     ASSERT_TRUE(saved.has_value());
-    EXPECT_DOUBLE_EQ(saved->amount, 88.50);
+    EXPECT_EQ(saved->amount.cents, 8850);
     EXPECT_EQ(saved->description, "Bus ticket");
 }
 
@@ -53,21 +55,55 @@ TEST_F(BillRepositoryTest, Save_UpdateExisting_Success) {
     auto bills = bill_repo_->queryByEvent(user->id, event->id);
     ASSERT_FALSE(bills.empty());
     
-    auto bill = bills[0];
-    double original_amount = bill.amount;
+    auto bill = *bill_repo_->findById(bills[0].id);
     
     // Act
-    bill.amount = 999.99;
+    bill.amount = model::Money(99999);
     bill.description = "Updated description";
     bill_repo_->save(bill);
     
     // Assert
     auto updated = bill_repo_->findById(bill.id);
     ASSERT_TRUE(updated.has_value());
-    EXPECT_DOUBLE_EQ(updated->amount, 999.99);
+    EXPECT_EQ(updated->amount.cents, 99999);
     EXPECT_EQ(updated->description, "Updated description");
 }
 
+// ==================== saveBatch 测试 ====================
+
+TEST_F(BillRepositoryTest, SaveBatch_NewBills_ReturnsIds) {
+    // Arrange
+    auto user = user_repo_->queryByPhone("13800000001");
+    auto event = event_repo_->findByName("交通");
+    ASSERT_TRUE(user.has_value());
+    ASSERT_TRUE(event.has_value());
+
+    std::vector<model::Bill> batch;
+    for (int i = 0; i < 3; ++i) {
+        batch.push_back(CreateBill(user->id, event->id, 10.0 * (i + 1), "Batch_" + std::to_string(i)));
+    }
+
+    // Act
+    auto ids = bill_repo_->saveBatch(batch);
+
+    // Assert
+    ASSERT_EQ(ids.size(), 3);
+    for (size_t i = 0; i < ids.size(); ++i) {
+        auto saved = bill_repo_->findById(ids[i]);
+        ASSERT_TRUE(saved.has_value());
+        EXPECT_EQ(saved->description, "Batch_" + std::to_string(i));
+        EXPECT_EQ(saved->amount.cents, 1000 * static_cast<int64_t>(i + 1));
+    }
+}
+
+TEST_F(BillRepositoryTest, SaveBatch_Empty_ReturnsEmpty) {
+    // Act
+    auto ids = bill_repo_->saveBatch({});
+
+    // Assert
+    EXPECT_TRUE(ids.empty());
+}
+
 // ==================== findById 测试 ====================
 
 TEST_F(BillRepositoryTest, FindById_Exists_ReturnsBill) {
@@ -87,6 +123,22 @@ TEST_F(BillRepositoryTest, FindById_Exists_ReturnsBill) {
     EXPECT_EQ(found->id, bill_id);
 }
 
+TEST_F(BillRepositoryTest, FindById_Exists_FillsEvent) {
+    // Arrange
+    auto user = user_repo_->queryByPhone("13800000001");
+    auto event = event_repo_->findByName("餐饮");
+    auto bills = bill_repo_->queryByEvent(user->id, event->id);
+    ASSERT_FALSE(bills.empty());
+
+    // Act
+    auto found = bill_repo_->findById(bills[0].id);
+
+    // Assert
+    ASSERT_TRUE(found.has_value());
+    EXPECT_EQ(found->event.id, event->id);
+    EXPECT_EQ(found->event.name, "餐饮");
+}
+
 TEST_F(BillRepositoryTest, FindById_NotExists_ReturnsNullopt) {
     // Act
     auto found = bill_repo_->findById(99999);
@@ -121,6 +173,42 @@ TEST_F(BillRepositoryTest, QueryByEvent_NoBills_ReturnsEmpty) {
     EXPECT_TRUE(bills.empty());
 }
 
+TEST_F(BillRepositoryTest, QueryByEventName_HasBills_ReturnsList) {
+    // Act
+    auto bills = bill_repo_->queryByEvent("餐饮");
+
+    // Assert
+    EXPECT_EQ(bills.size(), 5);
+}
+
+TEST_F(BillRepositoryTest, QueryByEventName_Unknown_ReturnsEmpty) {
+    // Act
+    auto bills = bill_repo_->queryByEvent("不存在");
+
+    // Assert
+    EXPECT_TRUE(bills.empty());
+}
+
+// ==================== queryByPhone 测试 ====================
+
+TEST_F(BillRepositoryTest, QueryByPhone_HasBills_ReturnsList) {
+    // Act
+    auto bills = bill_repo_->queryByPhone("13800000001");
+    auto repeated = bill_repo_->queryByPhone("13800000001");
+
+    // Assert - 预编译语句重复执行结果一致
+    EXPECT_EQ(bills.size(), 5);
+    EXPECT_EQ(repeated.size(), 5);
+}
+
+TEST_F(BillRepositoryTest, QueryByPhone_NoBills_ReturnsEmpty) {
+    // Act
+    auto bills = bill_repo_->queryByPhone("13800000002");
+
+    // Assert
+    EXPECT_TRUE(bills.empty());
+}
+
 // ==================== queryByTime 测试 ====================
 
 TEST_F(BillRepositoryTest, QueryByTime_WithinRange_ReturnsBills) {
@@ -136,6 +224,30 @@ TEST_F(BillRepositoryTest, QueryByTime_WithinRange_ReturnsBills) {
     EXPECT_EQ(bills.size(), 5);
 }
 
+TEST_F(BillRepositoryTest, QueryByTime_ReturnsRowFields) {
+    // Arrange
+    auto user = user_repo_->queryByPhone("13800000001");
+    auto event = event_repo_->findByName("餐饮");
+    model::Timestamp from = model::Now() - 24 * 3600;
+    model::Timestamp to = model::Now();
+
+    // Act
+    auto rows = bill_repo_->queryByTime(user->id, from, to);
+
+    // Assert
+    ASSERT_EQ(rows.size(), 5);
+    for (const auto& row : rows) {
+        auto full = bill_repo_->findById(row.id);
+        ASSERT_TRUE(full.has_value());
+        EXPECT_EQ(row.owner_id, user->id);
+        EXPECT_EQ(row.event_id, event->id);
+        EXPECT_EQ(row.amount, full->amount);
+        EXPECT_EQ(row.created_at, full->created_at);
+        EXPECT_EQ(row.description, full->description);
+        EXPECT_EQ(row.has_annotation, full->has_annotation);
+    }
+}
+
 TEST_F(BillRepositoryTest, QueryByTime_OutsideRange_ReturnsEmpty) {
     // Arrange
     auto user = user_repo_->queryByPhone("13800000001");
@@ -168,6 +280,399 @@ TEST_F(BillRepositoryTest, QueryByTimeInOrder_ReturnsOrderedByTime) {
     }
 }
 
+// ==================== 聚合测试 ====================
+
+TEST_F(BillRepositoryTest, TotalsByEvent_GroupsByEvent) {
+    // Arrange
+    auto user = user_repo_->queryByPhone("13800000001");
+    auto dining = event_repo_->findByName("餐饮");
+    auto transport = event_repo_->findByName("交通");
+    bill_repo_->save(CreateBill(user->id, transport->id, 20.0));
+    model::Timestamp from = model::Now() - 24 * 3600;
+    model::Timestamp to = model::Now();
+
+    // Act
+    auto totals = bill_repo_->totalsByEvent(from, to);
+
+    // Assert
+    ASSERT_EQ(totals.size(), 2);
+    for (const auto& t : totals) {
+        if (t.key == dining->id) {
+            EXPECT_EQ(t.count, 5);
+            EXPECT_EQ(t.sum.cents, 150000);
+        } else {
+            EXPECT_EQ(t.key, transport->id);
+            EXPECT_EQ(t.count, 1);
+            EXPECT_EQ(t.sum.cents, 2000);
+        }
+    }
+}
+
+TEST_F(BillRepositoryTest, TotalsByOwner_SingleOwner) {
+    // Arrange
+    auto user = user_repo_->queryByPhone("13800000001");
+    model::Timestamp from = model::Now() - 24 * 3600;
+    model::Timestamp to = model::Now();
+
+    // Act
+    auto totals = bill_repo_->totalsByOwner(from, to);
+
+    // Assert
+    ASSERT_EQ(totals.size(), 1);
+    EXPECT_EQ(totals[0].key, user->id);
+    EXPECT_EQ(totals[0].count, 5);
+    EXPECT_EQ(totals[0].sum.cents, 150000);
+}
+
+TEST_F(BillRepositoryTest, TotalsByPeriod_Day_GroupsByDate) {
+    // Arrange - 2024-01-01 00:00:00 UTC 起连续两天
+    auto user = user_repo_->queryByPhone("13800000001");
+    auto event = event_repo_->findByName("交通");
+    const model::Timestamp day0 = 1704067200;
+    std::vector<model::Bill> batch;
+    for (model::Timestamp ts : {day0 + 10, day0 + 3600, day0 + 86400 + 5}) {
+        auto bill = CreateBill(user->id, event->id, 10.0);
+        bill.created_at = ts;
+        batch.push_back(bill);
+    }
+    bill_repo_->saveBatch(batch);
+
+    // Act
+    auto totals = bill_repo_->totalsByPeriod(day0, day0 + 2 * 86400, model::Granularity::Day);
+
+    // Assert
+    ASSERT_EQ(totals.size(), 2);
+    EXPECT_EQ(totals[0].period, "2024-01-01");
+    EXPECT_EQ(totals[0].count, 2);
+    EXPECT_EQ(totals[0].sum.cents, 2000);
+    EXPECT_EQ(totals[1].period, "2024-01-02");
+    EXPECT_EQ(totals[1].count, 1);
+}
+
+TEST_F(BillRepositoryTest, Summary_ComputesStatistics) {
+    // Arrange
+    model::Timestamp from = model::Now() - 24 * 3600;
+    model::Timestamp to = model::Now();
+
+    // Act
+    auto s = bill_repo_->summary(from, to);
+
+    // Assert
+    EXPECT_EQ(s.count, 5);
+    EXPECT_EQ(s.sum.cents, 150000);
+    EXPECT_EQ(s.min.cents, 10000);
+    EXPECT_EQ(s.max.cents, 50000);
+    EXPECT_EQ(s.avg.cents, 30000);
+}
+
+TEST_F(BillRepositoryTest, Summary_EmptyRange_ReturnsZero) {
+    // Act
+    auto s = bill_repo_->summary(0, 1);
+
+    // Assert
+    EXPECT_EQ(s.count, 0);
+    EXPECT_EQ(s.sum.cents, 0);
+}
+
+// ==================== 每日汇总测试 ====================
+
+TEST_F(BillRepositoryTest, Rollups_AfterSaveUpdateRemove_StayConsistent) {
+    // Arrange
+    auto user = user_repo_->queryByPhone("13800000001");
+    auto transport = event_repo_->findByName("交通");
+    auto bills = bill_repo_->queryByEvent("餐饮");
+    ASSERT_GE(bills.size(), 2);
+
+    // Act - 修改金额、事件和日期，删除一条
+    auto edited = *bill_repo_->findById(bills[0].id);
+    edited.amount = model::Money(4200);
+    edited.event_id = transport->id;
+    edited.created_at -= 3 * 86400;
+    bill_repo_->save(edited);
+    bill_repo_->remove(bills[1].id);
+    bill_repo_->save(CreateBill(user->id, transport->id, 7.5));
+
+    // Assert
+    EXPECT_TRUE(bill_repo_->checkRollups().empty());
+}
+
+TEST_F(BillRepositoryTest, Rollups_Rebuild_RepairsDrift) {
+    // Arrange - 绕过仓库直接改 bills，制造不一致
+    auto& storage = db_->GetStorage();
+    auto bills = bill_repo_->queryByEvent("餐饮");
+    ASSERT_FALSE(bills.empty());
+    auto raw = storage.get<model::Bill>(bills[0].id);
+    raw.amount += model::Money(100);
+    storage.update(raw);
+    ASSERT_EQ(bill_repo_->checkRollups().size(), 1);
+
+    // Act
+    bill_repo_->rebuildRollups();
+
+    // Assert
+    EXPECT_TRUE(bill_repo_->checkRollups().empty());
+}
+
+TEST_F(BillRepositoryTest, TotalsByPeriod_PartialDays_MatchesBills) {
+    // Arrange - 跨三天，查询区间首尾都不对齐到整天
+    auto user = user_repo_->queryByPhone("13800000001");
+    auto event = event_repo_->findByName("交通");
+    const model::Timestamp day0 = 1704067200;  // 2024-01-01 UTC
+    std::vector<model::Bill> batch;
+    for (model::Timestamp ts : {day0 + 100, day0 + 7200, day0 + 86400 + 10, day0 + 2 * 86400 + 50, day0 + 2 * 86400 + 9000}) {
+        auto bill = CreateBill(user->id, event->id, 1.0);
+        bill.created_at = ts;
+        batch.push_back(bill);
+    }
+    bill_repo_->saveBatch(batch);
+
+    // Act
+    auto totals = bill_repo_->totalsByPeriod(day0 + 1000, day0 + 2 * 86400 + 100, model::Granularity::Day);
+
+    // Assert
+    ASSERT_EQ(totals.size(), 3);
+    EXPECT_EQ(totals[0].count, 1);  // 仅 day0 + 7200
+    EXPECT_EQ(totals[1].count, 1);
+    EXPECT_EQ(totals[2].count, 1);  // 仅 day0 + 2 天 + 50
+}
+
+TEST_F(BillRepositoryTest, TotalsByPeriod_FullInt64Range_CountsEveryBill) {
+    // Arrange
+    const auto lowest = std::numeric_limits<model::Timestamp>::min();
+    const auto highest = std::numeric_limits<model::Timestamp>::max();
+    int64_t expected = static_cast<int64_t>(bill_repo_->queryByTime(lowest, highest).size());
+    ASSERT_GT(expected, 0);
+
+    // Act
+    auto full = bill_repo_->totalsByPeriod(lowest, highest, model::Granularity::Day);
+    auto from_zero = bill_repo_->totalsByPeriod(0, highest, model::Granularity::Day);
+
+    // Assert
+    int64_t full_count = 0;
+    for (const auto& t : full) {
+        full_count += t.count;
+    }
+    int64_t from_zero_count = 0;
+    for (const auto& t : from_zero) {
+        from_zero_count += t.count;
+    }
+    EXPECT_EQ(full_count, expected);
+    EXPECT_EQ(from_zero_count, expected);
+}
+
+// ==================== forEach 测试 ====================
+
+TEST_F(BillRepositoryTest, ForEachByTimeInOrder_MatchesQueryByTimeInOrder) {
+    // Arrange
+    model::Timestamp from = model::Now() - 24 * 3600;
+    model::Timestamp to = model::Now();
+    auto expected = bill_repo_->queryByTimeInOrder(from, to);
+
+    // Act
+    std::vector<int> visited;
+    bill_repo_->forEachByTimeInOrder(from, to, [&](const model::BillRow& bill) {
+        visited.push_back(bill.id);
+    });
+
+    // Assert
+    ASSERT_EQ(visited.size(), expected.size());
+    for (size_t i = 0; i < visited.size(); ++i) {
+        EXPECT_EQ(visited[i], expected[i].id);
+    }
+}
+
+TEST_F(BillRepositoryTest, ForEachByTime_OutsideRange_NeverCalled) {
+    // Arrange
+    model::Timestamp from = model::Now() - 48 * 3600;
+    model::Timestamp to = model::Now() - 24 * 3600;
+
+    // Act
+    int calls = 0;
+    bill_repo_->forEachByTime(from, to, [&](const model::BillRow&) { ++calls; });
+
+    // Assert
+    EXPECT_EQ(calls, 0);
+}
+
+TEST_F(BillRepositoryTest, ForEachByTimeAndEventInOrder_RowsMatchQuery) {
+    // Arrange
+    model::Timestamp from = model::Now() - 24 * 3600;
+    model::Timestamp to = model::Now();
+    auto expected = bill_repo_->queryByTimeAndEventInOrder(from, to);
+
+    // Act
+    std::vector<model::BillRow> visited;
+    bill_repo_->forEachByTimeAndEventInOrder(from, to, [&](const model::BillRow& row) {
+        visited.push_back(row);
+    });
+
+    // Assert
+    ASSERT_EQ(visited.size(), expected.size());
+    for (size_t i = 0; i < visited.size(); ++i) {
+        EXPECT_EQ(visited[i].id, expected[i].id);
+        EXPECT_EQ(visited[i].owner_id, expected[i].owner_id);
+        EXPECT_EQ(visited[i].event_id, expected[i].event_id);
+        EXPECT_EQ(visited[i].amount, expected[i].amount);
+        EXPECT_EQ(visited[i].created_at, expected[i].created_at);
+        EXPECT_EQ(visited[i].description, expected[i].description);
+        EXPECT_EQ(visited[i].has_annotation, expected[i].has_annotation);
+    }
+}
+
+TEST_F(BillRepositoryTest, ForEachByTime_VisitorMayQueryRepository) {
+    // Arrange
+    model::Timestamp from = model::Now() - 24 * 3600;
+    model::Timestamp to = model::Now();
+    size_t expected = bill_repo_->queryByTime(from, to).size();
+    ASSERT_GT(expected, 1u);
+
+    // Act：回调里执行同一时间范围的 pmr 查询，不能打断外层遍历
+    size_t calls = 0;
+    bill_repo_->forEachByTime(from, to, [&](const model::BillRow&) {
+        ++calls;
+        EXPECT_EQ(bill_repo_->queryByTime(from, to, std::pmr::get_default_resource()).size(), expected);
+    });
+
+    // Assert
+    EXPECT_EQ(calls, expected);
+}
+
+// ==================== pmr 重载测试 ====================
+
+TEST_F(BillRepositoryTest, QueryByTimeInOrder_Pmr_MatchesDefault) {
+    // Arrange
+    QueryArena arena(4096);
+    model::Timestamp from = model::Now() - 24 * 3600;
+    model::Timestamp to = model::Now();
+    auto expected = bill_repo_->queryByTimeInOrder(from, to);
+
+    // Act
+    auto rows = bill_repo_->queryByTimeInOrder(from, to, arena.Resource());
+
+    // Assert
+    ASSERT_EQ(rows.size(), expected.size());
+    for (size_t i = 0; i < rows.size(); ++i) {
+        EXPECT_EQ(rows[i].id, expected[i].id);
+        EXPECT_EQ(rows[i].amount, expected[i].amount);
+        EXPECT_EQ(rows[i].created_at, expected[i].created_at);
+        EXPECT_EQ(rows[i].description, expected[i].description);
+        EXPECT_EQ(rows[i].description.get_allocator().resource(), arena.Resource());
+    }
+}
+
+TEST_F(BillRepositoryTest, QueryByTime_Pmr_ReusedArena) {
+    // Arrange
+    auto user = user_repo_->queryByPhone("13800000001");
+    QueryArena arena(4096);
+    model::Timestamp from = model::Now() - 24 * 3600;
+    model::Timestamp to = model::Now();
+
+    // Act - 同一个 arena 连续服务两次请求
+    size_t first_size = 0;
+    {
+        auto rows = bill_repo_->queryByTime(user->id, from, to, arena.Resource());
+        first_size = rows.size();
+    }
+    arena.Reset();
+    auto rows = bill_repo_->queryByTime(user->id, from, to, arena.Resource());
+
+    // Assert
+    EXPECT_EQ(first_size, 5);
+    EXPECT_EQ(rows.size(), 5);
+}
+
+// ==================== queryByTimePage 测试 ====================
+
+TEST_F(BillRepositoryTest, QueryByTimePage_WalksAllPagesInOrder) {
+    // Arrange
+    model::Timestamp from = model::Now() - 24 * 3600;
+    model::Timestamp to = model::Now();
+
+    // Act
+    std::vector<model::Bill> walked;
+    std::optional<model::BillCursor> cursor;
+    int pages = 0;
+    do {
+        auto page = bill_repo_->queryByTimePage(from, to, cursor, 2);
+        walked.insert(walked.end(), page.bills.begin(), page.bills.end());
+        cursor = page.next;
+        ++pages;
+    } while (cursor.has_value());
+
+    // Assert
+    EXPECT_EQ(pages, 3);
+    ASSERT_EQ(walked.size(), 5);
+    for (size_t i = 1; i < walked.size(); ++i) {
+        EXPECT_LT(walked[i-1].created_at, walked[i].created_at);
+    }
+}
+
+TEST_F(BillRepositoryTest, QueryByTimePage_SameTimestamp_OrdersById) {
+    // Arrange
+    auto user = user_repo_->queryByPhone("13800000001");
+    auto event = event_repo_->findByName("交通");
+    model::Timestamp ts = model::Now() - 48 * 3600;
+    std::vector<model::Bill> batch;
+    for (int i = 0; i < 3; ++i) {
+        auto bill = CreateBill(user->id, event->id, 10.0);
+        bill.created_at = ts;
+        batch.push_back(bill);
+    }
+    auto ids = bill_repo_->saveBatch(batch);
+
+    // Act
+    auto first = bill_repo_->queryByTimePage(ts, ts, std::nullopt, 2);
+    ASSERT_TRUE(first.next.has_value());
+    auto second = bill_repo_->queryByTimePage(ts, ts, first.next, 2);
+
+    // Assert
+    ASSERT_EQ(first.bills.size(), 2);
+    ASSERT_EQ(second.bills.size(), 1);
+    EXPECT_EQ(first.bills[0].id, ids[0]);
+    EXPECT_EQ(first.bills[1].id, ids[1]);
+    EXPECT_EQ(second.bills[0].id, ids[2]);
+    EXPECT_FALSE(second.next.has_value());
+}
+
+TEST_F(BillRepositoryTest, QueryByTimePage_FullInt64Range_ReturnsAllRows) {
+    // Arrange
+    const auto lowest = std::numeric_limits<model::Timestamp>::min();
+    const auto highest = std::numeric_limits<model::Timestamp>::max();
+    auto all = bill_repo_->queryByTime(lowest, highest);
+    ASSERT_FALSE(all.empty());
+
+    // Act
+    auto page = bill_repo_->queryByTimePage(lowest, highest, std::nullopt, 100);
+
+    // Assert
+    EXPECT_EQ(page.bills.size(), all.size());
+    EXPECT_FALSE(page.next.has_value());
+}
+
+TEST_F(BillRepositoryTest, QueryByTimePage_CursorOutsideRange_ResumesByPosition) {
+    // Arrange
+    auto user = user_repo_->queryByPhone("13800000001");
+    auto event = event_repo_->findByName("交通");
+    model::Timestamp ts = model::Now() - 72 * 3600;
+    std::vector<model::Bill> batch;
+    for (int i = 0; i < 3; ++i) {
+        auto bill = CreateBill(user->id, event->id, 10.0);
+        bill.created_at = ts + i;
+        batch.push_back(bill);
+    }
+    auto ids = bill_repo_->saveBatch(batch);
+
+    // Act：游标早于 from 时从 from 开始，晚于 to 时没有后续行
+    auto before = bill_repo_->queryByTimePage(ts, ts + 2, model::BillCursor{ts - 100, ids[2]}, 10);
+    auto after = bill_repo_->queryByTimePage(ts, ts + 2, model::BillCursor{ts + 100, 0}, 10);
+
+    // Assert
+    ASSERT_EQ(before.bills.size(), 3);
+    EXPECT_EQ(before.bills[0].id, ids[0]);
+    EXPECT_TRUE(after.bills.empty());
+    EXPECT_FALSE(after.next.has_value());
+}
+
 // ==================== remove 测试 ====================
 
 TEST_F(BillRepositoryTest, Remove_Exists_DeletesBill) {
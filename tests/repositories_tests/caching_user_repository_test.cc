@@ -0,0 +1,83 @@
+#include "DatabaseTestBase.h"
+#include "CachingUserRepository.h"
+
+class CachingUserRepositoryTest : public DatabaseTestBase {
+protected:
+    void SetUp() override {
+        DatabaseTestBase::SetUp();
+        cache_ = std::make_shared<CachingUserRepository>(user_repo_, 2);
+    }
+
+    std::shared_ptr<CachingUserRepository> cache_;
+};
+
+TEST_F(CachingUserRepositoryTest, QueryByPhone_SecondCallHits) {
+    auto first = cache_->queryByPhone("13800000001");
+    auto second = cache_->queryByPhone("13800000001");
+
+    ASSERT_TRUE(first.has_value());
+    ASSERT_TRUE(second.has_value());
+    EXPECT_EQ(first->id, second->id);
+    EXPECT_EQ(cache_->stats().misses, 1);
+    EXPECT_EQ(cache_->stats().hits, 1);
+}
+
+TEST_F(CachingUserRepositoryTest, FindById_HitsEntryLoadedByPhone) {
+    auto by_phone = cache_->queryByPhone("13800000001");
+    ASSERT_TRUE(by_phone.has_value());
+
+    auto by_id = cache_->findById(by_phone->id);
+
+    ASSERT_TRUE(by_id.has_value());
+    EXPECT_EQ(by_id->phone, "13800000001");
+    EXPECT_EQ(cache_->stats().hits, 1);
+}
+
+TEST_F(CachingUserRepositoryTest, Missing_NotCached) {
+    EXPECT_FALSE(cache_->queryByPhone("19999999999").has_value());
+    EXPECT_FALSE(cache_->queryByPhone("19999999999").has_value());
+
+    EXPECT_EQ(cache_->stats().misses, 2);
+    EXPECT_EQ(cache_->size(), 0u);
+}
+
+TEST_F(CachingUserRepositoryTest, Save_InvalidatesEntry) {
+    auto user = cache_->queryByPhone("13800000001");
+    ASSERT_TRUE(user.has_value());
+
+    user->username = "Renamed";
+    cache_->save(*user);
+
+    auto reloaded = cache_->findById(user->id);
+    ASSERT_TRUE(reloaded.has_value());
+    EXPECT_EQ(reloaded->username, "Renamed");
+    EXPECT_EQ(cache_->stats().invalidations, 1);
+}
+
+TEST_F(CachingUserRepositoryTest, SetBalanceByPhone_InvalidatesEntry) {
+    ASSERT_TRUE(cache_->queryByPhone("13800000001").has_value());
+
+    EXPECT_TRUE(cache_->setBalanceByPhone("13800000001", model::Money(4242)));
+
+    auto reloaded = cache_->queryByPhone("13800000001");
+    ASSERT_TRUE(reloaded.has_value());
+    EXPECT_EQ(reloaded->balance.cents, 4242);
+}
+
+TEST_F(CachingUserRepositoryTest, Capacity_EvictsLeastRecentlyUsed) {
+    cache_->save(CreateUser("13800000003", "Third"));
+
+    cache_->queryByPhone("13800000001");
+    cache_->queryByPhone("13800000002");
+    cache_->queryByPhone("13800000001"); // 13800000002 变为最久未用
+    cache_->queryByPhone("13800000003");
+
+    EXPECT_EQ(cache_->size(), 2u);
+    EXPECT_EQ(cache_->stats().evictions, 1);
+
+    auto before = cache_->stats().misses;
+    cache_->queryByPhone("13800000001");
+    EXPECT_EQ(cache_->stats().misses, before);
+    cache_->queryByPhone("13800000002");
+    EXPECT_EQ(cache_->stats().misses, before + 1);
+}
@@ -0,0 +1,293 @@
+#include <gtest/gtest.h>
+#include "DatabaseORM.h"
+#include "BillRepositoryImpl.h"
+#include "BillSearchIndex.h"
+#include "EventCatalog.h"
+#include "EventRepositoryImpl.h"
+#include "PhoneTrigramIndex.h"
+#include "StatementProfiler.h"
+#include "UserRepositoryImpl.h"
+#include <filesystem>
+
+class DatabaseORMTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        db_path_ = (std::filesystem::temp_directory_path() / "bill_management_orm_test.db").string();
+        RemoveFiles();
+    }
+
+    void TearDown() override {
+        RemoveFiles();
+    }
+
+    void RemoveFiles() {
+        for (const char* suffix : {"", "-wal", "-shm"}) {
+            std::filesystem::remove(db_path_ + suffix);
+        }
+    }
+
+    // 用独立连接读取 PRAGMA，验证设置确实写入了数据库
+    std::string ReadPragma(const std::string& name) {
+        sqlite3* raw = nullptr;
+        sqlite3_open(db_path_.c_str(), &raw);
+        sqlite3_stmt* stmt = nullptr;
+        std::string sql = "PRAGMA " + name;
+        sqlite3_prepare_v2(raw, sql.c_str(), -1, &stmt, nullptr);
+        std::string value;
+        if (sqlite3_step(stmt) == SQLITE_ROW) {
+            value = reinterpret_cast<const char*>(sqlite3_column_text(stmt, 0));
+        }
+        sqlite3_finalize(stmt);
+        sqlite3_close(raw);
+        return value;
+    }
+
+    int64_t QueryInt(const std::string& sql) {
+        sqlite3* raw = nullptr;
+        sqlite3_open(db_path_.c_str(), &raw);
+        sqlite3_stmt* stmt = nullptr;
+        sqlite3_prepare_v2(raw, sql.c_str(), -1, &stmt, nullptr);
+        int64_t value = sqlite3_step(stmt) == SQLITE_ROW ? sqlite3_column_int64(stmt, 0) : -1;
+        sqlite3_finalize(stmt);
+        sqlite3_close(raw);
+        return value;
+    }
+
+    int64_t CountIndex(const std::string& name) {
+        return QueryInt("SELECT count(*) FROM sqlite_master WHERE type = 'index' AND name = '" + name + "'");
+    }
+
+    void ExecRaw(const std::string& sql) {
+        sqlite3* raw = nullptr;
+        sqlite3_open(db_path_.c_str(), &raw);
+        ASSERT_EQ(sqlite3_exec(raw, sql.c_str(), nullptr, nullptr, nullptr), SQLITE_OK) << sqlite3_errmsg(raw);
+        sqlite3_close(raw);
+    }
+
+    std::string db_path_;
+};
+
+TEST_F(DatabaseORMTest, FromPreset_KnownNames_ReturnsOptions) {
+    auto durable = DatabaseOptions::FromPreset("durable");
+    auto balanced = DatabaseOptions::FromPreset("balanced");
+    auto ingest = DatabaseOptions::FromPreset("ingest");
+
+    ASSERT_TRUE(durable.has_value());
+    ASSERT_TRUE(balanced.has_value());
+    ASSERT_TRUE(ingest.has_value());
+    EXPECT_EQ(durable->synchronous, DatabaseOptions::Synchronous::Full);
+    EXPECT_EQ(balanced->synchronous, DatabaseOptions::Synchronous::Normal);
+    EXPECT_EQ(ingest->synchronous, DatabaseOptions::Synchronous::Off);
+}
+
+TEST_F(DatabaseORMTest, FromPreset_UnknownName_ReturnsNullopt) {
+    EXPECT_FALSE(DatabaseOptions::FromPreset("fast").has_value());
+}
+
+TEST_F(DatabaseORMTest, Open_FileDatabase_UsesWal) {
+    {
+        auto db = std::make_shared<DatabaseORM>(db_path_);
+        UserRepositoryImpl user_repo(db);
+        user_repo.save(model::User("13800000001", "TestUser1", "password123"));
+    }
+
+    EXPECT_EQ(ReadPragma("journal_mode"), "wal");
+}
+
+TEST_F(DatabaseORMTest, Open_DeleteJournal_KeepsRollbackJournal) {
+    auto options = DatabaseOptions::Durable();
+    options.journal_mode = DatabaseOptions::JournalMode::Delete;
+    {
+        auto db = std::make_shared<DatabaseORM>(db_path_, options);
+    }
+
+    EXPECT_EQ(ReadPragma("journal_mode"), "delete");
+}
+
+// 旧版本以 REAL（元）存储金额，打开时应迁移为 INTEGER（分）
+TEST_F(DatabaseORMTest, Open_LegacyRealAmounts_MigratesToCents) {
+    ExecRaw(
+        "CREATE TABLE users (id INTEGER PRIMARY KEY AUTOINCREMENT NOT NULL, phone TEXT UNIQUE NOT NULL, "
+        "username TEXT NOT NULL, password TEXT NOT NULL, role TEXT DEFAULT 'user' NOT NULL, "
+        "balance REAL DEFAULT 0.0 NOT NULL, created_at INTEGER NOT NULL);"
+        "CREATE TABLE events (id INTEGER PRIMARY KEY AUTOINCREMENT NOT NULL, name TEXT UNIQUE NOT NULL, "
+        "status INTEGER DEFAULT 0 NOT NULL, created_at INTEGER NOT NULL);"
+        "CREATE TABLE bills (id INTEGER PRIMARY KEY AUTOINCREMENT NOT NULL, owner_id INTEGER NOT NULL, "
+        "event_id INTEGER NOT NULL, description TEXT NOT NULL, amount REAL NOT NULL, created_at INTEGER NOT NULL, "
+        "has_annotation INTEGER DEFAULT 0 NOT NULL, "
+        "FOREIGN KEY(owner_id) REFERENCES users(id), FOREIGN KEY(event_id) REFERENCES events(id));"
+        "CREATE INDEX idx_bills_owner_created ON bills (owner_id, created_at);"
+        "INSERT INTO users VALUES (1, '13800000001', 'TestUser1', 'password123', 'user', 1234.56, 1700000000);"
+        "INSERT INTO events VALUES (1, '餐饮', 0, 1700000000);"
+        "INSERT INTO bills VALUES (1, 1, 1, 'Lunch', 19.99, 1700000000, 0);"
+        "INSERT INTO bills VALUES (2, 1, 1, 'Dinner', 0.29, 1700000100, 0);");
+
+    auto db = std::make_shared<DatabaseORM>(db_path_);
+    UserRepositoryImpl user_repo(db);
+    BillRepositoryImpl bill_repo(db);
+
+    auto user = user_repo.findById(1);
+    ASSERT_TRUE(user.has_value());
+    EXPECT_EQ(user->balance.cents, 123456);
+    auto lunch = bill_repo.findById(1);
+    auto dinner = bill_repo.findById(2);
+    ASSERT_TRUE(lunch.has_value());
+    ASSERT_TRUE(dinner.has_value());
+    EXPECT_EQ(lunch->amount.cents, 1999);
+    EXPECT_EQ(dinner->amount.cents, 29);
+    EXPECT_EQ(lunch->event.name, "餐饮");
+    EXPECT_TRUE(db->NeedsRollupRebuild());
+    EXPECT_EQ(QueryInt("PRAGMA user_version"), DatabaseORM::SchemaVersion());
+
+    // 旧表已清理，新行的 id 接在迁移过来的行之后
+    EXPECT_THROW(db->ExplainQueryPlan("SELECT * FROM bills_real_legacy"), std::runtime_error);
+    model::Bill bill;
+    bill.owner_id = 1;
+    bill.event_id = 1;
+    bill.amount = model::Money(500);
+    EXPECT_EQ(bill_repo.save(bill), 3);
+}
+
+TEST_F(DatabaseORMTest, Open_NewDatabase_StampsSchemaVersion) {
+    {
+        auto db = std::make_shared<DatabaseORM>(db_path_);
+        EXPECT_TRUE(db->NeedsRollupRebuild());
+    }
+
+    EXPECT_EQ(QueryInt("PRAGMA user_version"), DatabaseORM::SchemaVersion());
+    EXPECT_EQ(CountIndex("idx_bills_owner_event"), 1);
+}
+
+// 版本已是最新时不再执行 sync_schema：手工删掉的索引不会被补回
+TEST_F(DatabaseORMTest, Open_CurrentVersion_SkipsSyncSchema) {
+    std::make_shared<DatabaseORM>(db_path_);
+    ExecRaw("DROP INDEX idx_bills_owner_event");
+
+    auto db = std::make_shared<DatabaseORM>(db_path_);
+
+    EXPECT_EQ(CountIndex("idx_bills_owner_event"), 0);
+    EXPECT_FALSE(db->NeedsRollupRebuild());
+}
+
+// 版本化之前的数据库（user_version = 0）执行一次基线迁移后记下版本
+TEST_F(DatabaseORMTest, Open_UnversionedDatabase_RunsBaselineOnce) {
+    {
+        auto db = std::make_shared<DatabaseORM>(db_path_);
+        UserRepositoryImpl user_repo(db);
+        user_repo.save(model::User("13800000001", "TestUser1", "password123"));
+    }
+    ExecRaw("DROP INDEX idx_bills_owner_event; PRAGMA user_version = 0");
+
+    auto db = std::make_shared<DatabaseORM>(db_path_);
+    UserRepositoryImpl user_repo(db);
+
+    EXPECT_EQ(CountIndex("idx_bills_owner_event"), 1);
+    EXPECT_EQ(QueryInt("PRAGMA user_version"), DatabaseORM::SchemaVersion());
+    EXPECT_FALSE(db->NeedsRollupRebuild());
+    EXPECT_TRUE(user_repo.queryByPhone("13800000001").has_value());
+}
+
+TEST_F(DatabaseORMTest, Open_NewerSchemaVersion_Throws) {
+    std::make_shared<DatabaseORM>(db_path_);
+    ExecRaw("PRAGMA user_version = " + std::to_string(DatabaseORM::SchemaVersion() + 1));
+
+    EXPECT_THROW(DatabaseORM db(db_path_), std::runtime_error);
+}
+
+// 早期版本建过 idx_bills_created_event，迁移 2 把它删掉
+TEST_F(DatabaseORMTest, Open_Version1_DropsReplacedIndex) {
+    std::make_shared<DatabaseORM>(db_path_);
+    ExecRaw("CREATE INDEX idx_bills_created_event ON bills (created_at, event_id); PRAGMA user_version = 1");
+
+    auto db = std::make_shared<DatabaseORM>(db_path_);
+
+    EXPECT_EQ(CountIndex("idx_bills_created_event"), 0);
+    EXPECT_EQ(QueryInt("PRAGMA user_version"), DatabaseORM::SchemaVersion());
+}
+
+// 旧版用 unicode61 分词建的 bill_search 由迁移 3 按 trigram 重建，并填入已有账单
+TEST_F(DatabaseORMTest, Open_Version2_RebuildsSearchIndexWithTrigram) {
+    {
+        auto db = std::make_shared<DatabaseORM>(db_path_);
+        if (!db->GetSearchIndex().Available()) {
+            GTEST_SKIP() << "SQLite 未编译 FTS5 或不支持 trigram";
+        }
+        int owner = UserRepositoryImpl(db).save(model::User("13800000001", "TestUser1", "password123"));
+        model::Event event;
+        event.name = "交通";
+        int event_id = EventRepositoryImpl(db).save(event);
+        model::Bill bill;
+        bill.owner_id = owner;
+        bill.event_id = event_id;
+        bill.amount = model::Money(100);
+        bill.description = "taxi home";
+        BillRepositoryImpl(db).save(bill);
+    }
+    ExecRaw("DROP TABLE bill_search; "
+            "CREATE VIRTUAL TABLE bill_search USING fts5(description, annotations, tokenize = 'unicode61'); "
+            "PRAGMA user_version = 2");
+
+    auto db = std::make_shared<DatabaseORM>(db_path_);
+
+    EXPECT_EQ(QueryInt("SELECT count(*) FROM sqlite_master WHERE name = 'bill_search' AND sql LIKE '%trigram%'"), 1);
+    EXPECT_EQ(QueryInt("SELECT count(*) FROM bill_search"), 1);
+    EXPECT_EQ(db->GetSearchIndex().Search("axi", {}, 0, 0, 10).bills.size(), 1u);
+    EXPECT_EQ(QueryInt("PRAGMA user_version"), DatabaseORM::SchemaVersion());
+}
+
+// 已是最新版本时启动不再检查 bill_search：表缺失只让搜索不可用，不会重建
+TEST_F(DatabaseORMTest, Open_CurrentVersion_DoesNotRebuildSearchIndex) {
+    std::make_shared<DatabaseORM>(db_path_);
+    ExecRaw("DROP TABLE IF EXISTS bill_search");
+
+    auto db = std::make_shared<DatabaseORM>(db_path_);
+
+    EXPECT_FALSE(db->GetSearchIndex().Available());
+    EXPECT_EQ(QueryInt("SELECT count(*) FROM sqlite_master WHERE name = 'bill_search'"), 0);
+}
+
+// 第二个连接共享缓存与剖析器，写入对主连接可见
+TEST_F(DatabaseORMTest, OpenConnection_SharesCachesAndProfiler) {
+    DatabaseOptions options;
+    options.profile_statements = true;
+    auto db = std::make_shared<DatabaseORM>(db_path_, options);
+    int owner = UserRepositoryImpl(db).save(model::User("13800000001", "TestUser1", "password123"));
+    model::Event event;
+    event.name = "餐饮";
+    int event_id = EventRepositoryImpl(db).save(event);
+
+    auto writer = db->OpenConnection();
+
+    EXPECT_EQ(&writer->GetEventCatalog(), &db->GetEventCatalog());
+    EXPECT_EQ(&writer->GetPhoneIndex(), &db->GetPhoneIndex());
+    EXPECT_EQ(writer->GetProfiler(), db->GetProfiler());
+    EXPECT_NE(writer->GetStorage().get_connection().get(), db->GetStorage().get_connection().get());
+
+    db->GetProfiler()->Reset();
+    model::Bill bill;
+    bill.owner_id = owner;
+    bill.event_id = event_id;
+    bill.amount = model::Money(100);
+    int id = BillRepositoryImpl(writer).save(bill);
+
+    EXPECT_TRUE(BillRepositoryImpl(db).findById(id).has_value());
+    EXPECT_FALSE(db->GetProfiler()->Snapshot().empty());
+}
+
+// 第二个连接不执行迁移：手工回退的版本号与删掉的索引保持原样
+TEST_F(DatabaseORMTest, OpenConnection_SkipsMigrations) {
+    auto db = std::make_shared<DatabaseORM>(db_path_);
+    ExecRaw("DROP INDEX idx_bills_owner_event; PRAGMA user_version = 0");
+
+    auto writer = db->OpenConnection();
+
+    EXPECT_EQ(CountIndex("idx_bills_owner_event"), 0);
+    EXPECT_EQ(QueryInt("PRAGMA user_version"), 0);
+    EXPECT_FALSE(writer->NeedsRollupRebuild());
+}
+
+TEST_F(DatabaseORMTest, OpenConnection_InMemory_Throws) {
+    auto db = std::make_shared<DatabaseORM>(":memory:");
+
+    EXPECT_THROW(db->OpenConnection(), std::invalid_argument);
+}
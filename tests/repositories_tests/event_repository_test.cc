@@ -1,4 +1,5 @@
 #include "DatabaseTestBase.h"
+#include "EventCatalog.h"
 
 class EventRepositoryTest : public DatabaseTestBase {};
 
@@ -126,4 +127,78 @@ TEST_F(EventRepositoryTest, SetStatusById_NotExists_ReturnsFalse) {
     
     // Assert
     EXPECT_FALSE(result);
-}
\ No newline at end of file
+}
+
+TEST_F(EventRepositoryTest, SetStatusById_DeletedBehindCatalog_ReturnsFalse) {
+    // Arrange：字典中有该事件，数据库中的行已被绕过仓库删除
+    int id = event_repo_->save(CreateEvent("医疗"));
+    db_->GetStorage().remove<model::Event>(id);
+
+    // Act
+    bool result = event_repo_->setStatusById(id, model::EventStatus::Frozen);
+
+    // Assert：未更新任何行，字典中的状态保持不变
+    EXPECT_FALSE(result);
+    EXPECT_FALSE(event_repo_->isFrozen(id));
+}
+
+// ==================== EventCatalog 测试 ====================
+
+TEST_F(EventRepositoryTest, IsFrozen_ReflectsStatusChange) {
+    // Arrange
+    auto event = event_repo_->findByName("餐饮");
+    ASSERT_TRUE(event.has_value());
+    EXPECT_FALSE(event_repo_->isFrozen(event->id));
+
+    // Act
+    event_repo_->setStatusById(event->id, model::EventStatus::Frozen);
+
+    // Assert
+    EXPECT_TRUE(event_repo_->isFrozen(event->id));
+    EXPECT_FALSE(event_repo_->isFrozen(99999));
+}
+
+TEST_F(EventRepositoryTest, Catalog_PersistsStatusToDatabase) {
+    // Arrange
+    auto event = event_repo_->findByName("交通");
+    ASSERT_TRUE(event.has_value());
+
+    // Act
+    event_repo_->setStatusById(event->id, model::EventStatus::Frozen);
+
+    // Assert：绕过字典直接读表
+    auto row = db_->GetStorage().get<model::Event>(event->id);
+    EXPECT_EQ(row.status, model::EventStatus::Frozen);
+}
+
+TEST_F(EventRepositoryTest, Catalog_RenameDropsOldName) {
+    // Arrange
+    auto event = event_repo_->findByName("交通");
+    ASSERT_TRUE(event.has_value());
+
+    // Act
+    event->name = "出行";
+    event_repo_->save(*event);
+
+    // Assert
+    EXPECT_FALSE(event_repo_->findByName("交通").has_value());
+    auto renamed = event_repo_->findByName("出行");
+    ASSERT_TRUE(renamed.has_value());
+    EXPECT_EQ(renamed->id, event->id);
+    EXPECT_EQ(event_repo_->findById(event->id)->name, "出行");
+}
+
+TEST_F(EventRepositoryTest, Catalog_MissFallsBackToDatabase) {
+    // Arrange：字典已载入后绕过仓库直接插入
+    ASSERT_EQ(db_->GetEventCatalog().Size(), 3u);
+    auto event = CreateEvent("医疗");
+    int id = db_->GetStorage().insert(event);
+
+    // Act
+    auto found = event_repo_->findByName("医疗");
+
+    // Assert
+    ASSERT_TRUE(found.has_value());
+    EXPECT_EQ(found->id, id);
+    EXPECT_EQ(db_->GetEventCatalog().Size(), 4u);
+}
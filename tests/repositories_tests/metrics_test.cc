@@ -0,0 +1,92 @@
+#include "DatabaseTestBase.h"
+#include "Metrics.h"
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+
+namespace {
+
+uint64_t Calls(const std::string& name) {
+    auto s = metrics::Registry::Instance().Find(name);
+    return s.has_value() ? s->calls : 0;
+}
+
+void Timed(const std::string& name, uint64_t rows, bool fail) {
+    metrics::ScopedTimer timer(metrics::Registry::Instance().Get(name));
+    timer.Rows(rows);
+    if (fail) {
+        throw std::runtime_error("fail");
+    }
+}
+
+}
+
+class MetricsTest : public DatabaseTestBase {
+protected:
+    void SetUp() override {
+        DatabaseTestBase::SetUp();
+        metrics::Registry::Instance().Reset();
+    }
+};
+
+TEST(MetricsBucketTest, BucketBoundsContainValue) {
+    for (uint64_t v : {0ull, 1ull, 7ull, 8ull, 15ull, 16ull, 17ull, 1000ull, 123456789ull, 1ull << 39}) {
+        int b = metrics::BucketOf(v);
+        EXPECT_LE(metrics::BucketLower(b), v) << v;
+        EXPECT_LT(v, metrics::BucketLower(b) + metrics::BucketWidth(b)) << v;
+    }
+    EXPECT_EQ(metrics::BucketOf(~0ull), metrics::kBuckets - 1);
+}
+
+TEST_F(MetricsTest, Get_SameNameSameMetric) {
+    auto& a = metrics::Registry::Instance().Get("test.same");
+    auto& b = metrics::Registry::Instance().Get("test.same");
+    EXPECT_EQ(&a, &b);
+}
+
+TEST_F(MetricsTest, ScopedTimer_CountsCallsRowsAndExceptions) {
+    Timed("test.timer", 3, false);
+    Timed("test.timer", 4, false);
+    EXPECT_THROW(Timed("test.timer", 0, true), std::runtime_error);
+
+    auto s = metrics::Registry::Instance().Find("test.timer");
+    ASSERT_TRUE(s.has_value());
+    EXPECT_EQ(s->calls, 3u);
+    EXPECT_EQ(s->rows, 7u);
+    EXPECT_EQ(s->errors, 1u);
+    EXPECT_LE(s->PercentileNs(0.5), s->max_ns);
+}
+
+TEST_F(MetricsTest, ExitedThread_CountsKept) {
+    std::thread worker([] {
+        for (int i = 0; i < 10; ++i) {
+            Timed("test.thread", 1, false);
+        }
+    });
+    worker.join();
+
+    EXPECT_EQ(Calls("test.thread"), 10u);
+}
+
+TEST_F(MetricsTest, Repository_RecordsCallsAndRows) {
+    auto before = Calls("UserRepository.queryByPhone");
+
+    ASSERT_TRUE(user_repo_->queryByPhone("13800000001").has_value());
+    EXPECT_FALSE(user_repo_->queryByPhone("19999999999").has_value());
+
+    auto s = metrics::Registry::Instance().Find("UserRepository.queryByPhone");
+    ASSERT_TRUE(s.has_value());
+    EXPECT_EQ(s->calls - before, 2u);
+    EXPECT_EQ(s->rows, 1u);
+}
+
+TEST_F(MetricsTest, Dump_ListsOnlyCalledMetrics) {
+    Timed("test.dump.called", 1, false);
+    metrics::Registry::Instance().Get("test.dump.never");
+
+    std::ostringstream out;
+    metrics::Registry::Instance().Dump(out);
+
+    EXPECT_NE(out.str().find("test.dump.called"), std::string::npos);
+    EXPECT_EQ(out.str().find("test.dump.never"), std::string::npos);
+}
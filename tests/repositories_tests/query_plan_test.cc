@@ -0,0 +1,157 @@
+#include "DatabaseTestBase.h"
+#include <cctype>
+#include <functional>
+#include <memory_resource>
+
+// 计划检查针对 Repository 方法实际执行的语句：在连接上挂 SQLITE_TRACE_STMT，
+// 记下方法执行期间开始运行的语句原文（sqlite3_sql，参数未展开），再对其做 EXPLAIN QUERY PLAN
+class QueryPlanTest : public DatabaseTestBase {
+protected:
+    static constexpr model::Timestamp kDay = 1700006400;   // UTC 零点
+
+    // 执行 run，返回其间开始执行的、FROM 子句涉及 table 的 SELECT 语句
+    std::vector<std::string> Capture(const std::function<void()>& run, const std::string& table = "bills") {
+        std::vector<std::string> statements;
+        auto con = db_->GetStorage().get_connection();
+        sqlite3_trace_v2(con.get(), SQLITE_TRACE_STMT, &QueryPlanTest::OnTrace, &statements);
+        run();
+        sqlite3_trace_v2(con.get(), 0, nullptr, nullptr);
+
+        std::vector<std::string> matched;
+        for (const auto& sql : statements) {
+            std::string upper;
+            for (char c : sql) {
+                upper += static_cast<char>(std::toupper(static_cast<unsigned char>(c)));
+            }
+            std::string name;
+            for (char c : table) {
+                name += static_cast<char>(std::toupper(static_cast<unsigned char>(c)));
+            }
+            if (upper.rfind("SELECT", 0) == 0 && upper.find(name) != std::string::npos) {
+                matched.push_back(sql);
+            }
+        }
+        return matched;
+    }
+
+    // 任何一步退化为全表扫描或额外排序都视为失败；index 为空时不限定具体索引
+    void ExpectIndexed(const std::function<void()>& run, const std::string& index = "",
+                       const std::string& table = "bills") {
+        auto statements = Capture(run, table);
+        ASSERT_FALSE(statements.empty()) << "未捕获到访问 " << table << " 的 SELECT";
+
+        for (const auto& sql : statements) {
+            auto plan = db_->ExplainQueryPlan(sql);
+            ASSERT_FALSE(plan.empty()) << sql;
+
+            bool uses_index = false;
+            for (const auto& detail : plan) {
+                EXPECT_NE(detail.rfind("SCAN", 0), 0u) << sql << "\n  -> " << detail;
+                EXPECT_EQ(detail.find("TEMP B-TREE"), std::string::npos) << sql << "\n  -> " << detail;
+                if (detail.find("USING INDEX " + index) != std::string::npos ||
+                    detail.find("USING COVERING INDEX " + index) != std::string::npos) {
+                    uses_index = true;
+                }
+            }
+            EXPECT_TRUE(uses_index) << sql << " 未使用索引 " << index;
+        }
+    }
+
+    // 聚合查询：必须只读覆盖索引；GROUP BY 的临时 B 树只保存分组结果，允许出现
+    void ExpectCovered(const std::function<void()>& run, const std::string& index) {
+        auto statements = Capture(run);
+        ASSERT_FALSE(statements.empty()) << "未捕获到访问 bills 的 SELECT";
+
+        for (const auto& sql : statements) {
+            auto plan = db_->ExplainQueryPlan(sql);
+            ASSERT_FALSE(plan.empty()) << sql;
+
+            bool covered = false;
+            for (const auto& detail : plan) {
+                EXPECT_NE(detail.rfind("SCAN", 0), 0u) << sql << "\n  -> " << detail;
+                if (detail.find("USING COVERING INDEX " + index) != std::string::npos) {
+                    covered = true;
+                }
+            }
+            EXPECT_TRUE(covered) << sql << " 未使用覆盖索引 " << index;
+        }
+    }
+
+private:
+    static int OnTrace(unsigned, void* context, void* p, void*) {
+        auto* statements = static_cast<std::vector<std::string>*>(context);
+        if (const char* sql = sqlite3_sql(static_cast<sqlite3_stmt*>(p))) {
+            statements->emplace_back(sql);
+        }
+        return 0;
+    }
+};
+
+// ==================== BillRepositoryImpl ====================
+
+TEST_F(QueryPlanTest, QueryByTime_Owner_UsesOwnerCreatedIndex) {
+    ExpectIndexed([&] { bill_repo_->queryByTime(1, kDay, kDay + 100); }, "idx_bills_owner_created");
+}
+
+TEST_F(QueryPlanTest, QueryByTime_OwnerPmr_UsesOwnerCreatedIndex) {
+    ExpectIndexed([&] { bill_repo_->queryByTime(1, kDay, kDay + 100, std::pmr::get_default_resource()); },
+                  "idx_bills_owner_created");
+}
+
+TEST_F(QueryPlanTest, QueryByEvent_Owner_UsesOwnerEventIndex) {
+    ExpectIndexed([&] { bill_repo_->queryByEvent(1, 1); }, "idx_bills_owner_event");
+}
+
+TEST_F(QueryPlanTest, QueryByTime_All_UsesCreatedIndex) {
+    ExpectIndexed([&] { bill_repo_->queryByTime(kDay, kDay + 100); });
+}
+
+TEST_F(QueryPlanTest, QueryByTimeInOrder_UsesCreatedIndex) {
+    ExpectIndexed([&] { bill_repo_->queryByTimeInOrder(kDay, kDay + 100); });
+}
+
+TEST_F(QueryPlanTest, QueryByTimePage_UsesCreatedIdIndex) {
+    ExpectIndexed([&] { bill_repo_->queryByTimePage(kDay, kDay + 100, std::nullopt, 10); },
+                  "idx_bills_created_id");
+    ExpectIndexed([&] { bill_repo_->queryByTimePage(kDay, kDay + 100, model::BillCursor{kDay + 10, 5}, 10); },
+                  "idx_bills_created_id");
+}
+
+TEST_F(QueryPlanTest, QueryByTimeAndEventInOrder_UsesCreatedCoverIndex) {
+    ExpectIndexed([&] { bill_repo_->queryByTimeAndEventInOrder(kDay, kDay + 100); }, "idx_bills_created_cover");
+}
+
+TEST_F(QueryPlanTest, QueryByPhone_UsesOwnerIndex) {
+    ExpectIndexed([&] { bill_repo_->queryByPhone("13800000001"); });
+}
+
+TEST_F(QueryPlanTest, QueryByEventName_UsesEventCreatedIndex) {
+    // 事件名先经 EventCatalog 解析为 id
+    ExpectIndexed([&] { bill_repo_->queryByEvent("餐饮"); }, "idx_bills_event_created");
+}
+
+// ==================== 聚合统计 ====================
+
+TEST_F(QueryPlanTest, TotalsByEvent_UsesCoveringIndex) {
+    ExpectCovered([&] { bill_repo_->totalsByEvent(kDay, kDay + 100); }, "idx_bills_created_cover");
+}
+
+TEST_F(QueryPlanTest, TotalsByOwner_UsesCoveringIndex) {
+    ExpectCovered([&] { bill_repo_->totalsByOwner(kDay, kDay + 100); }, "idx_bills_created_cover");
+}
+
+TEST_F(QueryPlanTest, TotalsByPeriod_UsesCoveringIndex) {
+    // 区间不足一天，全部直接聚合 bills
+    ExpectCovered([&] { bill_repo_->totalsByPeriod(kDay + 10, kDay + 100, model::Granularity::Month); },
+                  "idx_bills_created_cover");
+}
+
+TEST_F(QueryPlanTest, Summary_UsesCoveringIndex) {
+    ExpectCovered([&] { bill_repo_->summary(kDay, kDay + 100); }, "idx_bills_created_cover");
+}
+
+// ==================== AnnotationRepositoryImpl ====================
+
+TEST_F(QueryPlanTest, FindByBillId_UsesBillCreatedIndex) {
+    ExpectIndexed([&] { annotation_repo_->findByBillId(1); }, "idx_annotations_bill_created", "annotations");
+}
@@ -0,0 +1,174 @@
+#include "DatabaseTestBase.h"
+#include "BillSearchIndex.h"
+#include "BillService.h"
+#include "SearchRepositoryImpl.h"
+#include "SearchService.h"
+
+class SearchRepositoryTest : public DatabaseTestBase {
+protected:
+    void SetUp() override {
+        DatabaseTestBase::SetUp();
+        if (!db_->GetSearchIndex().Available()) {
+            GTEST_SKIP() << "SQLite 未编译 FTS5";
+        }
+        search_repo_ = std::make_shared<SearchRepositoryImpl>(db_);
+
+        owner1_ = user_repo_->queryByPhone("13800000001")->id;
+        owner2_ = user_repo_->queryByPhone("13800000002")->id;
+        event_id_ = event_repo_->findByName("交通")->id;
+    }
+
+    int SaveBill(int owner_id, const std::string& desc) {
+        return bill_repo_->save(CreateBill(owner_id, event_id_, 20.0, desc));
+    }
+
+    std::shared_ptr<SearchRepositoryImpl> search_repo_;
+    int owner1_ = 0;
+    int owner2_ = 0;
+    int event_id_ = 0;
+};
+
+TEST_F(SearchRepositoryTest, Search_MatchesDescription) {
+    int id = SaveBill(owner1_, "taxi to airport");
+    SaveBill(owner1_, "lunch");
+
+    auto page = search_repo_->search("taxi", {}, owner1_, 0, 10);
+
+    ASSERT_EQ(page.bills.size(), 1u);
+    EXPECT_EQ(page.bills[0].id, id);
+    EXPECT_EQ(page.bills[0].description, "taxi to airport");
+    EXPECT_FALSE(page.next_offset.has_value());
+}
+
+TEST_F(SearchRepositoryTest, Search_SubstringQuery) {
+    SaveBill(owner1_, "Taxi home");
+
+    EXPECT_EQ(search_repo_->search("tax", {}, owner1_, 0, 10).bills.size(), 1u);
+    EXPECT_EQ(search_repo_->search("axi", {}, owner1_, 0, 10).bills.size(), 1u);
+    // 短于 3 个字符的词没有 trigram 可查，作为 MATCH 表达式查不到；作为子串逐行过滤可以命中
+    EXPECT_TRUE(search_repo_->search("ta", {}, owner1_, 0, 10).bills.empty());
+    EXPECT_EQ(search_repo_->search("", {"ta"}, owner1_, 0, 10).bills.size(), 1u);
+}
+
+TEST_F(SearchRepositoryTest, Search_ShortChineseSubstring) {
+    int dinner = SaveBill(owner1_, "公司聚餐");
+    int lunch = SaveBill(owner1_, "午餐");
+    SaveBill(owner1_, "打车回家");
+    annotation_repo_->save(CreateAnnotation(lunch, owner1_, "部门聚餐报销"));
+
+    // 两个汉字的词同时查描述与批注，新账单在前
+    auto page = search_repo_->search("", {"聚餐"}, owner1_, 0, 10);
+    ASSERT_EQ(page.bills.size(), 2u);
+    EXPECT_EQ(page.bills[0].id, lunch);
+    EXPECT_EQ(page.bills[1].id, dinner);
+
+    // 与全文表达式组合时为 AND
+    page = search_repo_->search("\"聚餐报\"", {"午餐"}, owner1_, 0, 10);
+    ASSERT_EQ(page.bills.size(), 1u);
+    EXPECT_EQ(page.bills[0].id, lunch);
+}
+
+TEST_F(SearchRepositoryTest, Search_SubstringWildcardsAreLiteral) {
+    int id = SaveBill(owner1_, "打 9_5 折");
+    SaveBill(owner1_, "打 985 折");
+
+    auto page = search_repo_->search("", {"_"}, owner1_, 0, 10);
+    ASSERT_EQ(page.bills.size(), 1u);
+    EXPECT_EQ(page.bills[0].id, id);
+    EXPECT_TRUE(search_repo_->search("", {"%"}, owner1_, 0, 10).bills.empty());
+}
+
+TEST_F(SearchRepositoryTest, Search_MatchesChineseSubstring) {
+    int id = SaveBill(owner1_, "公司聚餐报销");
+    SaveBill(owner1_, "午餐");
+
+    auto page = search_repo_->search("\"聚餐报\"", {}, owner1_, 0, 10);
+
+    ASSERT_EQ(page.bills.size(), 1u);
+    EXPECT_EQ(page.bills[0].id, id);
+}
+
+TEST_F(SearchRepositoryTest, Search_FiltersByOwner) {
+    SaveBill(owner1_, "taxi");
+    SaveBill(owner2_, "taxi");
+
+    EXPECT_EQ(search_repo_->search("taxi", {}, owner1_, 0, 10).bills.size(), 1u);
+    EXPECT_EQ(search_repo_->search("taxi", {}, 0, 0, 10).bills.size(), 2u);
+}
+
+TEST_F(SearchRepositoryTest, Search_MatchesAnnotationContent) {
+    int id = SaveBill(owner1_, "misc");
+    annotation_repo_->save(CreateAnnotation(id, owner2_, "reimbursed by finance"));
+
+    auto page = search_repo_->search("finance", {}, owner1_, 0, 10);
+
+    ASSERT_EQ(page.bills.size(), 1u);
+    EXPECT_EQ(page.bills[0].id, id);
+
+    annotation_repo_->removeByBillId(id);
+    EXPECT_TRUE(search_repo_->search("finance", {}, owner1_, 0, 10).bills.empty());
+}
+
+TEST_F(SearchRepositoryTest, Search_RanksDescriptionHitsFirst) {
+    int annotated = SaveBill(owner1_, "misc");
+    annotation_repo_->save(CreateAnnotation(annotated, owner1_, "taxi"));
+    int described = SaveBill(owner1_, "taxi");
+
+    auto page = search_repo_->search("taxi", {}, owner1_, 0, 10);
+
+    ASSERT_EQ(page.bills.size(), 2u);
+    EXPECT_EQ(page.bills[0].id, described);
+}
+
+TEST_F(SearchRepositoryTest, Search_FollowsUpdateAndRemove) {
+    auto bill = CreateBill(owner1_, event_id_, 20.0, "taxi");
+    bill.id = bill_repo_->save(bill);
+
+    bill.description = "bus";
+    bill_repo_->save(bill);
+    EXPECT_TRUE(search_repo_->search("taxi", {}, owner1_, 0, 10).bills.empty());
+    EXPECT_EQ(search_repo_->search("bus", {}, owner1_, 0, 10).bills.size(), 1u);
+
+    bill_repo_->remove(bill.id);
+    EXPECT_TRUE(search_repo_->search("bus", {}, owner1_, 0, 10).bills.empty());
+}
+
+TEST_F(SearchRepositoryTest, Search_Pages) {
+    std::vector<model::Bill> batch;
+    for (int i = 0; i < 5; ++i) {
+        batch.push_back(CreateBill(owner1_, event_id_, 20.0, "taxi " + std::to_string(i)));
+    }
+    bill_repo_->saveBatch(batch);
+
+    auto first = search_repo_->search("taxi", {}, owner1_, 0, 3);
+    ASSERT_EQ(first.bills.size(), 3u);
+    ASSERT_TRUE(first.next_offset.has_value());
+
+    auto second = search_repo_->search("taxi", {}, owner1_, *first.next_offset, 3);
+    EXPECT_EQ(second.bills.size(), 2u);
+    EXPECT_FALSE(second.next_offset.has_value());
+}
+
+TEST_F(SearchRepositoryTest, Search_InvalidExpression_ReturnsEmpty) {
+    SaveBill(owner1_, "taxi");
+
+    EXPECT_TRUE(search_repo_->search("\"unterminated", {}, owner1_, 0, 10).bills.empty());
+}
+
+// 经 BillService 添加的批注进入全文索引，SearchService 能按批注内容找到账单
+TEST_F(SearchRepositoryTest, AnnotateBill_ThenSearchServiceFindsAnnotation) {
+    int id = SaveBill(owner1_, "misc");
+    BillService bill_service(bill_repo_, annotation_repo_);
+    SearchService search_service(search_repo_);
+
+    model::Annotation annotation;
+    annotation.authorid = owner2_;
+    annotation.content = "财务已报销";
+    bill_service.annotateBill(id, annotation);
+
+    for (const char* text : {"已报销", "报销"}) {
+        auto page = search_service.Search(owner1_, text, 10);
+        ASSERT_EQ(page.bills.size(), 1u) << text;
+        EXPECT_EQ(page.bills[0].id, id);
+    }
+}
@@ -0,0 +1,185 @@
+#include <gtest/gtest.h>
+#include "DatabaseORM.h"
+#include "BillRepositoryImpl.h"
+#include "EventRepositoryImpl.h"
+#include "StatementProfiler.h"
+#include "UserRepositoryImpl.h"
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <memory_resource>
+#include <sstream>
+#include <thread>
+
+class StatementProfilerTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        log_path_ = (std::filesystem::temp_directory_path() / "bill_management_slow_query_test.log").string();
+        std::filesystem::remove(log_path_);
+    }
+
+    void TearDown() override {
+        std::filesystem::remove(log_path_);
+    }
+
+    std::shared_ptr<DatabaseORM> OpenProfiled(double slow_query_ms) {
+        DatabaseOptions options;
+        options.profile_statements = true;
+        options.slow_query_ms = slow_query_ms;
+        options.slow_query_log = log_path_;
+        return std::make_shared<DatabaseORM>(":memory:", options);
+    }
+
+    // 插入一个用户、一个事件和 count 条账单，返回用户 id
+    int SeedBills(const std::shared_ptr<DatabaseORM>& db, int count) {
+        UserRepositoryImpl user_repo(db);
+        EventRepositoryImpl event_repo(db);
+        BillRepositoryImpl bill_repo(db);
+        int owner = user_repo.save(model::User("13800000001", "TestUser1", "password123"));
+        model::Event event;
+        event.name = "餐饮";
+        event_id_ = event_repo.save(event);
+        for (int i = 0; i < count; ++i) {
+            model::Bill bill;
+            bill.owner_id = owner;
+            bill.event_id = event_id_;
+            bill.amount = model::Money(100 + i);
+            bill.created_at = 1700000000 + i;
+            bill_repo.save(bill);
+        }
+        return owner;
+    }
+
+    std::string ReadLog() {
+        std::ifstream in(log_path_);
+        std::stringstream ss;
+        ss << in.rdbuf();
+        return ss.str();
+    }
+
+    std::string log_path_;
+    int event_id_ = 0;
+};
+
+TEST(StatementProfilerNormalizeTest, Literals_ReplacedWithPlaceholder) {
+    EXPECT_EQ(StatementProfiler::NormalizeSql("SELECT * FROM bills WHERE owner_id = 12 AND description = 'it''s'"),
+              "SELECT * FROM bills WHERE owner_id = ? AND description = ?");
+    EXPECT_EQ(StatementProfiler::NormalizeSql("SELECT 1.5e-3, X'ab', :name, ?2"), "SELECT ?");
+}
+
+TEST(StatementProfilerNormalizeTest, InListsAndValueRows_Collapsed) {
+    EXPECT_EQ(StatementProfiler::NormalizeSql("DELETE FROM bills WHERE id IN (1, 2, 3)"),
+              StatementProfiler::NormalizeSql("DELETE FROM bills WHERE id IN (?)"));
+    EXPECT_EQ(StatementProfiler::NormalizeSql("INSERT INTO t (a, b) VALUES (?, ?), (?, ?), (?, ?);"),
+              "INSERT INTO t (a, b) VALUES (?)");
+}
+
+TEST(StatementProfilerNormalizeTest, IdentifiersAndWhitespace_Kept) {
+    EXPECT_EQ(StatementProfiler::NormalizeSql("SELECT  \"bills\".\"id\"\n FROM   bills2  "),
+              "SELECT \"bills\".\"id\" FROM bills2");
+}
+
+TEST_F(StatementProfilerTest, Disabled_ByDefault) {
+    auto db = std::make_shared<DatabaseORM>(":memory:");
+    EXPECT_EQ(db->GetProfiler(), nullptr);
+}
+
+TEST_F(StatementProfilerTest, Query_AggregatedByNormalizedSql) {
+    auto db = OpenProfiled(1e9);
+    int owner = SeedBills(db, 3);
+    ASSERT_NE(db->GetProfiler(), nullptr);
+    db->GetProfiler()->Reset();
+
+    BillRepositoryImpl bill_repo(db);
+    bill_repo.queryByTime(owner, 0, 1700000001, std::pmr::get_default_resource());
+    bill_repo.queryByTime(owner, 0, 1800000000, std::pmr::get_default_resource());
+
+    auto stats = db->GetProfiler()->Snapshot();
+    auto it = std::find_if(stats.begin(), stats.end(), [](const metrics::MetricSnapshot& s) {
+        return s.name.find("WHERE owner_id = ? AND created_at >= ? AND created_at <= ?") != std::string::npos;
+    });
+    ASSERT_NE(it, stats.end());
+    EXPECT_EQ(it->calls, 2u);
+    EXPECT_EQ(it->rows, 5u);
+    EXPECT_GT(it->total_ns, 0u);
+    EXPECT_GE(it->max_ns, it->PercentileNs(0.5));
+
+    // 未超过阈值，不写日志
+    EXPECT_EQ(ReadLog(), "");
+}
+
+TEST_F(StatementProfilerTest, SlowQuery_LoggedWithQueryPlan) {
+    auto db = OpenProfiled(0);
+    int owner = SeedBills(db, 2);
+
+    BillRepositoryImpl bill_repo(db);
+    bill_repo.queryByTime(owner, 0, 1800000000, std::pmr::get_default_resource());
+
+    // 回调中只排队，查询计划在 FlushSlowLog 时补做
+    EXPECT_EQ(ReadLog(), "");
+    db->FlushSlowLog();
+
+    auto log = ReadLog();
+    EXPECT_NE(log.find("owner_id = " + std::to_string(owner) + " AND created_at >= 0"), std::string::npos);
+    EXPECT_NE(log.find("USING INDEX idx_bills_owner_created"), std::string::npos);
+}
+
+TEST_F(StatementProfilerTest, SlowQuery_FlushedWhenConnectionCloses) {
+    auto db = OpenProfiled(0);
+    int owner = SeedBills(db, 1);
+    {
+        BillRepositoryImpl bill_repo(db);
+        bill_repo.queryByEvent(owner, event_id_);
+    }
+    db.reset();
+
+    auto log = ReadLog();
+    EXPECT_NE(log.find("event_id = " + std::to_string(event_id_)), std::string::npos);
+    EXPECT_NE(log.find("USING INDEX idx_bills_owner_event"), std::string::npos);
+}
+
+TEST_F(StatementProfilerTest, Rows_CountedPerThread) {
+    auto db = OpenProfiled(1e9);
+    int owner = SeedBills(db, 4);
+    db->GetProfiler()->Reset();
+
+    // 同一连接依次在两个线程上使用，各自的行数都计入同一条汇总
+    BillRepositoryImpl bill_repo(db);
+    bill_repo.queryByTime(owner, 0, 1800000000, std::pmr::get_default_resource());
+    std::thread([&] { bill_repo.queryByTime(owner, 0, 1800000000, std::pmr::get_default_resource()); }).join();
+
+    auto stats = db->GetProfiler()->Snapshot();
+    auto it = std::find_if(stats.begin(), stats.end(), [](const metrics::MetricSnapshot& s) {
+        return s.name.find("WHERE owner_id = ? AND created_at >= ? AND created_at <= ?") != std::string::npos;
+    });
+    ASSERT_NE(it, stats.end());
+    EXPECT_EQ(it->calls, 2u);
+    EXPECT_EQ(it->rows, 8u);
+}
+
+TEST_F(StatementProfilerTest, Write_CountsChangedRows) {
+    auto db = OpenProfiled(1e9);
+    int owner = SeedBills(db, 0);
+    db->GetProfiler()->Reset();
+
+    BillRepositoryImpl bill_repo(db);
+    model::Bill bill;
+    bill.owner_id = owner;
+    bill.event_id = event_id_;
+    bill.amount = model::Money(100);
+    bill_repo.saveBatch({bill, bill, bill});
+
+    // 写语句记影响的行数（只看 bills 本身，不计汇总表与全文索引）
+    uint64_t inserted = 0;
+    for (const auto& s : db->GetProfiler()->Snapshot()) {
+        if (s.name.rfind("INSERT", 0) == 0 && s.name.find("rollup") == std::string::npos &&
+            s.name.find("bill_search") == std::string::npos) {
+            inserted += s.rows;
+        }
+    }
+    EXPECT_EQ(inserted, 3u);
+
+    std::ostringstream out;
+    db->GetProfiler()->Dump(out);
+    EXPECT_NE(out.str().find("INSERT"), std::string::npos);
+}
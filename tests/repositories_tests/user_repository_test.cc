@@ -26,14 +26,14 @@ TEST_F(UserRepositoryTest, Save_UpdateExisting_Success) {
     
     // Act
     user->username = "UpdatedName";
-    user->balance = 2000.0;
+    user->balance = model::Money(200000);
     user_repo_->save(*user);
     
     // Assert
     auto updated = user_repo_->queryByPhone("13800000001");
     ASSERT_TRUE(updated.has_value());
     EXPECT_EQ(updated->username, "UpdatedName");
-    EXPECT_DOUBLE_EQ(updated->balance, 2000.0);
+    EXPECT_EQ(updated->balance.cents, 200000);
 }
 
 // ==================== findById 测试 ====================
@@ -106,6 +106,43 @@ TEST_F(UserRepositoryTest, SearchByPhonePartial_NoMatch) {
     EXPECT_TRUE(results.empty());
 }
 
+TEST_F(UserRepositoryTest, SearchByPhonePartial_ShortKeyword) {
+    // Act：不足三个字符时走内存扫描
+    auto results = user_repo_->queryByPhonePartial("2");
+    
+    // Assert
+    ASSERT_EQ(results.size(), 1);
+    EXPECT_EQ(results[0].username, "TestAdmin");
+}
+
+TEST_F(UserRepositoryTest, SearchByPhonePartial_FollowsPhoneChange) {
+    // Arrange
+    auto user = user_repo_->queryByPhone("13800000001");
+    ASSERT_TRUE(user.has_value());
+    ASSERT_EQ(user_repo_->queryByPhonePartial("0001").size(), 1);
+    
+    // Act
+    user->phone = "15955556666";
+    user_repo_->save(*user);
+    
+    // Assert
+    EXPECT_TRUE(user_repo_->queryByPhonePartial("0001").empty());
+    auto results = user_repo_->queryByPhonePartial("5555");
+    ASSERT_EQ(results.size(), 1);
+    EXPECT_EQ(results[0].id, user->id);
+}
+
+TEST_F(UserRepositoryTest, SearchByPhonePartial_TrigramsNotAdjacent) {
+    // Arrange："123" 与 "234" 都出现，但不连成 "1234"
+    user_repo_->save(CreateUser("12399923400", "Scattered"));
+    
+    // Act
+    auto results = user_repo_->queryByPhonePartial("1234");
+    
+    // Assert
+    EXPECT_TRUE(results.empty());
+}
+
 // ==================== 集成测试 ====================
 
 TEST_F(UserRepositoryTest, Integration_CreateQueryUpdate) {
@@ -119,7 +156,7 @@ TEST_F(UserRepositoryTest, Integration_CreateQueryUpdate) {
     EXPECT_EQ(found->username, "IntegrationUser");
     
     // 3. 更新用户
-    found->balance = 500.0;
+    found->balance = model::Money(50000);
     found->username = "UpdatedIntegrationUser";
     user_repo_->save(*found);
     
@@ -127,5 +164,5 @@ TEST_F(UserRepositoryTest, Integration_CreateQueryUpdate) {
     auto updated = user_repo_->findById(found->id);
     ASSERT_TRUE(updated.has_value());
     EXPECT_EQ(updated->username, "UpdatedIntegrationUser");
-    EXPECT_DOUBLE_EQ(updated->balance, 500.0);
+    EXPECT_EQ(updated->balance.cents, 50000);
 }
\ No newline at end of file
@@ -11,11 +11,11 @@ using ::testing::NiceMock;
 // Mock UserRepository for testing
 class MockUserRepository : public repo::IUserRepository {
 public:
-    MOCK_METHOD(void, save, (const model::User& u), (override));
+    MOCK_METHOD(int, save, (const model::User& u), (override));
     MOCK_METHOD(std::optional<model::User>, findById, (int id), (override));
     MOCK_METHOD(std::optional<model::User>, queryByPhone, (const std::string& phone), (override));
     MOCK_METHOD(std::vector<model::User>, queryByPhonePartial, (const std::string& partial), (override));
-    MOCK_METHOD(bool, setBalanceByPhone, (const std::string& phone), (override));
+    MOCK_METHOD(bool, setBalanceByPhone, (const std::string& phone, model::Money balance), (override));
 };
 
 class AuthServiceTest : public ::testing::Test {
@@ -0,0 +1,51 @@
+#include <gtest/gtest.h>
+#include <BillColumnStore.h>
+
+class BillColumnStoreTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        // 1003 行，不是 4 的倍数，覆盖向量化尾部
+        for (int i = 0; i < 1003; ++i) {
+            store_.Append(1000 + i, i % 7, i % 5, i);
+        }
+    }
+
+    BillColumnStore store_;
+};
+
+TEST_F(BillColumnStoreTest, Sum_NoFilter_SumsAll) {
+    auto r = store_.Sum({});
+
+    EXPECT_EQ(r.count, 1003);
+    EXPECT_EQ(r.sum_cents, 1002LL * 1003 / 2);
+}
+
+TEST_F(BillColumnStoreTest, Sum_TimeRange_UsesInclusiveBounds) {
+    BillColumnStore::Filter filter;
+    filter.from = 1010;
+    filter.to = 1019;
+
+    auto r = store_.Sum(filter);
+
+    EXPECT_EQ(r.count, 10);
+    EXPECT_EQ(r.sum_cents, 145);  // 10 + ... + 19
+}
+
+TEST_F(BillColumnStoreTest, Sum_OwnerAndEvent_MatchesScalar) {
+    BillColumnStore::Filter filter;
+    filter.from = 1100;
+    filter.to = 1900;
+    filter.owner_id = 3;
+    filter.event_id = 2;
+
+    auto fast = store_.Sum(filter);
+    auto scalar = store_.SumScalar(filter);
+
+    EXPECT_GT(fast.count, 0);
+    EXPECT_EQ(fast.count, scalar.count);
+    EXPECT_EQ(fast.sum_cents, scalar.sum_cents);
+}
+
+TEST_F(BillColumnStoreTest, Append_OutOfOrder_Throws) {
+    EXPECT_THROW(store_.Append(0, 1, 1, 1), std::invalid_argument);
+}
@@ -8,27 +8,43 @@ using ::testing::_;
 using ::testing::Return;
 using ::testing::NiceMock;
 using ::testing::SaveArg;
+using ::testing::DoAll;
 using ::testing::InSequence;
 
 // Mock BillRepository
 class MockBillRepository : public repo::IBillRepository {
 public:
-    MOCK_METHOD(void, save, (const model::Bill& b), (override));
+    MOCK_METHOD(int, save, (const model::Bill& b), (override));
+    MOCK_METHOD(std::vector<int>, saveBatch, (const std::vector<model::Bill>& bills), (override));
     MOCK_METHOD(std::optional<model::Bill>, findById, (int id), (override));
-    MOCK_METHOD(std::vector<model::Bill>, queryByEvent, (int ownerId, int eventId), (override));
-    MOCK_METHOD(std::vector<model::Bill>, queryByEvent, (std::string& name), (override));
-    MOCK_METHOD(std::vector<model::Bill>, queryByTime, (int ownerId, model::Timestamp from, model::Timestamp to), (override));
-    MOCK_METHOD(std::vector<model::Bill>, queryByTime, (model::Timestamp from, model::Timestamp to), (override));
-    MOCK_METHOD(std::vector<model::Bill>, queryByTimeInOrder, (model::Timestamp from, model::Timestamp to), (override));
-    MOCK_METHOD(std::vector<model::Bill>, queryByTimeAndEventInOrder, (model::Timestamp from, model::Timestamp to), (override));
-    MOCK_METHOD(std::vector<model::Bill>, queryByPhone, (const std::string& phone), (override));
+    MOCK_METHOD(std::vector<model::BillRow>, queryByEvent, (int ownerId, int eventId), (override));
+    MOCK_METHOD(std::vector<model::BillRow>, queryByEvent, (const std::string& name), (override));
+    MOCK_METHOD(std::vector<model::BillRow>, queryByTime, (int ownerId, model::Timestamp from, model::Timestamp to), (override));
+    MOCK_METHOD(std::vector<model::BillRow>, queryByTime, (model::Timestamp from, model::Timestamp to), (override));
+    MOCK_METHOD(model::BillPage, queryByTimePage, (model::Timestamp from, model::Timestamp to, const std::optional<model::BillCursor>& after, int page_size), (override));
+    MOCK_METHOD(std::vector<model::BillRow>, queryByTimeInOrder, (model::Timestamp from, model::Timestamp to), (override));
+    MOCK_METHOD(std::vector<model::BillRow>, queryByTimeAndEventInOrder, (model::Timestamp from, model::Timestamp to), (override));
+    MOCK_METHOD(std::pmr::vector<model::PmrBillRow>, queryByTime, (int ownerId, model::Timestamp from, model::Timestamp to, std::pmr::memory_resource* mr), (override));
+    MOCK_METHOD(std::pmr::vector<model::PmrBillRow>, queryByTime, (model::Timestamp from, model::Timestamp to, std::pmr::memory_resource* mr), (override));
+    MOCK_METHOD(std::pmr::vector<model::PmrBillRow>, queryByTimeInOrder, (model::Timestamp from, model::Timestamp to, std::pmr::memory_resource* mr), (override));
+    MOCK_METHOD(std::pmr::vector<model::PmrBillRow>, queryByTimeAndEventInOrder, (model::Timestamp from, model::Timestamp to, std::pmr::memory_resource* mr), (override));
+    MOCK_METHOD(std::vector<model::BillTotal>, totalsByEvent, (model::Timestamp from, model::Timestamp to), (override));
+    MOCK_METHOD(std::vector<model::BillTotal>, totalsByOwner, (model::Timestamp from, model::Timestamp to), (override));
+    MOCK_METHOD(std::vector<model::PeriodTotal>, totalsByPeriod, (model::Timestamp from, model::Timestamp to, model::Granularity granularity), (override));
+    MOCK_METHOD(model::BillSummary, summary, (model::Timestamp from, model::Timestamp to), (override));
+    MOCK_METHOD(void, rebuildRollups, (), (override));
+    MOCK_METHOD(std::vector<model::RollupMismatch>, checkRollups, (), (override));
+    MOCK_METHOD(void, forEachByTime, (model::Timestamp from, model::Timestamp to, const repo::BillVisitor& visit), (override));
+    MOCK_METHOD(void, forEachByTimeInOrder, (model::Timestamp from, model::Timestamp to, const repo::BillVisitor& visit), (override));
+    MOCK_METHOD(void, forEachByTimeAndEventInOrder, (model::Timestamp from, model::Timestamp to, const repo::BillVisitor& visit), (override));
+    MOCK_METHOD(std::vector<model::BillRow>, queryByPhone, (const std::string& phone), (override));
     MOCK_METHOD(void, remove, (int id), (override));
 };
 
 // Mock AnnotationRepository
 class MockAnnotationRepository : public repo::IAnnotationRepository {
 public:
-    MOCK_METHOD(void, save, (const model::Annotation& a), (override));
+    MOCK_METHOD(int, save, (const model::Annotation& a), (override));
     MOCK_METHOD(std::optional<model::Annotation>, findById, (int id), (override));
 };
 
@@ -39,7 +55,7 @@ protected:
         mock_annotation_repo_ = std::make_shared<NiceMock<MockAnnotationRepository>>();
         bill_service_ = std::make_unique<BillService>(mock_bill_repo_, mock_annotation_repo_);
         
-        base_time_ = std::chrono::system_clock::now();
+        base_time_ = model::Now();
     }
 
     void TearDown() override {
@@ -57,7 +73,7 @@ protected:
         model::Bill bill;
         bill.id = id;
         bill.owner_id = owner_id;
-        bill.amount = amount;
+        bill.amount = model::Money::FromDouble(amount);
         bill.description = description;
         bill.created_at = base_time_;
         bill.has_annotation = has_annotation;
@@ -102,13 +118,13 @@ TEST_F(BillServiceAnnotateTest, AnnotateBill_Success_NewAnnotation) {
     model::Annotation saved_annotation;
     EXPECT_CALL(*mock_annotation_repo_, save(_))
         .Times(1)
-        .WillOnce(SaveArg<0>(&saved_annotation));
+        .WillOnce(DoAll(SaveArg<0>(&saved_annotation), Return(1)));
     
     // 验证账单后被更新
     model::Bill saved_bill;
     EXPECT_CALL(*mock_bill_repo_, save(_))
         .Times(1)
-        .WillOnce(SaveArg<0>(&saved_bill));
+        .WillOnce(DoAll(SaveArg<0>(&saved_bill), Return(1)));
     
     // Act
     bill_service_->annotateBill(bill_id, annotation);
@@ -123,6 +139,22 @@ TEST_F(BillServiceAnnotateTest, AnnotateBill_Success_NewAnnotation) {
     EXPECT_EQ(saved_bill.annotation.content, "Important note");
 }
 
+TEST_F(BillServiceAnnotateTest, AnnotateBill_Success_SetsBillId) {
+    const int bill_id = 7;
+    model::Annotation annotation = CreateTestAnnotation(1, "Important note", 2);
+    ASSERT_EQ(annotation.bill_id, 0);
+
+    EXPECT_CALL(*mock_bill_repo_, findById(bill_id))
+        .WillOnce(Return(CreateTestBill(bill_id)));
+    model::Annotation saved_annotation;
+    EXPECT_CALL(*mock_annotation_repo_, save(_))
+        .WillOnce(DoAll(SaveArg<0>(&saved_annotation), Return(1)));
+
+    bill_service_->annotateBill(bill_id, annotation);
+
+    EXPECT_EQ(saved_annotation.bill_id, bill_id);
+}
+
 TEST_F(BillServiceAnnotateTest, AnnotateBill_Success_SaveOrderCorrect) {
     // Arrange
     const int bill_id = 1;
@@ -166,7 +198,7 @@ TEST_F(BillServiceAnnotateTest, AnnotateBill_Success_UpdateExistingAnnotation) {
     model::Bill saved_bill;
     EXPECT_CALL(*mock_bill_repo_, save(_))
         .Times(1)
-        .WillOnce(SaveArg<0>(&saved_bill));
+        .WillOnce(DoAll(SaveArg<0>(&saved_bill), Return(1)));
     
     // Act
     bill_service_->annotateBill(bill_id, new_annotation);
@@ -194,7 +226,7 @@ TEST_F(BillServiceAnnotateTest, AnnotateBill_Success_LongContent) {
     model::Bill saved_bill;
     EXPECT_CALL(*mock_bill_repo_, save(_))
         .Times(1)
-        . WillOnce(SaveArg<0>(&saved_bill));
+        . WillOnce(DoAll(SaveArg<0>(&saved_bill), Return(1)));
     
     // Act
     bill_service_->annotateBill(bill_id, annotation);
@@ -219,7 +251,7 @@ TEST_F(BillServiceAnnotateTest, AnnotateBill_Success_LongContent) {
 //     model::Bill saved_bill;
 //     EXPECT_CALL(*mock_bill_repo_, save(_))
 //         .Times(1)
-//         . WillOnce(SaveArg<0>(&saved_bill));
+//         . WillOnce(DoAll(SaveArg<0>(&saved_bill), Return(1)));
     
 //     // Act
 //     bill_service_->annotateBill(bill_id, annotation);
@@ -244,7 +276,7 @@ TEST_F(BillServiceAnnotateTest, AnnotateBill_Success_PreservesOtherBillFields) {
     model::Bill saved_bill;
     EXPECT_CALL(*mock_bill_repo_, save(_))
         .Times(1)
-        . WillOnce(SaveArg<0>(&saved_bill));
+        . WillOnce(DoAll(SaveArg<0>(&saved_bill), Return(1)));
     
     // Act
     bill_service_->annotateBill(bill_id, annotation);
@@ -252,7 +284,7 @@ TEST_F(BillServiceAnnotateTest, AnnotateBill_Success_PreservesOtherBillFields) {
     // Assert - 验证其他字段未被修改
     EXPECT_EQ(saved_bill.id, bill_id);
     EXPECT_EQ(saved_bill.owner_id, 5);
-    EXPECT_DOUBLE_EQ(saved_bill.amount, 250.50);
+    EXPECT_EQ(saved_bill.amount.cents, 25050);
     EXPECT_EQ(saved_bill.description, "Important Bill");
     EXPECT_TRUE(saved_bill.has_annotation);
 }
@@ -297,7 +329,7 @@ TEST_F(BillServiceAnnotateTest, AnnotateBill_Success_WithWhitespace) {
     model::Bill saved_bill;
     EXPECT_CALL(*mock_bill_repo_, save(_))
         .Times(1)
-        .WillOnce(SaveArg<0>(&saved_bill));
+        .WillOnce(DoAll(SaveArg<0>(&saved_bill), Return(1)));
     
     // Act
     bill_service_->annotateBill(bill_id, annotation);
@@ -322,8 +354,8 @@ TEST_F(BillServiceAnnotateTest, AnnotateBill_Success_DifferentAuthors) {
     model::Annotation saved_annotation1, saved_annotation2;
     EXPECT_CALL(*mock_annotation_repo_, save(_))
         .Times(2)
-        .WillOnce(SaveArg<0>(&saved_annotation1))
-        .WillOnce(SaveArg<0>(&saved_annotation2));
+        .WillOnce(DoAll(SaveArg<0>(&saved_annotation1), Return(1)))
+        .WillOnce(DoAll(SaveArg<0>(&saved_annotation2), Return(1)));
     
     EXPECT_CALL(*mock_bill_repo_, save(_))
         .Times(2);
@@ -480,7 +512,7 @@ TEST_F(BillServiceAnnotateTest, AnnotateBill_EdgeCase_VeryLongContent) {
     model::Annotation saved_annotation;
     EXPECT_CALL(*mock_annotation_repo_, save(_))
         .Times(1)
-        . WillOnce(SaveArg<0>(&saved_annotation));
+        . WillOnce(DoAll(SaveArg<0>(&saved_annotation), Return(1)));
     
     EXPECT_CALL(*mock_bill_repo_, save(_))
         .Times(1);
@@ -506,7 +538,7 @@ TEST_F(BillServiceAnnotateTest, AnnotateBill_EdgeCase_NewlineInContent) {
         .Times(1);
     EXPECT_CALL(*mock_bill_repo_, save(_))
         .Times(1)
-        .WillOnce(SaveArg<0>(&saved_bill));
+        .WillOnce(DoAll(SaveArg<0>(&saved_bill), Return(1)));
     
     // Act
     bill_service_->annotateBill(bill_id, annotation);
@@ -529,7 +561,7 @@ TEST_F(BillServiceAnnotateTest, AnnotateBill_EdgeCase_UnicodeContent) {
         .Times(1);
     EXPECT_CALL(*mock_bill_repo_, save(_))
         .Times(1)
-        .WillOnce(SaveArg<0>(&saved_bill));
+        .WillOnce(DoAll(SaveArg<0>(&saved_bill), Return(1)));
     
     // Act
     bill_service_->annotateBill(bill_id, annotation);
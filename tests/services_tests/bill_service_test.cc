@@ -8,27 +8,43 @@ using ::testing::_;
 using ::testing::Return;
 using ::testing::NiceMock;
 using ::testing::SaveArg;
+using ::testing::DoAll;
 using ::testing::Invoke;
 
 // Mock BillRepository
 class MockBillRepository : public repo::IBillRepository {
 public:
-    MOCK_METHOD(void, save, (const model::Bill& b), (override));
+    MOCK_METHOD(int, save, (const model::Bill& b), (override));
+    MOCK_METHOD(std::vector<int>, saveBatch, (const std::vector<model::Bill>& bills), (override));
     MOCK_METHOD(std::optional<model::Bill>, findById, (int id), (override));
-    MOCK_METHOD(std::vector<model::Bill>, queryByEvent, (int ownerId, int eventId), (override));
-    MOCK_METHOD(std::vector<model::Bill>, queryByEvent, (std::string& name), (override));
-    MOCK_METHOD(std::vector<model::Bill>, queryByTime, (int ownerId, model::Timestamp from, model::Timestamp to), (override));
-    MOCK_METHOD(std::vector<model::Bill>, queryByTime, (model::Timestamp from, model::Timestamp to), (override));
-    MOCK_METHOD(std::vector<model::Bill>, queryByTimeInOrder, (model::Timestamp from, model::Timestamp to), (override));
-    MOCK_METHOD(std::vector<model::Bill>, queryByTimeAndEventInOrder, (model::Timestamp from, model::Timestamp to), (override));
-    MOCK_METHOD(std::vector<model::Bill>, queryByPhone, (const std::string& phone), (override));
+    MOCK_METHOD(std::vector<model::BillRow>, queryByEvent, (int ownerId, int eventId), (override));
+    MOCK_METHOD(std::vector<model::BillRow>, queryByEvent, (const std::string& name), (override));
+    MOCK_METHOD(std::vector<model::BillRow>, queryByTime, (int ownerId, model::Timestamp from, model::Timestamp to), (override));
+    MOCK_METHOD(std::vector<model::BillRow>, queryByTime, (model::Timestamp from, model::Timestamp to), (override));
+    MOCK_METHOD(model::BillPage, queryByTimePage, (model::Timestamp from, model::Timestamp to, const std::optional<model::BillCursor>& after, int page_size), (override));
+    MOCK_METHOD(std::vector<model::BillRow>, queryByTimeInOrder, (model::Timestamp from, model::Timestamp to), (override));
+    MOCK_METHOD(std::vector<model::BillRow>, queryByTimeAndEventInOrder, (model::Timestamp from, model::Timestamp to), (override));
+    MOCK_METHOD(std::pmr::vector<model::PmrBillRow>, queryByTime, (int ownerId, model::Timestamp from, model::Timestamp to, std::pmr::memory_resource* mr), (override));
+    MOCK_METHOD(std::pmr::vector<model::PmrBillRow>, queryByTime, (model::Timestamp from, model::Timestamp to, std::pmr::memory_resource* mr), (override));
+    MOCK_METHOD(std::pmr::vector<model::PmrBillRow>, queryByTimeInOrder, (model::Timestamp from, model::Timestamp to, std::pmr::memory_resource* mr), (override));
+    MOCK_METHOD(std::pmr::vector<model::PmrBillRow>, queryByTimeAndEventInOrder, (model::Timestamp from, model::Timestamp to, std::pmr::memory_resource* mr), (override));
+    MOCK_METHOD(std::vector<model::BillTotal>, totalsByEvent, (model::Timestamp from, model::Timestamp to), (override));
+    MOCK_METHOD(std::vector<model::BillTotal>, totalsByOwner, (model::Timestamp from, model::Timestamp to), (override));
+    MOCK_METHOD(std::vector<model::PeriodTotal>, totalsByPeriod, (model::Timestamp from, model::Timestamp to, model::Granularity granularity), (override));
+    MOCK_METHOD(model::BillSummary, summary, (model::Timestamp from, model::Timestamp to), (override));
+    MOCK_METHOD(void, rebuildRollups, (), (override));
+    MOCK_METHOD(std::vector<model::RollupMismatch>, checkRollups, (), (override));
+    MOCK_METHOD(void, forEachByTime, (model::Timestamp from, model::Timestamp to, const repo::BillVisitor& visit), (override));
+    MOCK_METHOD(void, forEachByTimeInOrder, (model::Timestamp from, model::Timestamp to, const repo::BillVisitor& visit), (override));
+    MOCK_METHOD(void, forEachByTimeAndEventInOrder, (model::Timestamp from, model::Timestamp to, const repo::BillVisitor& visit), (override));
+    MOCK_METHOD(std::vector<model::BillRow>, queryByPhone, (const std::string& phone), (override));
     MOCK_METHOD(void, remove, (int id), (override));
 };
 
 // Mock AnnotationRepository
 class MockAnnotationRepository : public repo::IAnnotationRepository {
 public:
-    MOCK_METHOD(void, save, (const model::Annotation& a), (override));
+    MOCK_METHOD(int, save, (const model::Annotation& a), (override));
     MOCK_METHOD(std::optional<model::Annotation>, findById, (int id), (override));
 };
 
@@ -40,7 +56,7 @@ protected:
         bill_service_ = std::make_unique<BillService>(mock_repo_, mock_annotation_repo_);
         
         // 设置基准时间
-        base_time_ = std::chrono::system_clock::now();
+        base_time_ = model::Now();
     }
 
     void TearDown() override {
@@ -56,7 +72,7 @@ protected:
         model::Bill bill;
         bill.id = id;
         bill.owner_id = owner_id;
-        bill. amount = amount;
+        bill.amount = model::Money::FromDouble(amount);
         bill. description = description;
         bill. created_at = base_time_;
         
@@ -68,6 +84,21 @@ protected:
         return bill;
     }
 
+    // 辅助函数：创建列表查询返回的账单行
+    model::BillRow CreateTestRow(int id = 1,
+                                 int owner_id = 1,
+                                 double amount = 100.0,
+                                 const std::string& description = "Test Bill") {
+        model::BillRow row;
+        row.id = id;
+        row.owner_id = owner_id;
+        row.event_id = 1;
+        row.amount = model::Money::FromDouble(amount);
+        row.description = description;
+        row.created_at = base_time_;
+        return row;
+    }
+
     // 辅助函数：创建测试注解
     model::Annotation CreateTestAnnotation(int id = 1,
                                            const std::string& content = "Test annotation",
@@ -95,16 +126,16 @@ TEST_F(BillServiceTest, CreateBill_Success_ValidData) {
     model::Bill saved_bill;
     EXPECT_CALL(*mock_repo_, save(_))
         .Times(1)
-        .WillOnce(SaveArg<0>(&saved_bill));
+        .WillOnce(DoAll(SaveArg<0>(&saved_bill), Return(1)));
     
     // Act
     auto result = bill_service_->CreateBill(owner_id, new_bill);
     
     // Assert
     ASSERT_TRUE(result.has_value());
-    EXPECT_EQ(result->amount, 150.50);
+    EXPECT_EQ(result->amount.cents, 15050);
     EXPECT_EQ(result->description, "Lunch");
-    EXPECT_EQ(saved_bill.amount, 150.50);
+    EXPECT_EQ(saved_bill.amount.cents, 15050);
 }
 
 TEST_F(BillServiceTest, CreateBill_Success_SetsIssueDate) {
@@ -115,20 +146,20 @@ TEST_F(BillServiceTest, CreateBill_Success_SetsIssueDate) {
     model::Bill saved_bill;
     EXPECT_CALL(*mock_repo_, save(_))
         .Times(1)
-        .WillOnce(SaveArg<0>(&saved_bill));
+        .WillOnce(DoAll(SaveArg<0>(&saved_bill), Return(1)));
     
-    auto before_time = std::chrono::system_clock::now();
-    new_bill.created_at = std::chrono::system_clock::now();
+    auto before_time = model::Now();
+    new_bill.created_at = model::Now();
     
     // Act
     auto result = bill_service_->CreateBill(owner_id, new_bill);
     
-    auto after_time = std::chrono::system_clock::now();
+    auto after_time = model::Now();
     
     // Assert
     ASSERT_TRUE(result.has_value());
-    EXPECT_TRUE(result->created_at > before_time);
-    EXPECT_TRUE(result->created_at < after_time);
+    EXPECT_GE(result->created_at, before_time);
+    EXPECT_LE(result->created_at, after_time);
 }
 
 TEST_F(BillServiceTest, CreateBill_Failure_InvalidOwnerId_Zero) {
@@ -201,7 +232,7 @@ TEST_F(BillServiceTest, CreateBill_Success_WithEvent) {
     model::Bill saved_bill;
     EXPECT_CALL(*mock_repo_, save(_))
         .Times(1)
-        .WillOnce(SaveArg<0>(&saved_bill));
+        .WillOnce(DoAll(SaveArg<0>(&saved_bill), Return(1)));
     
     // Act
     auto result = bill_service_->CreateBill(owner_id, new_bill);
@@ -217,13 +248,13 @@ TEST_F(BillServiceTest, CreateBill_Success_WithEvent) {
 TEST_F(BillServiceTest, QueryByTime_Success_MultipleResults) {
     // Arrange
     const int owner_id = 1;
-    auto from_time = base_time_ - std::chrono::hours(24);
+    auto from_time = base_time_ - 24 * 3600;
     auto to_time = base_time_;
     
-    std::vector<model::Bill> expected_bills = {
-        CreateTestBill(1, owner_id, 100.0, "Bill 1"),
-        CreateTestBill(2, owner_id, 200.0, "Bill 2"),
-        CreateTestBill(3, owner_id, 300.0, "Bill 3")
+    std::vector<model::BillRow> expected_bills = {
+        CreateTestRow(1, owner_id, 100.0, "Bill 1"),
+        CreateTestRow(2, owner_id, 200.0, "Bill 2"),
+        CreateTestRow(3, owner_id, 300.0, "Bill 3")
     };
     
     EXPECT_CALL(*mock_repo_, queryByTime(owner_id, from_time, to_time))
@@ -242,10 +273,10 @@ TEST_F(BillServiceTest, QueryByTime_Success_MultipleResults) {
 TEST_F(BillServiceTest, QueryByTime_Success_NoResults) {
     // Arrange
     const int owner_id = 1;
-    auto from_time = base_time_ - std::chrono::hours(48);
-    auto to_time = base_time_ - std::chrono::hours(24);
+    auto from_time = base_time_ - 48 * 3600;
+    auto to_time = base_time_ - 24 * 3600;
     
-    std::vector<model::Bill> empty_bills;
+    std::vector<model::BillRow> empty_bills;
     
     EXPECT_CALL(*mock_repo_, queryByTime(owner_id, from_time, to_time))
         .WillOnce(Return(empty_bills));
@@ -260,10 +291,10 @@ TEST_F(BillServiceTest, QueryByTime_Success_NoResults) {
 TEST_F(BillServiceTest, QueryByTime_Failure_InvalidOwnerId) {
     // Arrange
     const int invalid_owner_id = 0;
-    auto from_time = base_time_ - std::chrono::hours(24);
+    auto from_time = base_time_ - 24 * 3600;
     auto to_time = base_time_;
     
-    EXPECT_CALL(*mock_repo_, queryByTime(_, _, _))
+    EXPECT_CALL(*mock_repo_, queryByTime(::testing::An<int>(), _, _))
         .Times(0);
     
     // Act
@@ -277,9 +308,9 @@ TEST_F(BillServiceTest, QueryByTime_Failure_InvalidTimeRange) {
     // Arrange
     const int owner_id = 1;
     auto from_time = base_time_;
-    auto to_time = base_time_ - std::chrono::hours(24);  // to_time < from_time
+    auto to_time = base_time_ - 24 * 3600;  // to_time < from_time
     
-    EXPECT_CALL(*mock_repo_, queryByTime(_, _, _))
+    EXPECT_CALL(*mock_repo_, queryByTime(::testing::An<int>(), _, _))
         .Times(0);
     
     // Act
@@ -294,8 +325,8 @@ TEST_F(BillServiceTest, QueryByTime_Success_SameTime) {
     const int owner_id = 1;
     auto same_time = base_time_;
     
-    std::vector<model::Bill> expected_bills = {
-        CreateTestBill(1, owner_id, 100.0)
+    std::vector<model::BillRow> expected_bills = {
+        CreateTestRow(1, owner_id, 100.0)
     };
     
     EXPECT_CALL(*mock_repo_, queryByTime(owner_id, same_time, same_time))
@@ -315,12 +346,12 @@ TEST_F(BillServiceTest, QueryByEvent_Success_MultipleResults) {
     const int owner_id = 1;
     const int event_id = 5;
     
-    std::vector<model::Bill> expected_bills = {
-        CreateTestBill(1, owner_id, 100.0, "Bill 1"),
-        CreateTestBill(2, owner_id, 200.0, "Bill 2")
+    std::vector<model::BillRow> expected_bills = {
+        CreateTestRow(1, owner_id, 100.0, "Bill 1"),
+        CreateTestRow(2, owner_id, 200.0, "Bill 2")
     };
-    expected_bills[0].event.id = event_id;
-    expected_bills[1].event.id = event_id;
+    expected_bills[0].event_id = event_id;
+    expected_bills[1].event_id = event_id;
     
     EXPECT_CALL(*mock_repo_, queryByEvent(owner_id, event_id))
         . WillOnce(Return(expected_bills));
@@ -330,8 +361,8 @@ TEST_F(BillServiceTest, QueryByEvent_Success_MultipleResults) {
     
     // Assert
     ASSERT_EQ(results.size(), 2);
-    EXPECT_EQ(results[0].event.id, event_id);
-    EXPECT_EQ(results[1].event.id, event_id);
+    EXPECT_EQ(results[0].event_id, event_id);
+    EXPECT_EQ(results[1].event_id, event_id);
 }
 
 TEST_F(BillServiceTest, QueryByEvent_Success_NoResults) {
@@ -339,7 +370,7 @@ TEST_F(BillServiceTest, QueryByEvent_Success_NoResults) {
     const int owner_id = 1;
     const int event_id = 999;
     
-    std::vector<model::Bill> empty_bills;
+    std::vector<model::BillRow> empty_bills;
     
     EXPECT_CALL(*mock_repo_, queryByEvent(owner_id, event_id))
         . WillOnce(Return(empty_bills));
@@ -402,9 +433,9 @@ TEST_F(BillServiceTest, QueryByPhone_Success_MultipleResults) {
     // Arrange
     const std::string phone = "13800138000";
     
-    std::vector<model::Bill> expected_bills = {
-        CreateTestBill(1, 1, 100.0, "Bill 1"),
-        CreateTestBill(2, 1, 200.0, "Bill 2")
+    std::vector<model::BillRow> expected_bills = {
+        CreateTestRow(1, 1, 100.0, "Bill 1"),
+        CreateTestRow(2, 1, 200.0, "Bill 2")
     };
     
     EXPECT_CALL(*mock_repo_, queryByPhone(phone))
@@ -423,7 +454,7 @@ TEST_F(BillServiceTest, QueryByPhone_Success_NoResults) {
     // Arrange
     const std::string phone = "99999999999";
     
-    std::vector<model::Bill> empty_bills;
+    std::vector<model::BillRow> empty_bills;
     
     EXPECT_CALL(*mock_repo_, queryByPhone(phone))
         .WillOnce(Return(empty_bills));
@@ -463,7 +494,7 @@ TEST_F(BillServiceTest, EditBill_Success_UpdateDescription) {
     model::Bill saved_bill;
     EXPECT_CALL(*mock_repo_, save(_))
         .Times(1)
-        .WillOnce(SaveArg<0>(&saved_bill));
+        .WillOnce(DoAll(SaveArg<0>(&saved_bill), Return(1)));
     
     // Act
     bill_service_->editBill(bill_id, updates);
@@ -485,14 +516,14 @@ TEST_F(BillServiceTest, EditBill_Success_UpdateAmount) {
     model::Bill saved_bill;
     EXPECT_CALL(*mock_repo_, save(_))
         . Times(1)
-        .WillOnce(SaveArg<0>(&saved_bill));
+        .WillOnce(DoAll(SaveArg<0>(&saved_bill), Return(1)));
     
     // Act
     bill_service_->editBill(bill_id, updates);
     
     // Assert
     EXPECT_EQ(saved_bill. id, bill_id);
-    EXPECT_DOUBLE_EQ(saved_bill. amount, 250.75);
+    EXPECT_EQ(saved_bill. amount.cents, 25075);
 }
 
 TEST_F(BillServiceTest, EditBill_Success_PreservesBillId) {
@@ -507,7 +538,7 @@ TEST_F(BillServiceTest, EditBill_Success_PreservesBillId) {
     model::Bill saved_bill;
     EXPECT_CALL(*mock_repo_, save(_))
         .Times(1)
-        . WillOnce(SaveArg<0>(&saved_bill));
+        . WillOnce(DoAll(SaveArg<0>(&saved_bill), Return(1)));
     
     // Act
     bill_service_->editBill(bill_id, updates);
@@ -620,15 +651,18 @@ TEST_F(BillServiceTest, AnnotateBill_Success) {
     // Arrange
     const int bill_id = 1;
     model::Bill existing_bill = CreateTestBill(bill_id, 1, 100.0);
-    model::Annotation annotation = CreateTestAnnotation(1, "Important note", 2);
+    model::Annotation annotation = CreateTestAnnotation(0, "Important note", 2);
     
     EXPECT_CALL(*mock_repo_, findById(bill_id))
         . WillOnce(Return(existing_bill));
+    // 批注 id 由批注仓库分配
+    EXPECT_CALL(*mock_annotation_repo_, save(_))
+        .WillOnce(Return(1));
     
     model::Bill saved_bill;
     EXPECT_CALL(*mock_repo_, save(_))
         .Times(1)
-        .WillOnce(SaveArg<0>(&saved_bill));
+        .WillOnce(DoAll(SaveArg<0>(&saved_bill), Return(1)));
     
     // Act
     bill_service_->annotateBill(bill_id, annotation);
@@ -653,7 +687,7 @@ TEST_F(BillServiceTest, AnnotateBill_Success_UpdateExistingAnnotation) {
     model::Bill saved_bill;
     EXPECT_CALL(*mock_repo_, save(_))
         . Times(1)
-        .WillOnce(SaveArg<0>(&saved_bill));
+        .WillOnce(DoAll(SaveArg<0>(&saved_bill), Return(1)));
     
     // Act
     bill_service_->annotateBill(bill_id, new_annotation);
@@ -696,7 +730,7 @@ TEST_F(BillServiceTest, AnnotateBill_Failure_InvalidBillId) {
     // Assert - 无异常即通过
 }
 
-TEST_F(BillServiceTest, AnnotateBill_Success_EmptyContent) {
+TEST_F(BillServiceTest, AnnotateBill_Failure_EmptyContent) {
     // Arrange
     const int bill_id = 1;
     model::Bill existing_bill = CreateTestBill(bill_id, 1, 100.0);
@@ -705,16 +739,14 @@ TEST_F(BillServiceTest, AnnotateBill_Success_EmptyContent) {
     EXPECT_CALL(*mock_repo_, findById(bill_id))
         .WillOnce(Return(existing_bill));
     
-    model::Bill saved_bill;
+    // 空批注不保存
     EXPECT_CALL(*mock_repo_, save(_))
-        .Times(1)
-        .WillOnce(SaveArg<0>(&saved_bill));
+        .Times(0);
     
     // Act
     bill_service_->annotateBill(bill_id, empty_annotation);
     
-    // Assert
-    EXPECT_EQ(saved_bill.annotation. content, "");
+    // Assert - 无异常即通过
 }
 
 // ==================== Integration Tests ====================
@@ -727,11 +759,11 @@ TEST_F(BillServiceTest, Integration_CreateAndQueryByTime) {
     EXPECT_CALL(*mock_repo_, save(_))
         .Times(1);
     
-    auto from_time = base_time_ - std::chrono::hours(1);
-    auto to_time = base_time_ + std::chrono::hours(1);
+    auto from_time = base_time_ - 3600;
+    auto to_time = base_time_ + 3600;
     
-    std::vector<model::Bill> expected_bills = {
-        CreateTestBill(1, owner_id, 100.0)
+    std::vector<model::BillRow> expected_bills = {
+        CreateTestRow(1, owner_id, 100.0)
     };
     
     EXPECT_CALL(*mock_repo_, queryByTime(owner_id, from_time, to_time))
@@ -8,15 +8,16 @@ using ::testing::_;
 using ::testing::Return;
 using ::testing::NiceMock;
 using ::testing::SaveArg;
+using ::testing::DoAll;
 using ::testing::Invoke;
 
 // Mock EventRepository
 class MockEventRepository : public repo::IEventRepository {
 public:
-    MOCK_METHOD(void, save, (const model::Event& e), (override));
+    MOCK_METHOD(int, save, (const model::Event& e), (override));
     MOCK_METHOD(std::optional<model::Event>, findById, (int id), (override));
     MOCK_METHOD(std::optional<model::Event>, findByName, (const std::string& name), (override));
-    MOCK_METHOD(bool, setStatusById, (int id, model::EventStatus status), (override));
+    MOCK_METHOD(bool, setStatusById, (int id, int status), (override));
 };
 
 class EventServiceTest : public ::testing::Test {
@@ -25,7 +26,7 @@ protected:
         mock_repo_ = std::make_shared<NiceMock<MockEventRepository>>();
         event_service_ = std::make_unique<EventService>(mock_repo_);
         
-        base_time_ = std::chrono::system_clock::now();
+        base_time_ = model::Now();
     }
 
     void TearDown() override {
@@ -36,7 +37,7 @@ protected:
     // 辅助函数：创建测试事件
     model::Event CreateTestEvent(int id = 1,
                                   const std::string& name = "Test Event",
-                                  model::EventStatus status = model::EventStatus::Available) {
+                                  int status = model::EventStatus::Available) {
         model::Event event;
         event.id = id;
         event.name = name;
@@ -180,7 +181,7 @@ TEST_F(EventServiceTest, CreateEvent_Success_NewEvent) {
     model::Event saved_event;
     EXPECT_CALL(*mock_repo_, save(_))
         .Times(1)
-        .WillOnce(SaveArg<0>(&saved_event));
+        .WillOnce(DoAll(SaveArg<0>(&saved_event), Return(1)));
     
     // Act
     auto result = event_service_->CreateEvent(new_event);
@@ -202,15 +203,15 @@ TEST_F(EventServiceTest, CreateEvent_Success_SetsCreatedTime) {
     model::Event saved_event;
     EXPECT_CALL(*mock_repo_, save(_))
         .Times(1)
-        .WillOnce(SaveArg<0>(&saved_event));
+        .WillOnce(DoAll(SaveArg<0>(&saved_event), Return(1)));
     
-    auto before_time = std::chrono::system_clock::now();
+    auto before_time = model::Now();
     
     // Act
-    new_event.created_at = std::chrono::system_clock::now();
+    new_event.created_at = model::Now();
     auto result = event_service_->CreateEvent(new_event);
     
-    auto after_time = std::chrono::system_clock::now();
+    auto after_time = model::Now();
     
     // Assert
     ASSERT_TRUE(result.has_value());
@@ -231,7 +232,7 @@ TEST_F(EventServiceTest, CreateEvent_Success_DefaultStatusAvailable) {
     model::Event saved_event;
     EXPECT_CALL(*mock_repo_, save(_))
         .Times(1)
-        .WillOnce(SaveArg<0>(&saved_event));
+        .WillOnce(DoAll(SaveArg<0>(&saved_event), Return(1)));
     
     // Act
     auto result = event_service_->CreateEvent(new_event);
@@ -251,7 +252,7 @@ TEST_F(EventServiceTest, CreateEvent_Success_CreateFrozenEvent) {
     model::Event saved_event;
     EXPECT_CALL(*mock_repo_, save(_))
         .Times(1)
-        .WillOnce(SaveArg<0>(&saved_event));
+        .WillOnce(DoAll(SaveArg<0>(&saved_event), Return(1)));
     
     // Act
     auto result = event_service_->CreateEvent(new_event);
@@ -0,0 +1,102 @@
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+#include "services/SearchService.h"
+#include "data/irepositories.h"
+#include "common/models.h"
+
+using ::testing::_;
+using ::testing::ElementsAre;
+using ::testing::IsEmpty;
+using ::testing::Return;
+using ::testing::NiceMock;
+
+class MockSearchRepository : public repo::ISearchRepository {
+public:
+    MOCK_METHOD(model::SearchPage, search,
+                (const std::string& match, const std::vector<std::string>& substrings, int ownerId, int offset,
+                 int limit),
+                (override));
+};
+
+class SearchServiceTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        mock_repo_ = std::make_shared<NiceMock<MockSearchRepository>>();
+        search_service_ = std::make_unique<SearchService>(mock_repo_);
+    }
+
+    std::shared_ptr<NiceMock<MockSearchRepository>> mock_repo_;
+    std::unique_ptr<SearchService> search_service_;
+};
+
+TEST_F(SearchServiceTest, ToMatchExpression_QuotesEachTerm) {
+    EXPECT_EQ(SearchService::ToMatchExpression("taxi"), "\"taxi\"");
+    EXPECT_EQ(SearchService::ToMatchExpression("  taxi   airport "), "\"taxi\" \"airport\"");
+    EXPECT_EQ(SearchService::ToMatchExpression("公司 聚餐报销"), "\"公司\" \"聚餐报销\"");
+    EXPECT_EQ(SearchService::ToMatchExpression("   "), "");
+}
+
+TEST_F(SearchServiceTest, ToMatchExpression_EscapesDoubleQuotes) {
+    EXPECT_EQ(SearchService::ToMatchExpression("say \"hi\""), "\"say\" \"\"\"hi\"\"\"");
+    EXPECT_EQ(SearchService::ToMatchExpression("\""), "\"\"\"\"");
+}
+
+TEST_F(SearchServiceTest, ToMatchExpression_OperatorsStayLiteral) {
+    // FTS5 的运算符、前缀 * 与列过滤都被包在短语里，不改变查询结构
+    EXPECT_EQ(SearchService::ToMatchExpression("taxi OR bus"), "\"taxi\" \"OR\" \"bus\"");
+    EXPECT_EQ(SearchService::ToMatchExpression("ta* description:x"), "\"ta*\" \"description:x\"");
+}
+
+TEST_F(SearchServiceTest, Search_ForwardsOwnerAndPage) {
+    model::SearchPage page;
+    page.bills.resize(2);
+    EXPECT_CALL(*mock_repo_, search("\"taxi\"", IsEmpty(), 1, 20, 20))
+        .WillOnce(Return(page));
+
+    auto result = search_service_->Search(1, "taxi", 20, 20);
+
+    EXPECT_EQ(result.bills.size(), 2u);
+}
+
+TEST_F(SearchServiceTest, Search_ShortTerms_PassedAsSubstrings) {
+    // 按字符而非字节计长：两个汉字、两个字母都不足 3 个字符，三个汉字可以走索引
+    EXPECT_CALL(*mock_repo_, search("", ElementsAre("餐饮"), 1, 0, 20))
+        .WillOnce(Return(model::SearchPage()));
+    EXPECT_CALL(*mock_repo_, search("\"taxi\" \"聚餐报\"", ElementsAre("交通", "ta"), 1, 0, 20))
+        .WillOnce(Return(model::SearchPage()));
+
+    search_service_->Search(1, "餐饮", 20);
+    search_service_->Search(1, "交通 taxi ta 聚餐报", 20);
+}
+
+TEST_F(SearchServiceTest, Search_EmptyText_DoesNotQuery) {
+    EXPECT_CALL(*mock_repo_, search(_, _, _, _, _)).Times(0);
+
+    EXPECT_TRUE(search_service_->Search(1, "", 20).bills.empty());
+    EXPECT_TRUE(search_service_->Search(1, " \t", 20).bills.empty());
+}
+
+TEST_F(SearchServiceTest, Search_InvalidArguments_DoesNotQuery) {
+    EXPECT_CALL(*mock_repo_, search(_, _, _, _, _)).Times(0);
+
+    EXPECT_TRUE(search_service_->Search(-1, "taxi", 20).bills.empty());
+    EXPECT_TRUE(search_service_->Search(1, "taxi", 0).bills.empty());
+    EXPECT_TRUE(search_service_->Search(1, "taxi", 20, -5).bills.empty());
+}
+
+TEST_F(SearchServiceTest, Search_ClampsPageSize) {
+    EXPECT_CALL(*mock_repo_, search(_, _, 1, 0, 500))
+        .Times(3)
+        .WillRepeatedly(Return(model::SearchPage()));
+
+    search_service_->Search(1, "taxi", 100000);
+    search_service_->Search(1, "taxi", 501);
+    search_service_->Search(1, "taxi", 500);
+}
+
+TEST_F(SearchServiceTest, Search_PageSizeBelowCap_Unchanged) {
+    EXPECT_CALL(*mock_repo_, search(_, _, 1, 0, 499))
+        .WillOnce(Return(model::SearchPage()));
+
+    search_service_->Search(1, "taxi", 499);
+}
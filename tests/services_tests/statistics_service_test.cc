@@ -12,15 +12,30 @@ using ::testing::NiceMock;
 // Mock BillRepository
 class MockBillRepository : public repo::IBillRepository {
 public:
-    MOCK_METHOD(void, save, (const model::Bill& b), (override));
+    MOCK_METHOD(int, save, (const model::Bill& b), (override));
+    MOCK_METHOD(std::vector<int>, saveBatch, (const std::vector<model::Bill>& bills), (override));
     MOCK_METHOD(std::optional<model::Bill>, findById, (int id), (override));
-    MOCK_METHOD(std::vector<model::Bill>, queryByEvent, (int ownerId, int eventId), (override));
-    MOCK_METHOD(std::vector<model::Bill>, queryByEvent, (std::string& name), (override));
-    MOCK_METHOD(std::vector<model::Bill>, queryByTime, (int ownerId, model::Timestamp from, model::Timestamp to), (override));
-    MOCK_METHOD(std::vector<model::Bill>, queryByTime, (model::Timestamp from, model::Timestamp to), (override));
-    MOCK_METHOD(std::vector<model::Bill>, queryByTimeInOrder, (model::Timestamp from, model::Timestamp to), (override));
-    MOCK_METHOD(std::vector<model::Bill>, queryByTimeAndEventInOrder, (model::Timestamp from, model::Timestamp to), (override));
-    MOCK_METHOD(std::vector<model::Bill>, queryByPhone, (const std::string& phone), (override));
+    MOCK_METHOD(std::vector<model::BillRow>, queryByEvent, (int ownerId, int eventId), (override));
+    MOCK_METHOD(std::vector<model::BillRow>, queryByEvent, (const std::string& name), (override));
+    MOCK_METHOD(std::vector<model::BillRow>, queryByTime, (int ownerId, model::Timestamp from, model::Timestamp to), (override));
+    MOCK_METHOD(std::vector<model::BillRow>, queryByTime, (model::Timestamp from, model::Timestamp to), (override));
+    MOCK_METHOD(model::BillPage, queryByTimePage, (model::Timestamp from, model::Timestamp to, const std::optional<model::BillCursor>& after, int page_size), (override));
+    MOCK_METHOD(std::vector<model::BillRow>, queryByTimeInOrder, (model::Timestamp from, model::Timestamp to), (override));
+    MOCK_METHOD(std::vector<model::BillRow>, queryByTimeAndEventInOrder, (model::Timestamp from, model::Timestamp to), (override));
+    MOCK_METHOD(std::pmr::vector<model::PmrBillRow>, queryByTime, (int ownerId, model::Timestamp from, model::Timestamp to, std::pmr::memory_resource* mr), (override));
+    MOCK_METHOD(std::pmr::vector<model::PmrBillRow>, queryByTime, (model::Timestamp from, model::Timestamp to, std::pmr::memory_resource* mr), (override));
+    MOCK_METHOD(std::pmr::vector<model::PmrBillRow>, queryByTimeInOrder, (model::Timestamp from, model::Timestamp to, std::pmr::memory_resource* mr), (override));
+    MOCK_METHOD(std::pmr::vector<model::PmrBillRow>, queryByTimeAndEventInOrder, (model::Timestamp from, model::Timestamp to, std::pmr::memory_resource* mr), (override));
+    MOCK_METHOD(std::vector<model::BillTotal>, totalsByEvent, (model::Timestamp from, model::Timestamp to), (override));
+    MOCK_METHOD(std::vector<model::BillTotal>, totalsByOwner, (model::Timestamp from, model::Timestamp to), (override));
+    MOCK_METHOD(std::vector<model::PeriodTotal>, totalsByPeriod, (model::Timestamp from, model::Timestamp to, model::Granularity granularity), (override));
+    MOCK_METHOD(model::BillSummary, summary, (model::Timestamp from, model::Timestamp to), (override));
+    MOCK_METHOD(void, rebuildRollups, (), (override));
+    MOCK_METHOD(std::vector<model::RollupMismatch>, checkRollups, (), (override));
+    MOCK_METHOD(void, forEachByTime, (model::Timestamp from, model::Timestamp to, const repo::BillVisitor& visit), (override));
+    MOCK_METHOD(void, forEachByTimeInOrder, (model::Timestamp from, model::Timestamp to, const repo::BillVisitor& visit), (override));
+    MOCK_METHOD(void, forEachByTimeAndEventInOrder, (model::Timestamp from, model::Timestamp to, const repo::BillVisitor& visit), (override));
+    MOCK_METHOD(std::vector<model::BillRow>, queryByPhone, (const std::string& phone), (override));
     MOCK_METHOD(void, remove, (int id), (override));
 };
 
@@ -31,7 +46,7 @@ protected:
         stats_service_ = std::make_unique<StatisticsService>(mock_repo_);
         
         // 设置基准时间
-        base_time_ = std::chrono::system_clock::now();
+        base_time_ = model::Now();
     }
 
     void TearDown() override {
@@ -39,30 +54,24 @@ protected:
         mock_repo_.reset();
     }
 
-    // 辅助函数：创建测试账单
-    model::Bill CreateTestBill(int id,
-                               int owner_id,
-                               int event_id,
-                               const std::string& event_name,
-                               double amount,
-                               model::Timestamp created_at) {
-        model::Bill bill;
-        bill.id = id;
-        bill.owner_id = owner_id;
-        bill.event_id = event_id;
-        bill.amount = amount;
-        bill.created_at = created_at;
-        bill.description = "Test Bill " + std::to_string(id);
-        
-        bill.event. id = event_id;
-        bill.event.name = event_name;
-        bill.event.status = model::EventStatus::Available;
-        
-        return bill;
+    // 辅助函数：创建测试账单行
+    model::BillRow CreateTestRow(int id,
+                                 int owner_id,
+                                 int event_id,
+                                 double amount,
+                                 model::Timestamp created_at) {
+        model::BillRow row;
+        row.id = id;
+        row.owner_id = owner_id;
+        row.event_id = event_id;
+        row.amount = model::Money::FromDouble(amount);
+        row.created_at = created_at;
+        row.description = "Test Bill " + std::to_string(id);
+        return row;
     }
 
     // 辅助函数：验证账单是否按时间升序排列
-    bool IsTimeAscending(const std::vector<model::Bill>& bills) {
+    bool IsTimeAscending(const std::vector<model::BillRow>& bills) {
         for (size_t i = 1; i < bills.size(); ++i) {
             if (bills[i].created_at < bills[i - 1].created_at) {
                 return false;
@@ -72,7 +81,7 @@ protected:
     }
 
     // 辅助函数：验证账单是否按时间和事件排序
-    bool IsTimeAndEventOrdered(const std::vector<model::Bill>& bills) {
+    bool IsTimeAndEventOrdered(const std::vector<model::BillRow>& bills) {
         for (size_t i = 1; i < bills.size(); ++i) {
             // 先按时间
             if (bills[i].created_at < bills[i - 1].created_at) {
@@ -97,15 +106,15 @@ protected:
 
 TEST_F(StatisticsServiceTest, QueryByTimeInOrder_Success_MultipleResults_Ordered) {
     // Arrange
-    auto from_time = base_time_ - std::chrono::hours(24);
+    auto from_time = base_time_ - 24 * 3600;
     auto to_time = base_time_;
     
     // 创建无序的账单列表（按时间）
-    std::vector<model::Bill> expected_bills = {
-        CreateTestBill(1, 1, 1, "Shopping", 100.0, base_time_ - std::chrono::hours(20)),
-        CreateTestBill(2, 2, 2, "Dining", 50.0, base_time_ - std::chrono::hours(15)),
-        CreateTestBill(3, 1, 1, "Shopping", 200.0, base_time_ - std::chrono::hours(10)),
-        CreateTestBill(4, 3, 3, "Transport", 30.0, base_time_ - std::chrono::hours(5))
+    std::vector<model::BillRow> expected_bills = {
+        CreateTestRow(1, 1, 1, 100.0, base_time_ - 20 * 3600),
+        CreateTestRow(2, 2, 2, 50.0, base_time_ - 15 * 3600),
+        CreateTestRow(3, 1, 1, 200.0, base_time_ - 10 * 3600),
+        CreateTestRow(4, 3, 3, 30.0, base_time_ - 5 * 3600)
     };
     
     EXPECT_CALL(*mock_repo_, queryByTimeInOrder(from_time, to_time))
@@ -125,11 +134,11 @@ TEST_F(StatisticsServiceTest, QueryByTimeInOrder_Success_MultipleResults_Ordered
 
 TEST_F(StatisticsServiceTest, QueryByTimeInOrder_Success_SingleResult) {
     // Arrange
-    auto from_time = base_time_ - std::chrono::hours(1);
+    auto from_time = base_time_ - 3600;
     auto to_time = base_time_;
     
-    std::vector<model::Bill> expected_bills = {
-        CreateTestBill(1, 1, 1, "Shopping", 100.0, base_time_ - std::chrono::minutes(30))
+    std::vector<model::BillRow> expected_bills = {
+        CreateTestRow(1, 1, 1, 100.0, base_time_ - 30 * 60)
     };
     
     EXPECT_CALL(*mock_repo_, queryByTimeInOrder(from_time, to_time))
@@ -145,10 +154,10 @@ TEST_F(StatisticsServiceTest, QueryByTimeInOrder_Success_SingleResult) {
 
 TEST_F(StatisticsServiceTest, QueryByTimeInOrder_Success_NoResults) {
     // Arrange
-    auto from_time = base_time_ - std::chrono::hours(48);
-    auto to_time = base_time_ - std::chrono::hours(24);
+    auto from_time = base_time_ - 48 * 3600;
+    auto to_time = base_time_ - 24 * 3600;
     
-    std::vector<model::Bill> empty_bills;
+    std::vector<model::BillRow> empty_bills;
     
     EXPECT_CALL(*mock_repo_, queryByTimeInOrder(from_time, to_time))
         .WillOnce(Return(empty_bills));
@@ -163,7 +172,7 @@ TEST_F(StatisticsServiceTest, QueryByTimeInOrder_Success_NoResults) {
 TEST_F(StatisticsServiceTest, QueryByTimeInOrder_Failure_InvalidTimeRange) {
     // Arrange
     auto from_time = base_time_;
-    auto to_time = base_time_ - std::chrono::hours(24);  // to_time < from_time
+    auto to_time = base_time_ - 24 * 3600;  // to_time < from_time
     
     // 不应该调用 repository
     EXPECT_CALL(*mock_repo_, queryByTimeInOrder(_, _))
@@ -180,8 +189,8 @@ TEST_F(StatisticsServiceTest, QueryByTimeInOrder_Success_SameTime) {
     // Arrange
     auto same_time = base_time_;
     
-    std::vector<model::Bill> expected_bills = {
-        CreateTestBill(1, 1, 1, "Shopping", 100.0, same_time)
+    std::vector<model::BillRow> expected_bills = {
+        CreateTestRow(1, 1, 1, 100.0, same_time)
     };
     
     EXPECT_CALL(*mock_repo_, queryByTimeInOrder(same_time, same_time))
@@ -196,15 +205,15 @@ TEST_F(StatisticsServiceTest, QueryByTimeInOrder_Success_SameTime) {
 
 TEST_F(StatisticsServiceTest, QueryByTimeInOrder_Success_LargeDataset) {
     // Arrange
-    auto from_time = base_time_ - std::chrono::hours(100);
+    auto from_time = base_time_ - 100 * 3600;
     auto to_time = base_time_;
     
     // 创建 100 条记录
-    std::vector<model::Bill> expected_bills;
+    std::vector<model::BillRow> expected_bills;
     for (int i = 0; i < 100; ++i) {
         expected_bills. push_back(
-            CreateTestBill(i + 1, 1, 1, "Event", 100.0, 
-                          base_time_ - std::chrono::hours(100 - i))
+            CreateTestRow(i + 1, 1, 1, 100.0, 
+                          base_time_ - (100 - i) * 3600)
         );
     }
     
@@ -221,14 +230,14 @@ TEST_F(StatisticsServiceTest, QueryByTimeInOrder_Success_LargeDataset) {
 
 TEST_F(StatisticsServiceTest, QueryByTimeInOrder_Success_MultipleUsersData) {
     // Arrange
-    auto from_time = base_time_ - std::chrono::hours(24);
+    auto from_time = base_time_ - 24 * 3600;
     auto to_time = base_time_;
     
-    std::vector<model::Bill> expected_bills = {
-        CreateTestBill(1, 1, 1, "Shopping", 100.0, base_time_ - std::chrono::hours(20)),
-        CreateTestBill(2, 2, 2, "Dining", 50.0, base_time_ - std::chrono::hours(18)),
-        CreateTestBill(3, 3, 3, "Transport", 30.0, base_time_ - std::chrono::hours(16)),
-        CreateTestBill(4, 1, 1, "Shopping", 200.0, base_time_ - std::chrono::hours(14))
+    std::vector<model::BillRow> expected_bills = {
+        CreateTestRow(1, 1, 1, 100.0, base_time_ - 20 * 3600),
+        CreateTestRow(2, 2, 2, 50.0, base_time_ - 18 * 3600),
+        CreateTestRow(3, 3, 3, 30.0, base_time_ - 16 * 3600),
+        CreateTestRow(4, 1, 1, 200.0, base_time_ - 14 * 3600)
     };
     
     EXPECT_CALL(*mock_repo_, queryByTimeInOrder(from_time, to_time))
@@ -248,13 +257,13 @@ TEST_F(StatisticsServiceTest, QueryByTimeInOrder_Success_MultipleUsersData) {
 
 TEST_F(StatisticsServiceTest, QueryByTimeInOrder_Success_LongTimeRange) {
     // Arrange
-    auto from_time = base_time_ - std::chrono::hours(24 * 365);  // 一年
+    auto from_time = base_time_ - 24 * 365 * 3600;  // 一年
     auto to_time = base_time_;
     
-    std::vector<model::Bill> expected_bills = {
-        CreateTestBill(1, 1, 1, "Event1", 100.0, base_time_ - std::chrono::hours(24 * 300)),
-        CreateTestBill(2, 1, 2, "Event2", 200.0, base_time_ - std::chrono::hours(24 * 200)),
-        CreateTestBill(3, 1, 3, "Event3", 300.0, base_time_ - std::chrono::hours(24 * 100))
+    std::vector<model::BillRow> expected_bills = {
+        CreateTestRow(1, 1, 1, 100.0, base_time_ - 24 * 300 * 3600),
+        CreateTestRow(2, 1, 2, 200.0, base_time_ - 24 * 200 * 3600),
+        CreateTestRow(3, 1, 3, 300.0, base_time_ - 24 * 100 * 3600)
     };
     
     EXPECT_CALL(*mock_repo_, queryByTimeInOrder(from_time, to_time))
@@ -272,18 +281,18 @@ TEST_F(StatisticsServiceTest, QueryByTimeInOrder_Success_LongTimeRange) {
 
 TEST_F(StatisticsServiceTest, QueryByTimeAndEventInOrder_Success_OrderedByTimeAndEvent) {
     // Arrange
-    auto from_time = base_time_ - std::chrono::hours(24);
+    auto from_time = base_time_ - 24 * 3600;
     auto to_time = base_time_;
     
-    auto same_time = base_time_ - std::chrono::hours(10);
+    auto same_time = base_time_ - 10 * 3600;
     
     // 相同时间，不同事件ID
-    std::vector<model::Bill> expected_bills = {
-        CreateTestBill(1, 1, 1, "Shopping", 100.0, base_time_ - std::chrono::hours(20)),
-        CreateTestBill(2, 1, 1, "Shopping", 50.0, same_time),    // 相同时间，事件ID=1
-        CreateTestBill(3, 1, 2, "Dining", 200.0, same_time),     // 相同时间，事件ID=2
-        CreateTestBill(4, 1, 3, "Transport", 30.0, same_time),   // 相同时间，事件ID=3
-        CreateTestBill(5, 1, 2, "Dining", 150.0, base_time_ - std::chrono::hours(5))
+    std::vector<model::BillRow> expected_bills = {
+        CreateTestRow(1, 1, 1, 100.0, base_time_ - 20 * 3600),
+        CreateTestRow(2, 1, 1, 50.0, same_time),    // 相同时间，事件ID=1
+        CreateTestRow(3, 1, 2, 200.0, same_time),     // 相同时间，事件ID=2
+        CreateTestRow(4, 1, 3, 30.0, same_time),   // 相同时间，事件ID=3
+        CreateTestRow(5, 1, 2, 150.0, base_time_ - 5 * 3600)
     };
     
     EXPECT_CALL(*mock_repo_, queryByTimeAndEventInOrder(from_time, to_time))
@@ -304,16 +313,16 @@ TEST_F(StatisticsServiceTest, QueryByTimeAndEventInOrder_Success_OrderedByTimeAn
 
 TEST_F(StatisticsServiceTest, QueryByTimeAndEventInOrder_Success_AllSameTime_DifferentEvents) {
     // Arrange
-    auto from_time = base_time_ - std::chrono::hours(1);
+    auto from_time = base_time_ - 3600;
     auto to_time = base_time_;
     
-    auto same_time = base_time_ - std::chrono::minutes(30);
+    auto same_time = base_time_ - 30 * 60;
     
-    std::vector<model::Bill> expected_bills = {
-        CreateTestBill(1, 1, 1, "Event1", 100.0, same_time),
-        CreateTestBill(2, 1, 2, "Event2", 200.0, same_time),
-        CreateTestBill(3, 1, 3, "Event3", 300.0, same_time),
-        CreateTestBill(4, 1, 4, "Event4", 400.0, same_time)
+    std::vector<model::BillRow> expected_bills = {
+        CreateTestRow(1, 1, 1, 100.0, same_time),
+        CreateTestRow(2, 1, 2, 200.0, same_time),
+        CreateTestRow(3, 1, 3, 300.0, same_time),
+        CreateTestRow(4, 1, 4, 400.0, same_time)
     };
     
     EXPECT_CALL(*mock_repo_, queryByTimeAndEventInOrder(from_time, to_time))
@@ -334,11 +343,11 @@ TEST_F(StatisticsServiceTest, QueryByTimeAndEventInOrder_Success_AllSameTime_Dif
 
 TEST_F(StatisticsServiceTest, QueryByTimeAndEventInOrder_Success_SingleResult) {
     // Arrange
-    auto from_time = base_time_ - std::chrono::hours(1);
+    auto from_time = base_time_ - 3600;
     auto to_time = base_time_;
     
-    std::vector<model::Bill> expected_bills = {
-        CreateTestBill(1, 1, 1, "Shopping", 100.0, base_time_ - std::chrono::minutes(30))
+    std::vector<model::BillRow> expected_bills = {
+        CreateTestRow(1, 1, 1, 100.0, base_time_ - 30 * 60)
     };
     
     EXPECT_CALL(*mock_repo_, queryByTimeAndEventInOrder(from_time, to_time))
@@ -354,10 +363,10 @@ TEST_F(StatisticsServiceTest, QueryByTimeAndEventInOrder_Success_SingleResult) {
 
 TEST_F(StatisticsServiceTest, QueryByTimeAndEventInOrder_Success_NoResults) {
     // Arrange
-    auto from_time = base_time_ - std::chrono::hours(48);
-    auto to_time = base_time_ - std::chrono::hours(24);
+    auto from_time = base_time_ - 48 * 3600;
+    auto to_time = base_time_ - 24 * 3600;
     
-    std::vector<model::Bill> empty_bills;
+    std::vector<model::BillRow> empty_bills;
     
     EXPECT_CALL(*mock_repo_, queryByTimeAndEventInOrder(from_time, to_time))
         .WillOnce(Return(empty_bills));
@@ -372,7 +381,7 @@ TEST_F(StatisticsServiceTest, QueryByTimeAndEventInOrder_Success_NoResults) {
 TEST_F(StatisticsServiceTest, QueryByTimeAndEventInOrder_Failure_InvalidTimeRange) {
     // Arrange
     auto from_time = base_time_;
-    auto to_time = base_time_ - std::chrono::hours(24);
+    auto to_time = base_time_ - 24 * 3600;
     
     EXPECT_CALL(*mock_repo_, queryByTimeAndEventInOrder(_, _))
         .Times(0);
@@ -386,22 +395,22 @@ TEST_F(StatisticsServiceTest, QueryByTimeAndEventInOrder_Failure_InvalidTimeRang
 
 TEST_F(StatisticsServiceTest, QueryByTimeAndEventInOrder_Success_MixedTimeAndEvents) {
     // Arrange
-    auto from_time = base_time_ - std::chrono::hours(24);
+    auto from_time = base_time_ - 24 * 3600;
     auto to_time = base_time_;
     
-    auto time1 = base_time_ - std::chrono::hours(20);
-    auto time2 = base_time_ - std::chrono::hours(15);
-    auto time3 = base_time_ - std::chrono::hours(10);
+    auto time1 = base_time_ - 20 * 3600;
+    auto time2 = base_time_ - 15 * 3600;
+    auto time3 = base_time_ - 10 * 3600;
     
-    std::vector<model::Bill> expected_bills = {
+    std::vector<model::BillRow> expected_bills = {
         // 时间1
-        CreateTestBill(1, 1, 2, "Event2", 100.0, time1),
-        CreateTestBill(2, 1, 5, "Event5", 200.0, time1),
+        CreateTestRow(1, 1, 2, 100.0, time1),
+        CreateTestRow(2, 1, 5, 200.0, time1),
         // 时间2
-        CreateTestBill(3, 1, 1, "Event1", 150.0, time2),
-        CreateTestBill(4, 1, 3, "Event3", 250.0, time2),
+        CreateTestRow(3, 1, 1, 150.0, time2),
+        CreateTestRow(4, 1, 3, 250.0, time2),
         // 时间3
-        CreateTestBill(5, 1, 4, "Event4", 300.0, time3)
+        CreateTestRow(5, 1, 4, 300.0, time3)
     };
     
     EXPECT_CALL(*mock_repo_, queryByTimeAndEventInOrder(from_time, to_time))
@@ -417,16 +426,16 @@ TEST_F(StatisticsServiceTest, QueryByTimeAndEventInOrder_Success_MixedTimeAndEve
 
 TEST_F(StatisticsServiceTest, QueryByTimeAndEventInOrder_Success_LargeDataset) {
     // Arrange
-    auto from_time = base_time_ - std::chrono::hours(100);
+    auto from_time = base_time_ - 100 * 3600;
     auto to_time = base_time_;
     
-    std::vector<model::Bill> expected_bills;
+    std::vector<model::BillRow> expected_bills;
     
     // 创建 50 个不同时间，每个时间 2 个不同事件
     for (int i = 0; i < 50; ++i) {
-        auto time = base_time_ - std::chrono::hours(100 - i * 2);
-        expected_bills.push_back(CreateTestBill(i * 2 + 1, 1, 1, "Event1", 100.0, time));
-        expected_bills.push_back(CreateTestBill(i * 2 + 2, 1, 2, "Event2", 200.0, time));
+        auto time = base_time_ - (100 - i * 2) * 3600;
+        expected_bills.push_back(CreateTestRow(i * 2 + 1, 1, 1, 100.0, time));
+        expected_bills.push_back(CreateTestRow(i * 2 + 2, 1, 2, 200.0, time));
     }
     
     EXPECT_CALL(*mock_repo_, queryByTimeAndEventInOrder(from_time, to_time))
@@ -444,9 +453,9 @@ TEST_F(StatisticsServiceTest, QueryByTimeAndEventInOrder_Success_SameTimeRange)
     // Arrange
     auto same_time = base_time_;
     
-    std::vector<model::Bill> expected_bills = {
-        CreateTestBill(1, 1, 1, "Event1", 100.0, same_time),
-        CreateTestBill(2, 1, 2, "Event2", 200.0, same_time)
+    std::vector<model::BillRow> expected_bills = {
+        CreateTestRow(1, 1, 1, 100.0, same_time),
+        CreateTestRow(2, 1, 2, 200.0, same_time)
     };
     
     EXPECT_CALL(*mock_repo_, queryByTimeAndEventInOrder(same_time, same_time))
@@ -463,14 +472,14 @@ TEST_F(StatisticsServiceTest, QueryByTimeAndEventInOrder_Success_SameTimeRange)
 
 TEST_F(StatisticsServiceTest, QueryByTimeAndEventInOrder_Success_AllDifferentEvents) {
     // Arrange
-    auto from_time = base_time_ - std::chrono::hours(10);
+    auto from_time = base_time_ - 10 * 3600;
     auto to_time = base_time_;
     
-    std::vector<model::Bill> expected_bills = {
-        CreateTestBill(1, 1, 1, "Event1", 100.0, base_time_ - std::chrono::hours(9)),
-        CreateTestBill(2, 1, 2, "Event2", 200.0, base_time_ - std::chrono::hours(8)),
-        CreateTestBill(3, 1, 3, "Event3", 300.0, base_time_ - std::chrono::hours(7)),
-        CreateTestBill(4, 1, 4, "Event4", 400.0, base_time_ - std::chrono::hours(6))
+    std::vector<model::BillRow> expected_bills = {
+        CreateTestRow(1, 1, 1, 100.0, base_time_ - 9 * 3600),
+        CreateTestRow(2, 1, 2, 200.0, base_time_ - 8 * 3600),
+        CreateTestRow(3, 1, 3, 300.0, base_time_ - 7 * 3600),
+        CreateTestRow(4, 1, 4, 400.0, base_time_ - 6 * 3600)
     };
     
     EXPECT_CALL(*mock_repo_, queryByTimeAndEventInOrder(from_time, to_time))
@@ -493,23 +502,23 @@ TEST_F(StatisticsServiceTest, QueryByTimeAndEventInOrder_Success_AllDifferentEve
 
 TEST_F(StatisticsServiceTest, Compare_BothMethods_SameTimeRange) {
     // Arrange
-    auto from_time = base_time_ - std::chrono::hours(24);
+    auto from_time = base_time_ - 24 * 3600;
     auto to_time = base_time_;
     
-    auto same_time = base_time_ - std::chrono::hours(10);
+    auto same_time = base_time_ - 10 * 3600;
     
-    std::vector<model::Bill> bills_by_time = {
-        CreateTestBill(1, 1, 3, "Event3", 100.0, base_time_ - std::chrono::hours(20)),
-        CreateTestBill(2, 1, 1, "Event1", 50.0, same_time),
-        CreateTestBill(3, 1, 2, "Event2", 200.0, same_time),
-        CreateTestBill(4, 1, 4, "Event4", 30.0, base_time_ - std::chrono::hours(5))
+    std::vector<model::BillRow> bills_by_time = {
+        CreateTestRow(1, 1, 3, 100.0, base_time_ - 20 * 3600),
+        CreateTestRow(2, 1, 1, 50.0, same_time),
+        CreateTestRow(3, 1, 2, 200.0, same_time),
+        CreateTestRow(4, 1, 4, 30.0, base_time_ - 5 * 3600)
     };
     
-    std::vector<model::Bill> bills_by_time_and_event = {
-        CreateTestBill(1, 1, 3, "Event3", 100.0, base_time_ - std::chrono::hours(20)),
-        CreateTestBill(2, 1, 1, "Event1", 50.0, same_time),    // 相同时间，事件ID小的在前
-        CreateTestBill(3, 1, 2, "Event2", 200.0, same_time),
-        CreateTestBill(4, 1, 4, "Event4", 30.0, base_time_ - std::chrono::hours(5))
+    std::vector<model::BillRow> bills_by_time_and_event = {
+        CreateTestRow(1, 1, 3, 100.0, base_time_ - 20 * 3600),
+        CreateTestRow(2, 1, 1, 50.0, same_time),    // 相同时间，事件ID小的在前
+        CreateTestRow(3, 1, 2, 200.0, same_time),
+        CreateTestRow(4, 1, 4, 30.0, base_time_ - 5 * 3600)
     };
     
     EXPECT_CALL(*mock_repo_, queryByTimeInOrder(from_time, to_time))
@@ -533,10 +542,10 @@ TEST_F(StatisticsServiceTest, Compare_BothMethods_SameTimeRange) {
 TEST_F(StatisticsServiceTest, EdgeCase_VeryShortTimeRange) {
     // Arrange
     auto from_time = base_time_;
-    auto to_time = base_time_ + std::chrono::seconds(1);
+    auto to_time = base_time_ + 1;
     
-    std::vector<model::Bill> expected_bills = {
-        CreateTestBill(1, 1, 1, "Event", 100.0, base_time_)
+    std::vector<model::BillRow> expected_bills = {
+        CreateTestRow(1, 1, 1, 100.0, base_time_)
     };
     
     EXPECT_CALL(*mock_repo_, queryByTimeInOrder(from_time, to_time))
@@ -551,10 +560,10 @@ TEST_F(StatisticsServiceTest, EdgeCase_VeryShortTimeRange) {
 
 TEST_F(StatisticsServiceTest, EdgeCase_FutureTimeRange) {
     // Arrange
-    auto from_time = base_time_ + std::chrono::hours(24);
-    auto to_time = base_time_ + std::chrono::hours(48);
+    auto from_time = base_time_ + 24 * 3600;
+    auto to_time = base_time_ + 48 * 3600;
     
-    std::vector<model::Bill> empty_bills;
+    std::vector<model::BillRow> empty_bills;
     
     EXPECT_CALL(*mock_repo_, queryByTimeInOrder(from_time, to_time))
         .WillOnce(Return(empty_bills));
@@ -9,15 +9,16 @@ using ::testing::Return;
 using ::testing::NiceMock;
 using ::testing::Invoke;
 using ::testing::SaveArg;
+using ::testing::DoAll;
 
 // Mock UserRepository
 class MockUserRepository : public repo::IUserRepository {
 public:
-    MOCK_METHOD(void, save, (const model::User& u), (override));
+    MOCK_METHOD(int, save, (const model::User& u), (override));
     MOCK_METHOD(std::optional<model::User>, findById, (int id), (override));
     MOCK_METHOD(std::optional<model::User>, queryByPhone, (const std::string& phone), (override));
     MOCK_METHOD(std::vector<model::User>, queryByPhonePartial, (const std::string& partial), (override));
-    MOCK_METHOD(bool, setBalanceByPhone, (const std::string& phone), (override));
+    MOCK_METHOD(bool, setBalanceByPhone, (const std::string& phone, model::Money balance), (override));
 };
 
 class UserServiceTest : public ::testing::Test {
@@ -44,8 +45,8 @@ protected:
         user. username = username;
         user. password = "password123";
         user.role = role;
-        user.balance = balance;
-        user.created_at = std::chrono::system_clock::now();
+        user.balance = model::Money::FromDouble(balance);
+        user.created_at = model::Now();
         return user;
     }
 
@@ -71,7 +72,7 @@ TEST_F(UserServiceTest, GetUser_Success_ValidUserId) {
     EXPECT_EQ(result->id, 1);
     EXPECT_EQ(result->phone, "13800138000");
     EXPECT_EQ(result->username, "alice");
-    EXPECT_DOUBLE_EQ(result->balance, 100.0);
+    EXPECT_EQ(result->balance.cents, 10000);
 }
 
 TEST_F(UserServiceTest, GetUser_Failure_UserNotFound) {
@@ -325,7 +326,7 @@ TEST_F(UserServiceTest, QueryUserByPhone_Success_CompletePhoneNumber) {
 TEST_F(UserServiceTest, SetBalance_Success_UpdateBalance) {
     // Arrange
     const int user_id = 1;
-    const double new_balance = 150.75;
+    const model::Money new_balance = model::Money(15075);
     
     model::User existing_user = CreateTestUser(1, "13800138000", "alice", "user", 100.0);
     
@@ -335,13 +336,13 @@ TEST_F(UserServiceTest, SetBalance_Success_UpdateBalance) {
     model::User saved_user;
     EXPECT_CALL(*mock_repo_, save(_))
         .Times(1)
-        .WillOnce(SaveArg<0>(&saved_user));
+        .WillOnce(DoAll(SaveArg<0>(&saved_user), Return(1)));
     
     // Act
     user_service_->SetBalance(user_id, new_balance);
     
     // Assert
-    EXPECT_DOUBLE_EQ(saved_user.balance, new_balance);
+    EXPECT_EQ(saved_user.balance, new_balance);
     EXPECT_EQ(saved_user.id, user_id);
     EXPECT_EQ(saved_user.phone, "13800138000");
 }
@@ -349,7 +350,7 @@ TEST_F(UserServiceTest, SetBalance_Success_UpdateBalance) {
 TEST_F(UserServiceTest, SetBalance_Success_SetBalanceToZero) {
     // Arrange
     const int user_id = 1;
-    const double new_balance = 0.0;
+    const model::Money new_balance = model::Money(0);
     
     model::User existing_user = CreateTestUser(1, "13800138000", "alice", "user", 100.0);
     
@@ -359,19 +360,19 @@ TEST_F(UserServiceTest, SetBalance_Success_SetBalanceToZero) {
     model::User saved_user;
     EXPECT_CALL(*mock_repo_, save(_))
         .Times(1)
-        .WillOnce(SaveArg<0>(&saved_user));
+        .WillOnce(DoAll(SaveArg<0>(&saved_user), Return(1)));
     
     // Act
     user_service_->SetBalance(user_id, new_balance);
     
     // Assert
-    EXPECT_DOUBLE_EQ(saved_user.balance, 0.0);
+    EXPECT_EQ(saved_user.balance.cents, 0);
 }
 
 TEST_F(UserServiceTest, SetBalance_Success_IncreaseLargeAmount) {
     // Arrange
     const int user_id = 1;
-    const double new_balance = 9999999.99;
+    const model::Money new_balance = model::Money(999999999);
     
     model::User existing_user = CreateTestUser(1, "13800138000", "alice", "user", 0.0);
     
@@ -381,19 +382,19 @@ TEST_F(UserServiceTest, SetBalance_Success_IncreaseLargeAmount) {
     model::User saved_user;
     EXPECT_CALL(*mock_repo_, save(_))
         .Times(1)
-        .WillOnce(SaveArg<0>(&saved_user));
+        .WillOnce(DoAll(SaveArg<0>(&saved_user), Return(1)));
     
     // Act
     user_service_->SetBalance(user_id, new_balance);
     
     // Assert
-    EXPECT_DOUBLE_EQ(saved_user.balance, 9999999.99);
+    EXPECT_EQ(saved_user.balance.cents, 999999999);
 }
 
 TEST_F(UserServiceTest, SetBalance_Failure_UserNotFound) {
     // Arrange
     const int user_id = 999;
-    const double new_balance = 100.0;
+    const model::Money new_balance = model::Money(10000);
     
     EXPECT_CALL(*mock_repo_, findById(user_id))
         .WillOnce(Return(std::nullopt));
@@ -411,7 +412,7 @@ TEST_F(UserServiceTest, SetBalance_Failure_UserNotFound) {
 TEST_F(UserServiceTest, SetBalance_Failure_InvalidUserId_Zero) {
     // Arrange
     const int invalid_user_id = 0;
-    const double new_balance = 100.0;
+    const model::Money new_balance = model::Money(10000);
     
     // repository 方法都不应该被调用
     EXPECT_CALL(*mock_repo_, findById(_))
@@ -428,7 +429,7 @@ TEST_F(UserServiceTest, SetBalance_Failure_InvalidUserId_Zero) {
 TEST_F(UserServiceTest, SetBalance_Failure_InvalidUserId_Negative) {
     // Arrange
     const int invalid_user_id = -1;
-    const double new_balance = 100.0;
+    const model::Money new_balance = model::Money(10000);
     
     // repository 方法都不应该被调用
     EXPECT_CALL(*mock_repo_, findById(_))
@@ -445,7 +446,7 @@ TEST_F(UserServiceTest, SetBalance_Failure_InvalidUserId_Negative) {
 TEST_F(UserServiceTest, SetBalance_Failure_NegativeAmount) {
     // Arrange
     const int user_id = 1;
-    const double negative_balance = -100.0;
+    const model::Money negative_balance = model::Money(-10000);
     
     // repository 方法都不应该被调用
     EXPECT_CALL(*mock_repo_, findById(_))
@@ -472,9 +473,9 @@ TEST_F(UserServiceTest, SetBalance_Success_MultipleUpdates) {
         .Times(3);
     
     // Act
-    user_service_->SetBalance(user_id, 200.0);
-    user_service_->SetBalance(user_id, 300.0);
-    user_service_->SetBalance(user_id, 400.0);
+    user_service_->SetBalance(user_id, model::Money::FromDouble(200.0));
+    user_service_->SetBalance(user_id, model::Money::FromDouble(300.0));
+    user_service_->SetBalance(user_id, model::Money::FromDouble(400.0));
     
     // Assert - 验证调用次数即可
 }
@@ -482,7 +483,7 @@ TEST_F(UserServiceTest, SetBalance_Success_MultipleUpdates) {
 TEST_F(UserServiceTest, SetBalance_Success_PreserveOtherFields) {
     // Arrange
     const int user_id = 1;
-    const double new_balance = 500.0;
+    const model::Money new_balance = model::Money(50000);
     
     model::User existing_user = CreateTestUser(1, "13800138000", "alice", "admin", 100.0);
     
@@ -492,7 +493,7 @@ TEST_F(UserServiceTest, SetBalance_Success_PreserveOtherFields) {
     model::User saved_user;
     EXPECT_CALL(*mock_repo_, save(_))
         . Times(1)
-        .WillOnce(SaveArg<0>(&saved_user));
+        .WillOnce(DoAll(SaveArg<0>(&saved_user), Return(1)));
     
     // Act
     user_service_->SetBalance(user_id, new_balance);
@@ -502,13 +503,13 @@ TEST_F(UserServiceTest, SetBalance_Success_PreserveOtherFields) {
     EXPECT_EQ(saved_user.phone, "13800138000");
     EXPECT_EQ(saved_user.username, "alice");
     EXPECT_EQ(saved_user.role, "admin");
-    EXPECT_DOUBLE_EQ(saved_user.balance, new_balance);
+    EXPECT_EQ(saved_user.balance, new_balance);
 }
 
 TEST_F(UserServiceTest, SetBalance_EdgeCase_VerySmallAmount) {
     // Arrange
     const int user_id = 1;
-    const double small_balance = 0.01;
+    const model::Money small_balance = model::Money(1);
     
     model::User existing_user = CreateTestUser(1, "13800138000", "alice");
     
@@ -518,13 +519,13 @@ TEST_F(UserServiceTest, SetBalance_EdgeCase_VerySmallAmount) {
     model::User saved_user;
     EXPECT_CALL(*mock_repo_, save(_))
         . Times(1)
-        .WillOnce(SaveArg<0>(&saved_user));
+        .WillOnce(DoAll(SaveArg<0>(&saved_user), Return(1)));
     
     // Act
     user_service_->SetBalance(user_id, small_balance);
     
     // Assert
-    EXPECT_DOUBLE_EQ(saved_user.balance, 0.01);
+    EXPECT_EQ(saved_user.balance.cents, 1);
 }
 
 // ==================== Integration Tests ====================
@@ -545,9 +546,9 @@ TEST_F(UserServiceTest, Integration_GetUserAndSetBalance) {
     // Act
     auto result1 = user_service_->GetUser(user_id);
     ASSERT_TRUE(result1.has_value());
-    EXPECT_DOUBLE_EQ(result1->balance, 100.0);
+    EXPECT_EQ(result1->balance.cents, 10000);
     
-    user_service_->SetBalance(user_id, 200.0);
+    user_service_->SetBalance(user_id, model::Money::FromDouble(200.0));
     
     // Assert - 验证调用序列
 }
@@ -574,7 +575,7 @@ TEST_F(UserServiceTest, Integration_QueryAndSetBalance) {
     auto results = user_service_->QueryUserByPhone(phone_partial);
     ASSERT_EQ(results.size(), 1);
     
-    user_service_->SetBalance(results[0].id, 300.0);
+    user_service_->SetBalance(results[0].id, model::Money::FromDouble(300.0));
     
     // Assert - 验证调用序列
 }
\ No newline at end of file
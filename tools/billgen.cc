@@ -0,0 +1,461 @@
+// billgen：生成可重复的大规模测试数据库，表结构与 CreateStorage 一致。
+//
+//   billgen --users 100000 --events 40 --bills 10000000 --annotations 0.05 --seed 42 --out bills.db
+//
+// 同一组参数与种子、同一工具链与 libm 下生成相同的数据：只使用 std::mt19937_64 的原始输出，
+// 不使用实现相关的 std::*_distribution / std::shuffle。金额、Zipf 与时段分布经过
+// std::log / exp / pow / cos，其结果的末位在不同 libm 之间可能不同，跨平台不保证逐字节一致。
+//
+// 快速路径：先由 DatabaseORM 建表，再删除 bills / annotations / 汇总表上的二级索引与 bill_search，
+// 关闭日志与外键检查后用预编译语句按主键顺序插入，最后一次性重建汇总表与索引。
+#include "DatabaseORM.h"
+#include "BillSearchIndex.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <iostream>
+#include <iterator>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace {
+
+struct Options {
+    int64_t users = 10000;
+    int64_t events = 20;
+    int64_t bills = 1000000;
+    double annotation_share = 0.05;   // 带批注的账单比例
+    double owner_skew = 1.1;          // 账单所属用户的 Zipf 指数
+    double event_skew = 1.0;          // 账单事件的 Zipf 指数
+    int days = 365;                   // 账单时间跨度
+    model::Timestamp end = 1704067200; // 2024-01-01 00:00:00 UTC，不取当前时间以保证可重复
+    uint64_t seed = 42;
+    std::string out = "bills.db";
+    bool force = false;
+    bool search = true;               // 是否建立 bill_search 全文索引
+};
+
+void PrintUsage() {
+    std::cerr <<
+        "用法: billgen [选项]\n"
+        "  --users N          用户数（默认 10000）\n"
+        "  --events M         事件数（默认 20）\n"
+        "  --bills K          账单数（默认 1000000）\n"
+        "  --annotations P    带批注账单比例 0~1（默认 0.05）\n"
+        "  --owner-skew S     用户 Zipf 指数（默认 1.1）\n"
+        "  --event-skew S     事件 Zipf 指数（默认 1.0）\n"
+        "  --days D           时间跨度天数（默认 365）\n"
+        "  --end TS           时间范围终点，unix 秒（默认 1704067200）\n"
+        "  --seed X           随机种子（默认 42）\n"
+        "  --out PATH         输出文件（默认 bills.db）\n"
+        "  --force            覆盖已存在的输出文件\n"
+        "  --no-search        不建立全文索引（应用首次打开时会自动补建）\n";
+}
+
+Options ParseOptions(int argc, char* argv[]) {
+    Options o;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        auto value = [&]() -> std::string {
+            if (i + 1 >= argc) {
+                throw std::invalid_argument(arg + " 缺少参数");
+            }
+            return argv[++i];
+        };
+        if (arg == "--users") {
+            o.users = std::stoll(value());
+        } else if (arg == "--events") {
+            o.events = std::stoll(value());
+        } else if (arg == "--bills") {
+            o.bills = std::stoll(value());
+        } else if (arg == "--annotations") {
+            o.annotation_share = std::stod(value());
+        } else if (arg == "--owner-skew") {
+            o.owner_skew = std::stod(value());
+        } else if (arg == "--event-skew") {
+            o.event_skew = std::stod(value());
+        } else if (arg == "--days") {
+            o.days = std::stoi(value());
+        } else if (arg == "--end") {
+            o.end = std::stoll(value());
+        } else if (arg == "--seed") {
+            o.seed = std::stoull(value());
+        } else if (arg == "--out") {
+            o.out = value();
+        } else if (arg == "--force") {
+            o.force = true;
+        } else if (arg == "--no-search") {
+            o.search = false;
+        } else {
+            throw std::invalid_argument("未知参数 " + arg);
+        }
+    }
+    if (o.users <= 0 || o.events <= 0 || o.bills < 0 || o.days <= 0 ||
+        o.annotation_share < 0 || o.annotation_share > 1) {
+        throw std::invalid_argument("参数超出范围");
+    }
+    return o;
+}
+
+// 平台无关的随机数：mt19937_64 的输出序列由标准规定，分布自己实现
+class Random {
+public:
+    explicit Random(uint64_t seed) : engine_(seed) {}
+
+    // [0, 1)
+    double Uniform() { return static_cast<double>(engine_() >> 11) * 0x1.0p-53; }
+
+    // [0, n)
+    int64_t Below(int64_t n) { return static_cast<int64_t>(Uniform() * static_cast<double>(n)); }
+
+    // 标准正态，Box-Muller
+    double Normal() {
+        double u1 = 1.0 - Uniform();
+        double u2 = Uniform();
+        return std::sqrt(-2.0 * std::log(u1)) * std::cos(6.283185307179586 * u2);
+    }
+
+    bool Chance(double p) { return Uniform() < p; }
+
+private:
+    std::mt19937_64 engine_;
+};
+
+// 秩 r（从 1 开始）的概率正比于 1 / r^s。预先计算累积分布，按二分查找抽样；
+// 秩到 id 的映射再随机打乱，避免最活跃的总是 id 最小的那几行
+class Zipf {
+public:
+    Zipf(int64_t n, double s, Random& random) : cdf_(n), ids_(n) {
+        double total = 0;
+        for (int64_t r = 0; r < n; ++r) {
+            total += 1.0 / std::pow(static_cast<double>(r + 1), s);
+            cdf_[r] = total;
+        }
+        for (auto& c : cdf_) {
+            c /= total;
+        }
+        for (int64_t i = 0; i < n; ++i) {
+            ids_[i] = static_cast<int>(i + 1);
+        }
+        for (int64_t i = n - 1; i > 0; --i) {
+            std::swap(ids_[i], ids_[random.Below(i + 1)]);
+        }
+    }
+
+    // 返回 1..n 的 id
+    int Sample(Random& random) const {
+        auto it = std::upper_bound(cdf_.begin(), cdf_.end(), random.Uniform());
+        auto rank = std::min<size_t>(static_cast<size_t>(it - cdf_.begin()), cdf_.size() - 1);
+        return ids_[rank];
+    }
+
+private:
+    std::vector<double> cdf_;
+    std::vector<int> ids_;
+};
+
+// 一天内各小时的相对账单量：凌晨最低，午餐与晚间两个高峰
+const double kHourWeights[24] = {
+    2, 1, 1, 1, 1, 2, 4, 7, 9, 8, 7, 9,
+    12, 10, 8, 8, 9, 11, 13, 12, 10, 8, 6, 4,
+};
+
+class Diurnal {
+public:
+    Diurnal() {
+        double total = 0;
+        for (int h = 0; h < 24; ++h) {
+            total += kHourWeights[h];
+            cdf_[h] = total;
+        }
+        for (auto& c : cdf_) {
+            c /= total;
+        }
+    }
+
+    // 当天 00:00 起的秒数
+    int64_t Sample(Random& random) const {
+        int hour = static_cast<int>(std::upper_bound(cdf_, cdf_ + 24, random.Uniform()) - cdf_);
+        return std::min(hour, 23) * 3600 + random.Below(3600);
+    }
+
+private:
+    double cdf_[24];
+};
+
+// 金额（分）：对数正态主体，中位数约 35 元；另有 2% 大额账单取自 Pareto 尾部
+int64_t SampleAmount(Random& random) {
+    double cents;
+    if (random.Chance(0.02)) {
+        cents = 50000.0 / std::pow(1.0 - random.Uniform(), 1.0 / 1.5);
+    } else {
+        cents = std::exp(std::log(3500.0) + 1.1 * random.Normal());
+    }
+    return std::clamp<int64_t>(std::llround(cents), 1, 100000000);
+}
+
+const char* const kEventNames[] = {
+    "餐饮", "交通", "购物", "娱乐", "住房", "医疗", "教育", "通讯",
+    "旅行", "水电", "保险", "运动", "宠物", "礼物", "理财", "其他",
+};
+
+const char* const kMerchants[] = {
+    "coffee", "bakery", "metro", "taxi", "market", "pharmacy", "cinema", "bookstore",
+    "restaurant", "noodle", "gym", "airline", "hotel", "telecom", "florist", "petshop",
+};
+
+const char* const kItems[] = {
+    "breakfast", "lunch", "dinner", "ticket", "groceries", "refill", "subscription", "deposit",
+    "gift", "repair", "membership", "snacks", "fare", "rent", "fee", "supplies",
+};
+
+const char* const kNotes[] = {
+    "reimbursable", "split with roommate", "paid by card", "refund pending",
+    "business trip", "monthly", "duplicate charge?", "keep receipt",
+};
+
+template<size_t N>
+const char* Pick(const char* const (&words)[N], Random& random) {
+    return words[random.Below(static_cast<int64_t>(N))];
+}
+
+void Exec(sqlite3* db, const std::string& sql) {
+    char* err = nullptr;
+    if (sqlite3_exec(db, sql.c_str(), nullptr, nullptr, &err) != SQLITE_OK) {
+        std::string msg = err ? err : sqlite3_errmsg(db);
+        sqlite3_free(err);
+        throw std::runtime_error(sql + ": " + msg);
+    }
+}
+
+// 只在本工具内使用的插入语句：按位置绑定，step 后 reset
+class Insert {
+public:
+    Insert(sqlite3* db, const char* sql) : db_(db) {
+        if (sqlite3_prepare_v2(db, sql, -1, &stmt_, nullptr) != SQLITE_OK) {
+            throw std::runtime_error(std::string(sql) + ": " + sqlite3_errmsg(db));
+        }
+    }
+    ~Insert() { sqlite3_finalize(stmt_); }
+
+    Insert(const Insert&) = delete;
+    Insert& operator=(const Insert&) = delete;
+
+    Insert& Int(int index, int64_t value) {
+        sqlite3_bind_int64(stmt_, index, value);
+        return *this;
+    }
+    // value 需保持有效直到 Run 返回
+    Insert& Text(int index, const std::string& value) {
+        sqlite3_bind_text(stmt_, index, value.data(), static_cast<int>(value.size()), SQLITE_STATIC);
+        return *this;
+    }
+
+    void Run() {
+        int rc = sqlite3_step(stmt_);
+        sqlite3_reset(stmt_);
+        if (rc != SQLITE_DONE) {
+            throw std::runtime_error(sqlite3_errmsg(db_));
+        }
+    }
+
+private:
+    sqlite3* db_;
+    sqlite3_stmt* stmt_ = nullptr;
+};
+
+std::vector<std::string> QueryStrings(sqlite3* db, const std::string& sql) {
+    std::vector<std::string> values;
+    sqlite3_stmt* stmt = nullptr;
+    if (sqlite3_prepare_v2(db, sql.c_str(), -1, &stmt, nullptr) != SQLITE_OK) {
+        throw std::runtime_error(sql + ": " + sqlite3_errmsg(db));
+    }
+    while (sqlite3_step(stmt) == SQLITE_ROW) {
+        values.emplace_back(reinterpret_cast<const char*>(sqlite3_column_text(stmt, 0)));
+    }
+    sqlite3_finalize(stmt);
+    return values;
+}
+
+class Stopwatch {
+public:
+    // 打印上一阶段耗时并开始计时下一阶段
+    void Lap(const std::string& phase) {
+        auto now = std::chrono::steady_clock::now();
+        auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(now - last_).count();
+        std::cout << "  " << phase << ": " << ms << " ms" << std::endl;
+        last_ = now;
+    }
+
+    int64_t TotalMs() const {
+        return std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::steady_clock::now() - start_).count();
+    }
+
+private:
+    std::chrono::steady_clock::time_point start_ = std::chrono::steady_clock::now();
+    std::chrono::steady_clock::time_point last_ = start_;
+};
+
+void Generate(sqlite3* db, const Options& o, Stopwatch& watch) {
+    Random random(o.seed);
+    const model::Timestamp start = o.end - static_cast<model::Timestamp>(o.days) * 86400;
+
+    // 二级索引插入后统一重建，比逐行维护快得多；bill_search 删掉后回退 schema 版本，
+    // 由 DatabaseORM 重新打开时的迁移全量填充
+    auto indexes = QueryStrings(db,
+        "SELECT sql FROM sqlite_master WHERE type = 'index' AND sql IS NOT NULL "
+        "AND tbl_name IN ('bills', 'annotations', 'bill_rollup_daily')");
+    for (const auto& name : QueryStrings(db,
+             "SELECT name FROM sqlite_master WHERE type = 'index' AND sql IS NOT NULL "
+             "AND tbl_name IN ('bills', 'annotations', 'bill_rollup_daily')")) {
+        Exec(db, "DROP INDEX \"" + name + "\"");
+    }
+    Exec(db, "DROP TABLE IF EXISTS bill_search");
+    Exec(db, "PRAGMA user_version = " + std::to_string(DatabaseORM::kSearchIndexMigration - 1));
+
+    // 全新文件，中途失败直接删除重来，不需要回滚日志
+    Exec(db, "PRAGMA journal_mode = OFF");
+    Exec(db, "PRAGMA synchronous = OFF");
+    Exec(db, "PRAGMA foreign_keys = OFF");
+    Exec(db, "BEGIN");
+
+    {
+        Insert insert(db, "INSERT INTO users(id, phone, username, password, role, balance, created_at) "
+                          "VALUES (?1, ?2, ?3, ?4, ?5, ?6, ?7)");
+        std::string phone, username, password, role;
+        char buffer[16];
+        for (int64_t i = 1; i <= o.users; ++i) {
+            std::snprintf(buffer, sizeof(buffer), "13%09lld", static_cast<long long>(i));
+            phone = buffer;
+            // 1 号用户为管理员，便于直接登录界面查看全量数据
+            username = i == 1 ? "admin" : "user" + std::to_string(i);
+            password = i == 1 ? "admin" : "password";
+            role = i == 1 ? "admin" : "user";
+            insert.Int(1, i).Text(2, phone).Text(3, username).Text(4, password).Text(5, role)
+                  .Int(6, random.Below(1000000)).Int(7, start).Run();
+        }
+    }
+
+    {
+        Insert insert(db, "INSERT INTO events(id, name, status, created_at) VALUES (?1, ?2, ?3, ?4)");
+        const int64_t named = static_cast<int64_t>(std::size(kEventNames));
+        std::string name;
+        for (int64_t i = 1; i <= o.events; ++i) {
+            name = i <= named ? kEventNames[i - 1] : "event_" + std::to_string(i);
+            insert.Int(1, i).Text(2, name).Int(3, model::EventStatus::Available).Int(4, start).Run();
+        }
+    }
+    watch.Lap("users + events");
+
+    Zipf owners(o.users, o.owner_skew, random);
+    Zipf events(o.events, o.event_skew, random);
+    Diurnal diurnal;
+    {
+        Insert bill(db, "INSERT INTO bills(id, owner_id, event_id, description, amount, created_at, has_annotation) "
+                        "VALUES (?1, ?2, ?3, ?4, ?5, ?6, ?7)");
+        Insert note(db, "INSERT INTO annotations(id, bill_id, content, authorid, created_at) "
+                        "VALUES (?1, ?2, ?3, ?4, ?5)");
+        std::string description, content;
+        int64_t annotation_id = 0;
+        const int64_t progress_step = std::max<int64_t>(o.bills / 10, 1);
+        for (int64_t i = 0; i < o.bills; ++i) {
+            // 天数随 id 单调递增，与真实写入顺序一致；天内按作息分布
+            int64_t day = i * o.days / std::max<int64_t>(o.bills, 1);
+            model::Timestamp created_at = start + day * 86400 + diurnal.Sample(random);
+            int owner_id = owners.Sample(random);
+            description.assign(Pick(kMerchants, random)).append(" ").append(Pick(kItems, random));
+            bool annotated = random.Chance(o.annotation_share);
+
+            bill.Int(1, i + 1).Int(2, owner_id).Int(3, events.Sample(random)).Text(4, description)
+                .Int(5, SampleAmount(random)).Int(6, created_at).Int(7, annotated ? 1 : 0).Run();
+            if (annotated) {
+                content = Pick(kNotes, random);
+                note.Int(1, ++annotation_id).Int(2, i + 1).Text(3, content).Int(4, owner_id)
+                    .Int(5, created_at + random.Below(86400)).Run();
+            }
+            if ((i + 1) % progress_step == 0) {
+                std::cout << "  bills " << (i + 1) << " / " << o.bills << "\r" << std::flush;
+            }
+        }
+        std::cout << std::endl;
+    }
+    watch.Lap("bills + annotations");
+
+    // 与 BillRepositoryImpl::rebuildRollups 相同的结果，day 为 UTC 日起点
+    Exec(db, "INSERT INTO bill_rollup_daily(owner_id, event_id, day, count, sum) "
+             "SELECT owner_id, event_id, created_at - created_at % 86400, COUNT(*), SUM(amount) "
+             "FROM bills GROUP BY owner_id, event_id, created_at - created_at % 86400");
+    watch.Lap("rollups");
+
+    for (const auto& sql : indexes) {
+        Exec(db, sql);
+    }
+    Exec(db, "COMMIT");
+    watch.Lap("indexes");
+
+    // 不执行 ANALYZE：线上库没有 sqlite_stat1，生成库的查询计划应与之一致
+    Exec(db, "PRAGMA foreign_keys = ON");
+    Exec(db, "PRAGMA journal_mode = WAL");
+}
+
+void RemoveDatabase(const std::string& path) {
+    for (const char* suffix : {"", "-wal", "-shm", "-journal"}) {
+        std::filesystem::remove(path + suffix);
+    }
+}
+
+}
+
+int main(int argc, char* argv[]) {
+    Options options;
+    try {
+        options = ParseOptions(argc, argv);
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << std::endl;
+        PrintUsage();
+        return 2;
+    }
+
+    if (std::filesystem::exists(options.out)) {
+        if (!options.force) {
+            std::cerr << options.out << " 已存在，使用 --force 覆盖" << std::endl;
+            return 2;
+        }
+    }
+    RemoveDatabase(options.out);
+
+    std::cout << "生成 " << options.out << ": users=" << options.users << " events=" << options.events
+              << " bills=" << options.bills << " annotations=" << options.annotation_share
+              << " seed=" << options.seed << std::endl;
+
+    try {
+        Stopwatch watch;
+        {
+            // 建表与 DatabaseORM 完全一致（含 sync_schema 生成的索引）
+            DatabaseORM schema(options.out, DatabaseOptions::Ingest());
+            auto con = schema.GetStorage().get_connection();
+            watch.Lap("schema");
+            Generate(con.get(), options, watch);
+        }
+
+        if (options.search) {
+            // 重新打开时执行建立 bill_search 的迁移，从 bills / annotations 全量填充
+            DatabaseORM reopen(options.out, DatabaseOptions::Ingest());
+            watch.Lap(reopen.GetSearchIndex().Available() ? "search index" : "search index (FTS5 不可用，已跳过)");
+        }
+        std::cout << "完成，总耗时 " << watch.TotalMs() << " ms" << std::endl;
+    } catch (const std::exception& e) {
+        std::cerr << "生成失败: " << e.what() << std::endl;
+        RemoveDatabase(options.out);
+        return 1;
+    }
+    return 0;
+}